@@ -0,0 +1,141 @@
+#include "AssignmentSolver.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+AssignmentSolver::AssignmentSolver(std::vector<int> costs, int size)
+        : size(size), costs(std::move(costs)), rowPotentials(size, 0), columnPotentials(size, 0),
+          rowColumns(size, -1), columnRows(size, -1), minReducedCosts(size), previousColumns(size), isColumnUsed(size) {
+    if (size < 0 || this->costs.size() != static_cast<std::size_t>(size) * size) {
+        throw std::invalid_argument("Cost matrix is not " + std::to_string(size) + " x " + std::to_string(size));
+    }
+    // Row minima - feasible duals to start from
+    for (int row = 0; row != size; ++row) {
+        const auto rowBegin = this->costs.begin() + row * size;
+        const int rowMinimum = *std::min_element(rowBegin, rowBegin + size);
+        rowPotentials[row] = rowMinimum != NO_EDGE ? rowMinimum : 0;
+    }
+}
+
+long long AssignmentSolver::solve() {
+    for (int row = 0; row != size; ++row) {
+        if (rowColumns[row] == -1 && !assignRow(row)) {
+            return -1;
+        }
+    }
+    long long assignmentCost = 0;
+    for (int row = 0; row != size; ++row) {
+        assignmentCost += costs[row * size + rowColumns[row]];
+    }
+    return assignmentCost;
+}
+
+void AssignmentSolver::setCost(int row, int column, int cost) {
+    if (row < 0 || row >= size || column < 0 || column >= size) {
+        throw std::out_of_range("Edge (" + std::to_string(row) + ", " + std::to_string(column) + ") out of range");
+    }
+    int &oldCost = costs[row * size + column];
+    if (oldCost == cost) {
+        return;
+    }
+    oldCost = cost;
+    if (rowColumns[row] == column) {
+        unassignRow(row);
+    }
+    if (cost != NO_EDGE && cost - rowPotentials[row] - columnPotentials[column] < 0) {
+        // Lowering u[row] keeps other constraints of the row, but its assigned edge is no longer tight
+        rowPotentials[row] = cost - columnPotentials[column];
+        unassignRow(row);
+    }
+}
+
+int AssignmentSolver::getCost(int row, int column) const {
+    return costs[row * size + column];
+}
+
+int AssignmentSolver::getSize() const {
+    return size;
+}
+
+const std::vector<int> &AssignmentSolver::getAssignment() const {
+    return rowColumns;
+}
+
+const std::vector<long long> &AssignmentSolver::getRowPotentials() const {
+    return rowPotentials;
+}
+
+const std::vector<long long> &AssignmentSolver::getColumnPotentials() const {
+    return columnPotentials;
+}
+
+bool AssignmentSolver::assignRow(int row) {
+    const long long infinity = std::numeric_limits<long long>::max();
+    std::fill(minReducedCosts.begin(), minReducedCosts.end(), infinity);
+    std::fill(isColumnUsed.begin(), isColumnUsed.end(), false);
+
+    // Dijkstra over reduced costs from row; -1 - the row itself, before any column
+    int currentRow = row, currentColumn = -1;
+    while (true) {
+        if (currentColumn != -1) {
+            isColumnUsed[currentColumn] = true;
+        }
+        long long delta = infinity;
+        int nextColumn = -1;
+        const int *rowCosts = costs.data() + currentRow * size;
+        for (int column = 0; column != size; ++column) {
+            if (isColumnUsed[column]) {
+                continue;
+            }
+            if (rowCosts[column] != NO_EDGE) {
+                const long long reducedCost = rowCosts[column] - rowPotentials[currentRow] - columnPotentials[column];
+                if (reducedCost < minReducedCosts[column]) {
+                    minReducedCosts[column] = reducedCost;
+                    previousColumns[column] = currentColumn;
+                }
+            }
+            if (minReducedCosts[column] < delta) {
+                delta = minReducedCosts[column];
+                nextColumn = column;
+            }
+        }
+        if (nextColumn == -1) {
+            return false;
+        }
+        rowPotentials[row] += delta;
+        for (int column = 0; column != size; ++column) {
+            if (isColumnUsed[column]) {
+                rowPotentials[columnRows[column]] += delta;
+                columnPotentials[column] -= delta;
+            } else if (minReducedCosts[column] != infinity) {
+                minReducedCosts[column] -= delta;
+            }
+        }
+        currentColumn = nextColumn;
+        if (columnRows[currentColumn] == -1) {
+            break;
+        }
+        currentRow = columnRows[currentColumn];
+    }
+
+    // Flip the augmenting path
+    while (true) {
+        const int previousColumn = previousColumns[currentColumn];
+        const int pathRow = previousColumn == -1 ? row : columnRows[previousColumn];
+        columnRows[currentColumn] = pathRow;
+        rowColumns[pathRow] = currentColumn;
+        if (previousColumn == -1) {
+            return true;
+        }
+        currentColumn = previousColumn;
+    }
+}
+
+void AssignmentSolver::unassignRow(int row) {
+    if (rowColumns[row] != -1) {
+        columnRows[rowColumns[row]] = -1;
+        rowColumns[row] = -1;
+    }
+}
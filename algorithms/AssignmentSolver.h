@@ -0,0 +1,56 @@
+#ifndef PEA_P1_ASSIGNMENTSOLVER_H
+#define PEA_P1_ASSIGNMENTSOLVER_H
+
+#include <limits>
+#include <vector>
+
+// Assignment problem (cheapest permutation of columns for rows) solved by the Hungarian method with shortest
+// augmenting paths - O(n^3). Dual values and the assignment are kept between calls: after setCost only the rows it
+// unassigned are augmented again by solve (O(n^2) each).
+class AssignmentSolver {
+
+public:
+    static const int NO_EDGE = std::numeric_limits<int>::max();
+
+    // costs - flat row-major size x size matrix, NO_EDGE - pair that can't be assigned
+    AssignmentSolver(std::vector<int> costs, int size);
+
+    // Assigns all unassigned rows; returns the assignment cost, -1 if there is no complete assignment
+    long long solve();
+
+    // Row is unassigned if its assigned edge changes or the new cost breaks its dual constraint
+    void setCost(int row, int column, int cost);
+
+    [[nodiscard]] int getCost(int row, int column) const;
+
+    [[nodiscard]] int getSize() const;
+
+    // [row] - assigned column, -1 if unassigned
+    [[nodiscard]] const std::vector<int> &getAssignment() const;
+
+    // Reduced costs c(i, j) - u[i] - v[j] are non-negative, zero on the assignment
+    [[nodiscard]] const std::vector<long long> &getRowPotentials() const;
+
+    [[nodiscard]] const std::vector<long long> &getColumnPotentials() const;
+
+private:
+    int size;
+    std::vector<int> costs;
+    std::vector<long long> rowPotentials;
+    std::vector<long long> columnPotentials;
+    std::vector<int> rowColumns;
+    std::vector<int> columnRows;
+
+    // Scratch of assignRow
+    std::vector<long long> minReducedCosts;
+    std::vector<int> previousColumns;
+    std::vector<bool> isColumnUsed;
+
+    // Shortest augmenting path from the unassigned row; false if no free column can be reached
+    bool assignRow(int row);
+
+    void unassignRow(int row);
+};
+
+
+#endif //PEA_P1_ASSIGNMENTSOLVER_H
@@ -0,0 +1,358 @@
+#include "DistributedBranchAndBound.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <list>
+#include <memory>
+#include <stdexcept>
+
+#include <poll.h>
+
+#include "TSPExactAlgorithms.h"
+#include "../utilities/BinaryStream.h"
+#include "../utilities/TSPUtils.h"
+
+int DistributedBranchAndBound::runCoordinator(const IGraph *tspInstance, ServerSocket &serverSocket, int nWorkers,
+                                              std::vector<int> &outSolution) {
+    TRACE_SCOPE("distributedBranchAndBound");
+    if (nWorkers <= 0) {
+        throw std::invalid_argument("At least one worker is needed");
+    }
+    const int instanceSize = tspInstance->getVertexCount();
+    const std::vector<int> costs = TSPExactAlgorithms::dpCopyCosts(tspInstance);
+    std::list<int> tspSolution;
+    int upperBound = TSPExactAlgorithms::bbDesignateHeuristicSolution(tspInstance, tspSolution);
+    const BBNodeData rootNode = TSPExactAlgorithms::bbCreateRootNode(tspInstance);
+    BucketQueue<BBNodeData> pool(std::min(calculateMinLowerBound(costs, instanceSize), upperBound), upperBound,
+                                 instanceSize + 1);
+    if (rootNode.lowerBound < upperBound) {
+        pool.push(BBNodeData(rootNode), rootNode.lowerBound, rootNode.edgesOnPath);
+    }
+
+    std::vector<WorkerConnection> workers;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WORKER_CONNECT_TIMEOUT_MS);
+    while (static_cast<int>(workers.size()) < nWorkers) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("Only " + std::to_string(workers.size()) + " of " + std::to_string(nWorkers)
+                                     + " workers connected");
+        }
+        Socket socket = serverSocket.accept(ACCEPT_POLL_MS);
+        if (socket.isOpen()) {
+            workers.push_back({std::move(socket), false, false, 0, 0});
+        }
+    }
+    BinaryWriter writer;
+    writer.writeUInt8(static_cast<std::uint8_t>(MessageType::Instance));
+    writer.writeInt32(instanceSize);
+    writer.writeInt32Vector(costs);
+    writer.writeInt32(upperBound);
+    for (auto &worker : workers) {
+        worker.socket.sendFrame(writer.getBuffer());
+    }
+
+    std::vector<BBNodeData> nodes;
+    std::vector<pollfd> pollFds(workers.size());
+    std::string payload;
+    while (true) {
+        // Pool split evenly between idle workers
+        int nIdleWorkers = static_cast<int>(std::count_if(workers.begin(), workers.end(),
+                                                          [](const WorkerConnection &worker) {
+                                                              return !worker.isBusy;
+                                                          }));
+        for (auto &worker : workers) {
+            if (worker.isBusy || pool.isEmpty()) {
+                continue;
+            }
+            const int batchSize = (pool.getSize() + nIdleWorkers - 1) / nIdleWorkers;
+            --nIdleWorkers;
+            nodes.clear();
+            while (static_cast<int>(nodes.size()) < batchSize && !pool.isEmpty()) {
+                nodes.emplace_back(pool.pop());
+                // Nodes above the upper bound remain only in buckets shared with nodes below it
+                if (nodes.back().lowerBound >= upperBound) {
+                    nodes.pop_back();
+                }
+            }
+            if (!nodes.empty()) {
+                worker.socket.sendFrame(encodeNodes(upperBound, nodes, costs));
+                worker.isBusy = true;
+                ++worker.nSentBatches;
+            }
+        }
+
+        // Workers still idle get nodes taken from busy ones
+        nIdleWorkers = 0;
+        int nPendingSplits = 0;
+        for (const auto &worker : workers) {
+            nIdleWorkers += worker.isBusy ? 0 : 1;
+            nPendingSplits += worker.isSplitPending ? 1 : 0;
+        }
+        if (nIdleWorkers == static_cast<int>(workers.size()) && nPendingSplits == 0 && pool.isEmpty()) {
+            break;
+        }
+        for (auto &worker : workers) {
+            if (nPendingSplits >= nIdleWorkers) {
+                break;
+            }
+            if (worker.isBusy && !worker.isSplitPending) {
+                worker.socket.sendFrame(encodeMessage(MessageType::Split));
+                worker.isSplitPending = true;
+                ++nPendingSplits;
+            }
+        }
+
+        for (std::size_t workerIdx = 0; workerIdx < workers.size(); ++workerIdx) {
+            pollFds[workerIdx] = {workers[workerIdx].socket.getFd(), POLLIN, 0};
+        }
+        if (::poll(pollFds.data(), pollFds.size(), -1) < 0) {
+            continue;
+        }
+        for (std::size_t workerIdx = 0; workerIdx < workers.size(); ++workerIdx) {
+            if (pollFds[workerIdx].revents == 0) {
+                continue;
+            }
+            WorkerConnection &worker = workers[workerIdx];
+            if (!worker.socket.receiveFrame(payload)) {
+                throw std::runtime_error("Worker " + std::to_string(workerIdx) + " disconnected");
+            }
+            try {
+                BinaryReader reader(payload);
+                const auto messageType = static_cast<MessageType>(reader.readUInt8());
+                if (messageType == MessageType::Incumbent) {
+                    const int value = reader.readInt32();
+                    const std::vector<int> tour = reader.readInt32Vector();
+                    if (value < upperBound && TSPUtils::isSolutionValid(tspInstance, tour, value)) {
+                        upperBound = value;
+                        tspSolution.assign(tour.begin(), tour.end());
+                        pool.eraseFrom(upperBound);
+                        for (auto &otherWorker : workers) {
+                            if (&otherWorker != &worker) {
+                                otherWorker.socket.sendFrame(encodeUpperBound(upperBound));
+                            }
+                        }
+                    }
+                } else if (messageType == MessageType::Nodes) {
+                    worker.isSplitPending = false;
+                    decodeNodes(reader, costs, instanceSize, upperBound, pool);
+                } else if (messageType == MessageType::Idle) {
+                    // Nodes sent after the worker became idle are not confirmed yet
+                    if (reader.readUInt64() == worker.nSentBatches) {
+                        worker.isBusy = false;
+                    }
+                    worker.nExpandedNodes = reader.readInt64();
+                } else {
+                    throw std::out_of_range("Unexpected message type");
+                }
+            } catch (const std::out_of_range &e) {
+                throw std::runtime_error("Malformed message of worker " + std::to_string(workerIdx) + " ("
+                                         + e.what() + ")");
+            }
+        }
+    }
+
+    for (auto &worker : workers) {
+        worker.socket.sendFrame(encodeMessage(MessageType::Stop));
+    }
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+void DistributedBranchAndBound::runWorker(Socket &socket) {
+    std::string payload;
+    if (!socket.receiveFrame(payload)) {
+        return;
+    }
+    int instanceSize;
+    std::vector<int> costs;
+    int upperBound;
+    try {
+        BinaryReader reader(payload);
+        if (static_cast<MessageType>(reader.readUInt8()) != MessageType::Instance) {
+            throw std::out_of_range("Instance expected");
+        }
+        instanceSize = reader.readInt32();
+        costs = reader.readInt32Vector();
+        upperBound = reader.readInt32();
+        if (instanceSize <= 0 || costs.size() != static_cast<std::size_t>(instanceSize) * instanceSize) {
+            throw std::out_of_range("Invalid cost matrix");
+        }
+    } catch (const std::out_of_range &e) {
+        throw std::runtime_error(std::string("Malformed instance message (") + e.what() + ")");
+    }
+    std::vector<std::vector<int>> matrix(instanceSize);
+    for (int i = 0; i < instanceSize; ++i) {
+        matrix[i].assign(costs.begin() + i * instanceSize, costs.begin() + (i + 1) * instanceSize);
+    }
+    IGraph *graph = nullptr;
+    TSPUtils::createTSPInstance(&graph, matrix, TSPUtils::getTSPType(matrix));
+    const std::unique_ptr<IGraph> tspInstance(graph);
+
+    const int minLowerBound = std::min(calculateMinLowerBound(costs, instanceSize), upperBound);
+    TSPExactAlgorithms::BBSearchState state(minLowerBound, upperBound, std::list<int>(), instanceSize);
+    // Value of the last tour sent to or received from the coordinator
+    int sharedUpperBound = upperBound;
+    std::uint64_t nReceivedBatches = 0;
+    // Idle is sent once per batch of nodes (workers start idle) - after it confirms all of them the coordinator may
+    // stop any time
+    bool isIdleReported = true;
+    bool isStopped = false;
+
+    std::vector<BBNodeData> nodes;
+    auto lowerUpperBound = [&state, &sharedUpperBound](int value) {
+        if (value < state.upperBound) {
+            state.upperBound = value;
+            state.nodes.eraseFrom(value);
+        }
+        sharedUpperBound = std::min(sharedUpperBound, value);
+    };
+    auto handleMessage = [&](const std::string &message) {
+        try {
+            BinaryReader reader(message);
+            const auto messageType = static_cast<MessageType>(reader.readUInt8());
+            if (messageType == MessageType::Nodes) {
+                lowerUpperBound(decodeNodes(reader, costs, instanceSize, state.upperBound, state.nodes));
+                ++nReceivedBatches;
+                isIdleReported = false;
+            } else if (messageType == MessageType::UpperBound) {
+                lowerUpperBound(reader.readInt32());
+            } else if (messageType == MessageType::Split) {
+                // Every other node in the order of pops - both halves keep some of the most promising ones
+                nodes.clear();
+                while (!state.nodes.isEmpty()) {
+                    nodes.emplace_back(state.nodes.pop());
+                }
+                std::vector<BBNodeData> givenNodes;
+                for (std::size_t nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx) {
+                    BBNodeData &nodeData = nodes[nodeIdx];
+                    if (nodeData.lowerBound >= state.upperBound) {
+                        continue;
+                    }
+                    if (nodeIdx % 2 == 1) {
+                        givenNodes.emplace_back(std::move(nodeData));
+                    } else {
+                        const int lowerBound = nodeData.lowerBound;
+                        const int edgesOnPath = nodeData.edgesOnPath;
+                        state.nodes.push(std::move(nodeData), lowerBound, edgesOnPath);
+                    }
+                }
+                socket.sendFrame(encodeNodes(state.upperBound, givenNodes, costs));
+            } else if (messageType == MessageType::Stop) {
+                state.nodes.eraseFrom(minLowerBound);
+                isStopped = true;
+            } else {
+                throw std::out_of_range("Unexpected message type");
+            }
+        } catch (const std::out_of_range &e) {
+            throw std::runtime_error(std::string("Malformed message of the coordinator (") + e.what() + ")");
+        }
+    };
+    auto shareIncumbent = [&]() {
+        if (state.upperBound < sharedUpperBound) {
+            sharedUpperBound = state.upperBound;
+            BinaryWriter writer;
+            writer.writeUInt8(static_cast<std::uint8_t>(MessageType::Incumbent));
+            writer.writeInt32(state.upperBound);
+            writer.writeInt32Vector(std::vector<int>(state.tspSolution.begin(), state.tspSolution.end()));
+            socket.sendFrame(writer.getBuffer());
+        }
+    };
+
+    long long nIterations = 0;
+    while (!isStopped) {
+        if (state.nodes.isEmpty()) {
+            if (!isIdleReported) {
+                BinaryWriter writer;
+                writer.writeUInt8(static_cast<std::uint8_t>(MessageType::Idle));
+                writer.writeUInt64(nReceivedBatches);
+                writer.writeInt64(state.nExpandedNodes);
+                socket.sendFrame(writer.getBuffer());
+                isIdleReported = true;
+            }
+            if (!socket.receiveFrame(payload)) {
+                return;
+            }
+            handleMessage(payload);
+            continue;
+        }
+        TSPExactAlgorithms::bbRunSearch(tspInstance.get(), state, 0, [&](TSPExactAlgorithms::BBSearchState &) {
+            shareIncumbent();
+            if (++nIterations % WORKER_POLL_INTERVAL != 0) {
+                return;
+            }
+            while (!isStopped && socket.waitReadable(0)) {
+                if (!socket.receiveFrame(payload)) {
+                    // Coordinator is gone - nothing to report to
+                    state.nodes.eraseFrom(minLowerBound);
+                    isStopped = true;
+                    return;
+                }
+                handleMessage(payload);
+            }
+        });
+        shareIncumbent();
+    }
+}
+
+int DistributedBranchAndBound::calculateMinLowerBound(const std::vector<int> &costs, int instanceSize) {
+    long long minLowerBound = 0;
+    for (int i = 0; i < instanceSize; ++i) {
+        int rowMinimum = std::numeric_limits<int>::max();
+        for (int j = 0; j < instanceSize; ++j) {
+            if (i != j) {
+                rowMinimum = std::min(rowMinimum, costs[i * instanceSize + j]);
+            }
+        }
+        if (rowMinimum != std::numeric_limits<int>::max()) {
+            minLowerBound += rowMinimum;
+        }
+    }
+    return static_cast<int>(std::max<long long>(std::min<long long>(minLowerBound, std::numeric_limits<int>::max()),
+                                                std::numeric_limits<int>::min()));
+}
+
+std::string DistributedBranchAndBound::encodeNodes(int upperBound, const std::vector<BBNodeData> &nodes,
+                                                   const std::vector<int> &costs) {
+    BinaryWriter writer;
+    writer.writeUInt8(static_cast<std::uint8_t>(MessageType::Nodes));
+    writer.writeInt32(upperBound);
+    writer.writeUInt32(static_cast<std::uint32_t>(nodes.size()));
+    for (const auto &nodeData : nodes) {
+        TSPExactAlgorithms::bbWriteNodeConstraints(writer, nodeData, costs);
+    }
+    return writer.getBuffer();
+}
+
+std::string DistributedBranchAndBound::encodeMessage(MessageType messageType) {
+    BinaryWriter writer;
+    writer.writeUInt8(static_cast<std::uint8_t>(messageType));
+    return writer.getBuffer();
+}
+
+std::string DistributedBranchAndBound::encodeUpperBound(int upperBound) {
+    BinaryWriter writer;
+    writer.writeUInt8(static_cast<std::uint8_t>(MessageType::UpperBound));
+    writer.writeInt32(upperBound);
+    return writer.getBuffer();
+}
+
+int DistributedBranchAndBound::decodeNodes(BinaryReader &reader, const std::vector<int> &costs, int instanceSize,
+                                           int upperBound, BucketQueue<BBNodeData> &queue) {
+    const int senderUpperBound = reader.readInt32();
+    upperBound = std::min(upperBound, senderUpperBound);
+    const std::uint32_t nNodes = reader.readUInt32();
+    for (std::uint32_t nodeIdx = 0; nodeIdx < nNodes; ++nodeIdx) {
+        BBNodeData nodeData = TSPExactAlgorithms::bbReadNodeConstraints(reader, costs, instanceSize);
+        if (nodeData.lowerBound < upperBound) {
+            const int lowerBound = nodeData.lowerBound;
+            const int edgesOnPath = nodeData.edgesOnPath;
+            queue.push(std::move(nodeData), lowerBound, edgesOnPath);
+        }
+    }
+    if (!reader.isAtEnd()) {
+        throw std::out_of_range("Data after the last node");
+    }
+    return senderUpperBound;
+}
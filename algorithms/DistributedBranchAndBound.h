@@ -0,0 +1,76 @@
+#ifndef PEA_P1_DISTRIBUTEDBRANCHANDBOUND_H
+#define PEA_P1_DISTRIBUTEDBRANCHANDBOUND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../structures/BucketQueue.h"
+#include "../structures/graphs/IGraph.h"
+#include "../utilities/Socket.h"
+#include "helper_structures/TSPHelperStructures.h"
+
+class BinaryReader;
+
+// Best-first branch and bound (TSPExactAlgorithms::bbSearch) run by worker processes connected to a coordinator with
+// Socket (Unix or TCP). The coordinator sends the instance, hands out nodes from its pool and passes the value of
+// every improved tour to all workers. A worker left without nodes reports idle; the coordinator then asks busy workers
+// to give back half of their nodes. Nodes are sent as constraints (TSPExactAlgorithms::bbWriteNodeConstraints).
+//
+// Messages, one per frame (BinaryWriter, the first byte - MessageType):
+//   coordinator -> worker: Instance (i32 n, n * n i32 costs, i32 upper bound), Nodes, UpperBound (i32), Split, Stop
+//   worker -> coordinator: Nodes (answer to Split, may be empty), Incumbent (i32 value, i32 vector tour),
+//                          Idle (u64 received Nodes messages, i64 expanded nodes)
+//   Nodes: i32 upper bound of the sender, u32 count, count * node
+class DistributedBranchAndBound {
+public:
+    // Waits for nWorkers connections on serverSocket, solves tspInstance with them and stops them. Throws
+    // std::runtime_error if the workers don't connect within WORKER_CONNECT_TIMEOUT_MS or one of them disconnects
+    // (its nodes are lost).
+    static int runCoordinator(const IGraph *tspInstance, ServerSocket &serverSocket, int nWorkers,
+                              std::vector<int> &outSolution);
+
+    // Serves the coordinator on socket until it sends Stop or disconnects. Throws std::runtime_error on malformed
+    // messages.
+    static void runWorker(Socket &socket);
+
+    static constexpr int WORKER_CONNECT_TIMEOUT_MS = 60000;
+
+    // Expanded nodes between two checks of a worker for messages
+    static constexpr int WORKER_POLL_INTERVAL = 64;
+
+private:
+    enum class MessageType : std::uint8_t {
+        Instance = 0, Nodes = 1, UpperBound = 2, Split = 3, Stop = 4, Incumbent = 5, Idle = 6
+    };
+
+    struct WorkerConnection {
+        Socket socket;
+        // Has nodes or Nodes messages not confirmed by Idle
+        bool isBusy;
+        bool isSplitPending;
+        std::uint64_t nSentBatches;
+        long long nExpandedNodes;
+    };
+
+    static constexpr int ACCEPT_POLL_MS = 200;
+
+    // No node of the instance has a lower bound below the sum of row minima - the first key of node queues
+    static int calculateMinLowerBound(const std::vector<int> &costs, int instanceSize);
+
+    static std::string encodeNodes(int upperBound, const std::vector<BBNodeData> &nodes,
+                                   const std::vector<int> &costs);
+
+    // Messages without data: Split and Stop
+    static std::string encodeMessage(MessageType messageType);
+
+    static std::string encodeUpperBound(int upperBound);
+
+    // Reads a Nodes message after its type into queue (nodes bounded by upperBound are dropped); returns the upper
+    // bound of the sender
+    static int decodeNodes(BinaryReader &reader, const std::vector<int> &costs, int instanceSize, int upperBound,
+                           BucketQueue<BBNodeData> &queue);
+};
+
+
+#endif //PEA_P1_DISTRIBUTEDBRANCHANDBOUND_H
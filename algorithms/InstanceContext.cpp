@@ -0,0 +1,325 @@
+#include "InstanceContext.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "TSPExactAlgorithms.h"
+#include "../utilities/BinaryStream.h"
+#include "../utilities/Trace.h"
+
+InstanceContext::InstanceContext(const IGraph *tspInstance) {
+    TRACE_SCOPE("InstanceContext");
+    instanceSize = tspInstance->getVertexCount();
+    fingerprint = calculateFingerprint(tspInstance);
+
+    sortedEdges.reserve(static_cast<std::size_t>(instanceSize) * (instanceSize > 0 ? instanceSize - 1 : 0));
+    rowMinima.assign(instanceSize, std::numeric_limits<int>::max());
+    columnMinima.assign(instanceSize, std::numeric_limits<int>::max());
+    int edgeCost;
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = 0; j < instanceSize; ++j) {
+            if (i == j) {
+                continue;
+            }
+            edgeCost = tspInstance->getEdgeParameter(i, j);
+            sortedEdges.emplace_back(i, j, edgeCost);
+            rowMinima[i] = std::min(rowMinima[i], edgeCost);
+            columnMinima[j] = std::min(columnMinima[j], edgeCost);
+        }
+    }
+    // Stable - the same order as in TSPGreedyAlgorithms::greedy, so the cached greedy tour is identical
+    std::stable_sort(sortedEdges.begin(), sortedEdges.end(), [](const TSPEdge &lhs, const TSPEdge &rhs) -> bool {
+        return lhs.cost < rhs.cost;
+    });
+
+    const int nCandidates = std::min(CANDIDATES_NUMBER, std::max(instanceSize - 1, 0));
+    candidateLists.resize(instanceSize);
+    std::vector<int> successors;
+    for (int i = 0; i < instanceSize; ++i) {
+        successors.clear();
+        for (int j = 0; j < instanceSize; ++j) {
+            if (i != j) {
+                successors.emplace_back(j);
+            }
+        }
+        std::partial_sort(successors.begin(), successors.begin() + nCandidates, successors.end(),
+                          [tspInstance, i](int lhs, int rhs) -> bool {
+                              return tspInstance->getEdgeParameter(i, lhs) < tspInstance->getEdgeParameter(i, rhs);
+                          });
+        candidateLists[i].assign(successors.begin(), successors.begin() + nCandidates);
+    }
+
+    std::vector<int> naturalTour;
+    naturalTourValue = TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, naturalTour);
+    nearestNeighbourTourValue = TSPGreedyAlgorithms::nearestNeighbour(tspInstance, nearestNeighbourTour);
+    if (instanceSize >= 2) {
+        greedyTourValue = TSPGreedyAlgorithms::greedyOnSortedEdges(tspInstance, sortedEdges, greedyTour);
+    } else {
+        greedyTour = naturalTour;
+        greedyTourValue = naturalTourValue;
+    }
+    karpPatchingTourValue = TSPGreedyAlgorithms::karpPatching(tspInstance, karpPatchingTour);
+
+    rootNode = TSPExactAlgorithms::bbCreateRootNode(tspInstance);
+}
+
+void InstanceContext::saveToFile(const std::string &path) const {
+    BinaryWriter writer;
+    writer.writeUInt32(FILE_MAGIC);
+    writer.writeUInt16(FILE_VERSION);
+    writer.writeInt32(instanceSize);
+    writer.writeUInt64(fingerprint);
+
+    for (const TSPEdge &edge : sortedEdges) {
+        writer.writeInt32(edge.i);
+        writer.writeInt32(edge.j);
+        writer.writeInt32(edge.cost);
+    }
+    for (const auto &candidateList : candidateLists) {
+        writer.writeInt32Vector(candidateList);
+    }
+    writer.writeInt32Vector(rowMinima);
+    writer.writeInt32Vector(columnMinima);
+    writer.writeInt32(naturalTourValue);
+    writer.writeInt32Vector(nearestNeighbourTour);
+    writer.writeInt32(nearestNeighbourTourValue);
+    writer.writeInt32Vector(greedyTour);
+    writer.writeInt32(greedyTourValue);
+    writer.writeInt32Vector(karpPatchingTour);
+    writer.writeInt32(karpPatchingTourValue);
+
+    for (const auto &row : rootNode.distances) {
+        writer.writeInt32Vector(row);
+    }
+    for (const auto &pathVertex : rootNode.pathVertices) {
+        writer.writeInt32(pathVertex.successor);
+        writer.writeInt32(pathVertex.pathHead);
+        writer.writeInt32(pathVertex.pathTail);
+    }
+    writer.writeInt32(rootNode.edgesOnPath);
+    writer.writeUInt8(rootNode.isFinal ? 1 : 0);
+    writer.writeInt32(rootNode.highestZeroPenaltiesIndexes.i);
+    writer.writeInt32(rootNode.highestZeroPenaltiesIndexes.j);
+    writer.writeInt32(rootNode.highestZeroPenalty);
+    writer.writeInt32(rootNode.lowerBound);
+
+    // Written aside and renamed - readers never see a partial file
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("File " + temporaryPath + " cannot be opened");
+        }
+        file.write(writer.getBuffer().data(), static_cast<std::streamsize>(writer.getBuffer().size()));
+        if (!file) {
+            throw std::runtime_error("File " + temporaryPath + " cannot be written");
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        throw std::runtime_error("File " + temporaryPath + " cannot be renamed to " + path);
+    }
+}
+
+std::shared_ptr<const InstanceContext>
+InstanceContext::loadFromFile(const std::string &path, const IGraph *tspInstance) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("File " + path + " cannot be opened");
+    }
+    const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::shared_ptr<InstanceContext> context(new InstanceContext());
+    try {
+        BinaryReader reader(buffer);
+        if (reader.readUInt32() != FILE_MAGIC || reader.readUInt16() != FILE_VERSION) {
+            throw std::invalid_argument("File " + path + " is not an instance context of supported version");
+        }
+        context->instanceSize = reader.readInt32();
+        context->fingerprint = reader.readUInt64();
+        if (context->instanceSize != tspInstance->getVertexCount()
+            || context->fingerprint != calculateFingerprint(tspInstance)) {
+            throw std::invalid_argument("File " + path + " is a context of other instance");
+        }
+        const int n = context->instanceSize;
+
+        const std::size_t nEdges = static_cast<std::size_t>(n) * (n > 0 ? n - 1 : 0);
+        if (nEdges > reader.getRemainingSize() / 12) {
+            throw std::out_of_range("Truncated edge list");
+        }
+        context->sortedEdges.reserve(nEdges);
+        int i, j;
+        for (std::size_t edgeIdx = 0; edgeIdx < nEdges; ++edgeIdx) {
+            i = reader.readInt32();
+            j = reader.readInt32();
+            context->sortedEdges.emplace_back(i, j, reader.readInt32());
+        }
+        for (int vertex = 0; vertex < n; ++vertex) {
+            context->candidateLists.emplace_back(reader.readInt32Vector());
+        }
+        context->rowMinima = reader.readInt32Vector();
+        context->columnMinima = reader.readInt32Vector();
+        context->naturalTourValue = reader.readInt32();
+        context->nearestNeighbourTour = reader.readInt32Vector();
+        context->nearestNeighbourTourValue = reader.readInt32();
+        context->greedyTour = reader.readInt32Vector();
+        context->greedyTourValue = reader.readInt32();
+        context->karpPatchingTour = reader.readInt32Vector();
+        context->karpPatchingTourValue = reader.readInt32();
+
+        for (int row = 0; row < n; ++row) {
+            context->rootNode.distances.emplace_back(reader.readInt32Vector());
+            if (context->rootNode.distances.back().size() != n) {
+                throw std::out_of_range("Invalid root matrix row");
+            }
+        }
+        context->rootNode.pathVertices.resize(n);
+        for (auto &pathVertex : context->rootNode.pathVertices) {
+            pathVertex.successor = reader.readInt32();
+            pathVertex.pathHead = reader.readInt32();
+            pathVertex.pathTail = reader.readInt32();
+            if (pathVertex.successor < -1 || pathVertex.successor >= n || pathVertex.pathHead < 0
+                || pathVertex.pathHead >= n || pathVertex.pathTail < 0 || pathVertex.pathTail >= n) {
+                throw std::out_of_range("Invalid root path vertex");
+            }
+        }
+        context->rootNode.edgesOnPath = reader.readInt32();
+        context->rootNode.isFinal = reader.readUInt8() != 0;
+        context->rootNode.highestZeroPenaltiesIndexes.i = reader.readInt32();
+        context->rootNode.highestZeroPenaltiesIndexes.j = reader.readInt32();
+        context->rootNode.highestZeroPenalty = reader.readInt32();
+        context->rootNode.lowerBound = reader.readInt32();
+
+        if (!reader.isAtEnd() || context->rowMinima.size() != n || context->columnMinima.size() != n
+            || context->nearestNeighbourTour.size() != n || context->greedyTour.size() != n
+            || context->karpPatchingTour.size() != n) {
+            throw std::out_of_range("Inconsistent sizes");
+        }
+    } catch (const std::out_of_range &e) {
+        throw std::invalid_argument("File " + path + " is not a valid instance context (" + e.what() + ")");
+    }
+    return context;
+}
+
+std::shared_ptr<const InstanceContext>
+InstanceContext::loadOrCreate(const std::string &path, const IGraph *tspInstance) {
+    try {
+        return loadFromFile(path, tspInstance);
+    } catch (const std::exception &) {
+        // Missing, stale or damaged - recomputed below
+    }
+    auto context = std::make_shared<const InstanceContext>(tspInstance);
+    try {
+        context->saveToFile(path);
+    } catch (const std::runtime_error &) {
+        // Read-only location - the context is still usable for this run
+    }
+    return context;
+}
+
+void InstanceContext::checkInstance(const IGraph *tspInstance) const {
+    if (tspInstance->getVertexCount() != instanceSize || calculateFingerprint(tspInstance) != fingerprint) {
+        throw std::invalid_argument("Instance context was created for other instance");
+    }
+}
+
+int InstanceContext::designateTour(const IGraph *tspInstance, TSPGreedyAlgorithms::fTSPAlgorithm algorithm,
+                                   std::vector<int> &outSolution) const {
+    checkInstance(tspInstance);
+    if (algorithm == TSPGreedyAlgorithms::createNaturalPermutation) {
+        outSolution.resize(instanceSize);
+        std::iota(outSolution.begin(), outSolution.end(), 0);
+        return naturalTourValue;
+    } else if (algorithm == TSPGreedyAlgorithms::nearestNeighbour) {
+        outSolution = nearestNeighbourTour;
+        return nearestNeighbourTourValue;
+    } else if (algorithm == TSPGreedyAlgorithms::greedy) {
+        outSolution = greedyTour;
+        return greedyTourValue;
+    } else if (algorithm == TSPGreedyAlgorithms::karpPatching) {
+        outSolution = karpPatchingTour;
+        return karpPatchingTourValue;
+    }
+    return algorithm(tspInstance, outSolution);
+}
+
+std::uint64_t InstanceContext::calculateFingerprint(const IGraph *tspInstance) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto addToHash = [&hash](std::uint32_t value) {
+        for (int byteIdx = 0; byteIdx < 4; ++byteIdx) {
+            hash ^= (value >> (8 * byteIdx)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    const int n = tspInstance->getVertexCount();
+    addToHash(static_cast<std::uint32_t>(n));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i != j) {
+                addToHash(static_cast<std::uint32_t>(tspInstance->getEdgeParameter(i, j)));
+            }
+        }
+    }
+    return hash;
+}
+
+int InstanceContext::getInstanceSize() const {
+    return instanceSize;
+}
+
+std::uint64_t InstanceContext::getFingerprint() const {
+    return fingerprint;
+}
+
+const std::vector<TSPEdge> &InstanceContext::getSortedEdges() const {
+    return sortedEdges;
+}
+
+const std::vector<std::vector<int>> &InstanceContext::getCandidateLists() const {
+    return candidateLists;
+}
+
+const std::vector<int> &InstanceContext::getRowMinima() const {
+    return rowMinima;
+}
+
+const std::vector<int> &InstanceContext::getColumnMinima() const {
+    return columnMinima;
+}
+
+int InstanceContext::getNaturalTourValue() const {
+    return naturalTourValue;
+}
+
+const std::vector<int> &InstanceContext::getNearestNeighbourTour() const {
+    return nearestNeighbourTour;
+}
+
+int InstanceContext::getNearestNeighbourTourValue() const {
+    return nearestNeighbourTourValue;
+}
+
+const std::vector<int> &InstanceContext::getGreedyTour() const {
+    return greedyTour;
+}
+
+int InstanceContext::getGreedyTourValue() const {
+    return greedyTourValue;
+}
+
+const std::vector<int> &InstanceContext::getKarpPatchingTour() const {
+    return karpPatchingTour;
+}
+
+int InstanceContext::getKarpPatchingTourValue() const {
+    return karpPatchingTourValue;
+}
+
+const BBNodeData &InstanceContext::getRootNode() const {
+    return rootNode;
+}
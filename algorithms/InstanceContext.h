@@ -0,0 +1,98 @@
+#ifndef PEA_P1_INSTANCECONTEXT_H
+#define PEA_P1_INSTANCECONTEXT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../structures/graphs/IGraph.h"
+#include "helper_structures/TSPHelperStructures.h"
+#include "TSPGreedyAlgorithms.h"
+
+// Structures derived from one instance - computed once, then shared read-only (std::shared_ptr<const ...>)
+// between runs and threads. Consumers check with checkInstance() that the context belongs to the instance they got.
+class InstanceContext {
+public:
+    static constexpr int CANDIDATES_NUMBER = 10;
+
+    explicit InstanceContext(const IGraph *tspInstance);
+
+    // Throws std::runtime_error if the file can't be written
+    void saveToFile(const std::string &path) const;
+
+    // Throws std::invalid_argument if the file isn't a context of tspInstance (other format version, size or edges)
+    // and std::runtime_error if it can't be opened
+    static std::shared_ptr<const InstanceContext> loadFromFile(const std::string &path, const IGraph *tspInstance);
+
+    // Reads path if it holds a context of tspInstance, otherwise computes the context and tries to save it there
+    static std::shared_ptr<const InstanceContext> loadOrCreate(const std::string &path, const IGraph *tspInstance);
+
+    // Throws std::invalid_argument if the context was created for an instance of other size or fingerprint; O(n^2)
+    void checkInstance(const IGraph *tspInstance) const;
+
+    // Copies the cached tour of createNaturalPermutation, nearestNeighbour, greedy or karpPatching to empty outSolution and returns
+    // its value; other algorithms (random permutation) are run on tspInstance
+    int designateTour(const IGraph *tspInstance, TSPGreedyAlgorithms::fTSPAlgorithm algorithm,
+                      std::vector<int> &outSolution) const;
+
+    // FNV-1a over the size and all edge parameters
+    [[nodiscard]] static std::uint64_t calculateFingerprint(const IGraph *tspInstance);
+
+    [[nodiscard]] int getInstanceSize() const;
+
+    [[nodiscard]] std::uint64_t getFingerprint() const;
+
+    // All edges (i != j) by ascending cost, ties in row-major order
+    [[nodiscard]] const std::vector<TSPEdge> &getSortedEdges() const;
+
+    // [i] - min(CANDIDATES_NUMBER, n - 1) nearest successors of i, nearest first
+    [[nodiscard]] const std::vector<std::vector<int>> &getCandidateLists() const;
+
+    // Cheapest edge leaving / entering each vertex (INT_MAX if there is none)
+    [[nodiscard]] const std::vector<int> &getRowMinima() const;
+
+    [[nodiscard]] const std::vector<int> &getColumnMinima() const;
+
+    [[nodiscard]] int getNaturalTourValue() const;
+
+    [[nodiscard]] const std::vector<int> &getNearestNeighbourTour() const;
+
+    [[nodiscard]] int getNearestNeighbourTourValue() const;
+
+    [[nodiscard]] const std::vector<int> &getGreedyTour() const;
+
+    [[nodiscard]] int getGreedyTourValue() const;
+
+    [[nodiscard]] const std::vector<int> &getKarpPatchingTour() const;
+
+    [[nodiscard]] int getKarpPatchingTourValue() const;
+
+    // Reduced instance matrix with its lower bound and designated branching zero - root of the B&B tree
+    [[nodiscard]] const BBNodeData &getRootNode() const;
+
+private:
+    static const std::uint32_t FILE_MAGIC = 0x58544350; // "PCTX"
+    static const std::uint16_t FILE_VERSION = 3;
+
+    int instanceSize;
+    std::uint64_t fingerprint;
+    std::vector<TSPEdge> sortedEdges;
+    std::vector<std::vector<int>> candidateLists;
+    std::vector<int> rowMinima;
+    std::vector<int> columnMinima;
+    int naturalTourValue;
+    std::vector<int> nearestNeighbourTour;
+    int nearestNeighbourTourValue;
+    std::vector<int> greedyTour;
+    int greedyTourValue;
+    std::vector<int> karpPatchingTour;
+    int karpPatchingTourValue;
+    BBNodeData rootNode;
+
+    // Filled by loadFromFile
+    InstanceContext() = default;
+};
+
+
+#endif //PEA_P1_INSTANCECONTEXT_H
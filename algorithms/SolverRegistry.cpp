@@ -0,0 +1,389 @@
+#include "SolverRegistry.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+const std::vector<SolverRegistry::SolverInfo> &SolverRegistry::getSolvers() {
+    static const std::vector<std::string> saParameters{"initialTemperature", "coolingSchemeParameter",
+                                                       "epochIterationsNumber", "iterationsNumber",
+                                                       "coolingScheme", "neighbourhood", "initialSolution"};
+    static const std::vector<std::string> tsParameters{"iterationsNumber", "tabuListSize", "cadenzaLengthParameter",
+                                                       "iterationsWithoutImprovementToRestart",
+                                                       "patternsNumberToCache", "neighbourhood", "initialSolution"};
+    static const std::vector<std::string> bbCheckpointParameters{"directory", "checkpointInterval"};
+    static const std::vector<std::string> gaParameters{"populationSize", "nGenerations", "crossoverProbability",
+                                                       "mutationProbability", "nElites", "tournamentSize",
+                                                       "selection", "mutation", "population"};
+    static const std::vector<SolverInfo> solvers{
+            {"bf",        "Brute force",                                     false, {}},
+            {"bf-tree",   "Brute force (DFS)",                               false, {}},
+            {"dp",        "Dynamic programming (Held-Karp)",                 false, {}},
+            {"dp-pruned", "Held-Karp pruned by a heuristic tour bound",      false, {}},
+            {"dp-elim",   "Held-Karp pruned after edge elimination",         false, {}},
+            {"dp-disk",   "Held-Karp with layers in files (n <= 32)",        false, {"directory"}},
+            {"dp-sym",    "Held-Karp joining half tours (symmetric only)",   false, {}},
+            {"dp-tiny",   "Held-Karp specialized for n <= 16",               false, {}},
+            {"exact",     "dp-tiny for n <= 16, otherwise bb",               false, {}},
+            {"bb",        "Branch and bound (best of constructive seeds)",   false, {}},
+            {"bb-compact","Branch and bound (nodes as dual potentials)",     false, {}},
+            {"bb-dfs",    "Branch and bound (depth-first, in place)",        false, {}},
+            {"bb-elim",   "Branch and bound after edge elimination",         false, {}},
+            {"bb-strong", "Branch and bound with strong branching",          false, {}},
+            {"bb-ckpt",   "Branch and bound resumable from checkpoints",     false, bbCheckpointParameters},
+            {"bb-0h",     "Branch and bound (no heuristic seed)",            false, {}},
+            {"bb-nn",     "Branch and bound (NN seed)",                      false, {}},
+            {"bb-g",      "Branch and bound (greedy seed)",                  false, {}},
+            {"bb-2h",     "Branch and bound (NN and greedy seeds)",          false, {}},
+            {"nn",        "Nearest neighbour",                               false, {}},
+            {"greedy",    "Greedy edge",                                     false, {}},
+            {"karp",      "Assignment problem with Karp patching",           false, {}},
+            {"savings",   "Clarke-Wright savings from the central hub",      false, {}},
+            {"natural",   "Natural permutation",                             false, {}},
+            {"random",    "Random permutation",                              true,  {}},
+            {"sa",        "Simulated annealing",                             true,  saParameters},
+            {"ts-list",   "Tabu search (tabu list)",                         true,  tsParameters},
+            {"ts-matrix", "Tabu search (tabu matrix)",                       true,  tsParameters},
+            {"ga",        "Genetic algorithm",                               true,  gaParameters}
+    };
+    return solvers;
+}
+
+const SolverRegistry::SolverInfo &SolverRegistry::getSolverInfo(const std::string &solverName) {
+    for (const auto &solverInfo : getSolvers()) {
+        if (solverInfo.name == solverName) {
+            return solverInfo;
+        }
+    }
+    throw std::invalid_argument("Unknown solver \"" + solverName + "\"");
+}
+
+SolverRegistry::fSolver
+SolverRegistry::createSolver(const std::string &solverName, const std::map<std::string, std::string> &parameters,
+                             std::shared_ptr<const InstanceContext> instanceContext) {
+    const SolverInfo &solverInfo = getSolverInfo(solverName);
+    for (const auto &parameter : parameters) {
+        if (std::find(solverInfo.parameterNames.begin(), solverInfo.parameterNames.end(), parameter.first)
+            == solverInfo.parameterNames.end()) {
+            throw std::invalid_argument("Solver \"" + solverName + "\" has no parameter \"" + parameter.first + "\"");
+        }
+    }
+
+    if (instanceContext != nullptr) {
+        TSPGreedyAlgorithms::fTSPAlgorithm cachedTourAlgorithm = nullptr;
+        if (solverName == "bb") {
+            return [instanceContext](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+                return TSPExactAlgorithms::branchAndBoundWithContext(tspInstance, *instanceContext, outSolution);
+            };
+        } else if (solverName == "nn") {
+            cachedTourAlgorithm = TSPGreedyAlgorithms::nearestNeighbour;
+        } else if (solverName == "greedy") {
+            cachedTourAlgorithm = TSPGreedyAlgorithms::greedy;
+        } else if (solverName == "karp") {
+            cachedTourAlgorithm = TSPGreedyAlgorithms::karpPatching;
+        } else if (solverName == "natural") {
+            cachedTourAlgorithm = TSPGreedyAlgorithms::createNaturalPermutation;
+        }
+        if (cachedTourAlgorithm != nullptr) {
+            return [instanceContext, cachedTourAlgorithm](const IGraph *tspInstance,
+                                                          std::vector<int> &outSolution) -> int {
+                return instanceContext->designateTour(tspInstance, cachedTourAlgorithm, outSolution);
+            };
+        }
+    }
+
+    if (solverName == "bf") {
+        return TSPExactAlgorithms::bruteForce;
+    } else if (solverName == "bf-tree") {
+        return TSPExactAlgorithms::bruteForceTree;
+    } else if (solverName == "dp") {
+        return TSPExactAlgorithms::dynamicProgrammingHeldKarp;
+    } else if (solverName == "dp-pruned") {
+        return TSPExactAlgorithms::dynamicProgrammingHeldKarpPruned;
+    } else if (solverName == "dp-elim") {
+        return TSPExactAlgorithms::dynamicProgrammingHeldKarpWithEdgeElimination;
+    } else if (solverName == "dp-disk") {
+        // Layer files need a local disk with room for about n * 2^(n - 1) bytes
+        const auto directoryIt = parameters.find("directory");
+        const std::string directory = directoryIt != parameters.end() ? directoryIt->second
+                                                                      : std::filesystem::temp_directory_path().string();
+        return [directory](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            return TSPExactAlgorithms::dynamicProgrammingHeldKarpOutOfCore(tspInstance, directory, outSolution);
+        };
+    } else if (solverName == "dp-sym") {
+        return TSPExactAlgorithms::dynamicProgrammingHeldKarpSymmetric;
+    } else if (solverName == "dp-tiny") {
+        return TSPTinyExactAlgorithms::heldKarp;
+    } else if (solverName == "exact") {
+        // Tiny instances are solved outright - no heuristics, no context needed
+        fSolver branchAndBound = createSolver("bb", parameters, instanceContext);
+        return [branchAndBound](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            if (TSPTinyExactAlgorithms::isSupported(tspInstance)) {
+                return TSPTinyExactAlgorithms::heldKarp(tspInstance, outSolution);
+            }
+            return branchAndBound(tspInstance, outSolution);
+        };
+    } else if (solverName == "bb") {
+        return TSPExactAlgorithms::branchAndBound;
+    } else if (solverName == "bb-compact") {
+        return TSPExactAlgorithms::branchAndBoundCompactNodes;
+    } else if (solverName == "bb-dfs") {
+        return TSPExactAlgorithms::branchAndBoundDepthFirst;
+    } else if (solverName == "bb-elim") {
+        return TSPExactAlgorithms::branchAndBoundWithEdgeElimination;
+    } else if (solverName == "bb-strong") {
+        return TSPExactAlgorithms::branchAndBoundStrongBranching;
+    } else if (solverName == "bb-ckpt") {
+        // One checkpoint per instance, named by its fingerprint - a rerun over the same files resumes each of them
+        const auto directoryIt = parameters.find("directory");
+        const std::string directory = directoryIt != parameters.end() ? directoryIt->second
+                                                                      : std::filesystem::temp_directory_path().string();
+        const auto intervalIt = parameters.find("checkpointInterval");
+        const int checkpointIntervalMs = intervalIt != parameters.end()
+                                         ? parseInt(intervalIt->first, intervalIt->second)
+                                         : TSPExactAlgorithms::BB_CHECKPOINT_INTERVAL_MS;
+        if (checkpointIntervalMs <= 0) {
+            throw std::invalid_argument("Parameter \"checkpointInterval\" must be positive, got \""
+                                        + intervalIt->second + "\"");
+        }
+        return [directory, checkpointIntervalMs](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            char fileName[32];
+            std::snprintf(fileName, sizeof(fileName), "bb_%016llx.ckpt",
+                          static_cast<unsigned long long>(InstanceContext::calculateFingerprint(tspInstance)));
+            return TSPExactAlgorithms::branchAndBoundWithCheckpoint(
+                    tspInstance, (std::filesystem::path(directory) / fileName).string(), checkpointIntervalMs,
+                    outSolution);
+        };
+    } else if (solverName == "bb-0h") {
+        return TSPExactAlgorithms::branchAndBound0Heuristics;
+    } else if (solverName == "bb-nn") {
+        return TSPExactAlgorithms::branchAndBoundNNHeuristic;
+    } else if (solverName == "bb-g") {
+        return TSPExactAlgorithms::branchAndBoundGHeuristic;
+    } else if (solverName == "bb-2h") {
+        return TSPExactAlgorithms::branchAndBound2Heuristics;
+    } else if (solverName == "nn") {
+        return TSPGreedyAlgorithms::nearestNeighbour;
+    } else if (solverName == "greedy") {
+        return TSPGreedyAlgorithms::greedy;
+    } else if (solverName == "karp") {
+        return TSPGreedyAlgorithms::karpPatching;
+    } else if (solverName == "savings") {
+        return TSPGreedyAlgorithms::savings;
+    } else if (solverName == "natural") {
+        return TSPGreedyAlgorithms::createNaturalPermutation;
+    } else if (solverName == "random") {
+        return TSPGreedyAlgorithms::createRandomPermutation;
+    } else if (solverName == "sa") {
+        LocalSearchParameters lsp = createSimulatedAnnealingParameters(parameters);
+        lsp.instanceContext = instanceContext.get();
+        // instanceContext captured to keep lsp.instanceContext alive
+        return [lsp, instanceContext](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            return TSPLocalSearchAlgorithms::simulatedAnnealing(tspInstance, lsp, outSolution);
+        };
+    } else if (solverName == "ts-list") {
+        LocalSearchParameters lsp = createTabuSearchParameters(parameters);
+        lsp.instanceContext = instanceContext.get();
+        return [lsp, instanceContext](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            return TSPLocalSearchAlgorithms::tabuSearchList(tspInstance, lsp, outSolution);
+        };
+    } else if (solverName == "ts-matrix") {
+        LocalSearchParameters lsp = createTabuSearchParameters(parameters);
+        lsp.instanceContext = instanceContext.get();
+        return [lsp, instanceContext](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            return TSPLocalSearchAlgorithms::tabuSearchMatrix(tspInstance, lsp, outSolution);
+        };
+    } else {
+        GeneticAlgorithmParameters gap = createGeneticAlgorithmParameters(parameters);
+        return [gap](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+            return TSPPopulationAlgorithms::geneticAlgorithm(tspInstance, gap, outSolution);
+        };
+    }
+}
+
+int SolverRegistry::solveWithinTimeLimit(const fSolver &solver, bool isStochastic, const IGraph *tspInstance,
+                                         int timeLimitMs, std::vector<int> &outSolution, int &outRunsNumber) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMs);
+    std::vector<int> solution;
+    int solutionValue, bestSolutionValue = -1;
+    outRunsNumber = 0;
+    do {
+        solution.clear();
+        solutionValue = solver(tspInstance, solution);
+        ++outRunsNumber;
+        if (outRunsNumber == 1 || solutionValue < bestSolutionValue) {
+            bestSolutionValue = solutionValue;
+            outSolution = solution;
+        }
+    } while (isStochastic && timeLimitMs > 0 && std::chrono::steady_clock::now() < deadline);
+    return bestSolutionValue;
+}
+
+LocalSearchParameters
+SolverRegistry::createSimulatedAnnealingParameters(const std::map<std::string, std::string> &parameters) {
+    LocalSearchParameters lsp;
+    lsp.setSimulatedAnnealingBestParameters();
+    for (const auto &parameter : parameters) {
+        const std::string &name = parameter.first;
+        const std::string &value = parameter.second;
+        if (name == "initialTemperature") {
+            lsp.initialTemperature = parseDouble(name, value);
+        } else if (name == "coolingSchemeParameter") {
+            lsp.coolingSchemeParameter = parseDouble(name, value);
+        } else if (name == "epochIterationsNumber") {
+            lsp.epochIterationsNumber = parseInt(name, value);
+        } else if (name == "iterationsNumber") {
+            lsp.iterationsNumber = parseInt(name, value);
+        } else if (name == "coolingScheme") {
+            if (value == "linear") {
+                lsp.coolingSchemeFunction = TSPLocalSearchAlgorithms::linearCoolingScheme;
+            } else if (value == "geometric") {
+                lsp.coolingSchemeFunction = TSPLocalSearchAlgorithms::geometricCoolingScheme;
+            } else if (value == "logarithmic") {
+                lsp.coolingSchemeFunction = TSPLocalSearchAlgorithms::logarithmicCoolingScheme;
+            } else {
+                throw std::invalid_argument("Unknown cooling scheme \"" + value + "\"");
+            }
+        } else if (name == "neighbourhood") {
+            lsp.nextNeighbourFunction = parseNeighbourhoodFunction(value);
+        } else if (name == "initialSolution") {
+            lsp.initialSolutionFunction = parseInitialSolutionFunction(value);
+        }
+    }
+    return lsp;
+}
+
+LocalSearchParameters
+SolverRegistry::createTabuSearchParameters(const std::map<std::string, std::string> &parameters) {
+    LocalSearchParameters lsp;
+    lsp.setTabuSearchBestParameters();
+    for (const auto &parameter : parameters) {
+        const std::string &name = parameter.first;
+        const std::string &value = parameter.second;
+        if (name == "iterationsNumber") {
+            lsp.iterationsNumber = parseInt(name, value);
+        } else if (name == "tabuListSize") {
+            lsp.tabuListSize = parseInt(name, value);
+        } else if (name == "cadenzaLengthParameter") {
+            lsp.cadenzaLengthParameter = parseDouble(name, value);
+        } else if (name == "iterationsWithoutImprovementToRestart") {
+            lsp.iterationsWithoutImprovementToRestart = parseInt(name, value);
+        } else if (name == "patternsNumberToCache") {
+            lsp.patternsNumberToCache = parseInt(name, value);
+        } else if (name == "neighbourhood") {
+            lsp.nextNeighbourFunction = parseNeighbourhoodFunction(value);
+        } else if (name == "initialSolution") {
+            lsp.initialSolutionFunction = parseInitialSolutionFunction(value);
+        }
+    }
+    return lsp;
+}
+
+GeneticAlgorithmParameters
+SolverRegistry::createGeneticAlgorithmParameters(const std::map<std::string, std::string> &parameters) {
+    GeneticAlgorithmParameters gap;
+    gap.setBestParameters();
+    for (const auto &parameter : parameters) {
+        const std::string &name = parameter.first;
+        const std::string &value = parameter.second;
+        if (name == "populationSize") {
+            gap.populationSize = parseInt(name, value);
+        } else if (name == "nGenerations") {
+            gap.nGenerations = parseInt(name, value);
+        } else if (name == "crossoverProbability") {
+            gap.crossoverProbability = parseDouble(name, value);
+        } else if (name == "mutationProbability") {
+            gap.mutationProbability = parseDouble(name, value);
+        } else if (name == "nElites") {
+            gap.nElites = parseInt(name, value);
+        } else if (name == "tournamentSize") {
+            gap.tournamentSize = parseInt(name, value);
+        } else if (name == "selection") {
+            if (value == "roulette") {
+                gap.selectionFunction = TSPPopulationAlgorithms::rouletteSelection;
+            } else if (value == "tournament") {
+                gap.selectionFunction = TSPPopulationAlgorithms::tournamentSelection;
+            } else {
+                throw std::invalid_argument("Unknown selection \"" + value + "\"");
+            }
+        } else if (name == "mutation") {
+            if (value == "inversion") {
+                gap.mutationCoreFunction = TSPPopulationAlgorithms::inversionCore;
+            } else if (value == "insertion") {
+                gap.mutationCoreFunction = TSPPopulationAlgorithms::insertionCore;
+            } else if (value == "transposition") {
+                gap.mutationCoreFunction = TSPPopulationAlgorithms::transpositionCore;
+            } else {
+                throw std::invalid_argument("Unknown mutation \"" + value + "\"");
+            }
+        } else if (name == "population") {
+            if (value == "random") {
+                gap.createPopulationFunction = TSPPopulationAlgorithms::createRandomPopulation;
+            } else if (value == "sa") {
+                gap.createPopulationFunction = TSPPopulationAlgorithms::createPopulationWithSA;
+            } else if (value == "savings") {
+                gap.createPopulationFunction = TSPPopulationAlgorithms::createPopulationWithSavings;
+            } else {
+                throw std::invalid_argument("Unknown population creation \"" + value + "\"");
+            }
+        }
+    }
+    return gap;
+}
+
+int SolverRegistry::parseInt(const std::string &parameterName, const std::string &value) {
+    std::size_t nParsed = 0;
+    int result;
+    try {
+        result = std::stoi(value, &nParsed);
+    } catch (const std::logic_error &e) {
+        nParsed = 0;
+    }
+    if (nParsed == 0 || nParsed != value.size()) {
+        throw std::invalid_argument("Parameter \"" + parameterName + "\" expects an integer, got \"" + value + "\"");
+    }
+    return result;
+}
+
+double SolverRegistry::parseDouble(const std::string &parameterName, const std::string &value) {
+    std::size_t nParsed = 0;
+    double result;
+    try {
+        result = std::stod(value, &nParsed);
+    } catch (const std::logic_error &e) {
+        nParsed = 0;
+    }
+    if (nParsed == 0 || nParsed != value.size()) {
+        throw std::invalid_argument("Parameter \"" + parameterName + "\" expects a number, got \"" + value + "\"");
+    }
+    return result;
+}
+
+TSPGreedyAlgorithms::fTSPAlgorithm SolverRegistry::parseInitialSolutionFunction(const std::string &value) {
+    if (value == "natural") {
+        return TSPGreedyAlgorithms::createNaturalPermutation;
+    } else if (value == "random") {
+        return TSPGreedyAlgorithms::createRandomPermutation;
+    } else if (value == "greedy") {
+        return TSPGreedyAlgorithms::greedy;
+    } else if (value == "nn") {
+        return TSPGreedyAlgorithms::nearestNeighbour;
+    } else if (value == "karp") {
+        return TSPGreedyAlgorithms::karpPatching;
+    } else if (value == "savings") {
+        return TSPGreedyAlgorithms::savings;
+    }
+    throw std::invalid_argument("Unknown initial solution \"" + value + "\"");
+}
+
+TSPLocalSearchAlgorithms::fNeighbourhood SolverRegistry::parseNeighbourhoodFunction(const std::string &value) {
+    if (value == "swap") {
+        return TSPLocalSearchAlgorithms::swapNeighbourhood;
+    } else if (value == "insert") {
+        return TSPLocalSearchAlgorithms::insertNeighbourhood;
+    } else if (value == "invert") {
+        return TSPLocalSearchAlgorithms::invertNeighbourhood;
+    }
+    throw std::invalid_argument("Unknown neighbourhood \"" + value + "\"");
+}
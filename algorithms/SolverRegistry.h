@@ -0,0 +1,74 @@
+#ifndef PEA_P1_SOLVERREGISTRY_H
+#define PEA_P1_SOLVERREGISTRY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../structures/graphs/IGraph.h"
+#include "InstanceContext.h"
+#include "TSPExactAlgorithms.h"
+#include "TSPGreedyAlgorithms.h"
+#include "TSPTinyExactAlgorithms.h"
+#include "TSPLocalSearchAlgorithms.h"
+#include "TSPPopulationAlgorithms.h"
+#include "helper_structures/LocalSearchParameters.h"
+#include "helper_structures/GeneticAlgorithmParameters.h"
+
+// Maps solver names (as used by the command line driver) to algorithms with bound parameters
+class SolverRegistry {
+public:
+
+    using fSolver = std::function<int(const IGraph *, std::vector<int> &)>;
+
+    struct SolverInfo {
+        std::string name;
+        std::string description;
+        // Result depends on Random - worth restarting when time is left
+        bool isStochastic;
+        // Names accepted by createSolver (empty for solvers without parameters)
+        std::vector<std::string> parameterNames;
+    };
+
+    [[nodiscard]] static const std::vector<SolverInfo> &getSolvers();
+
+    // Throws std::invalid_argument for unknown solver name
+    [[nodiscard]] static const SolverInfo &getSolverInfo(const std::string &solverName);
+
+    // Parameters not given keep the best values found in parameter analysis (set*BestParameters).
+    // Throws std::invalid_argument for unknown solver, unknown parameter or invalid value.
+    // Given instanceContext, bb, nn, greedy, natural, sa and ts-* reuse its structures - the solver may then be run
+    // only on the instance the context was created for.
+    [[nodiscard]] static fSolver
+    createSolver(const std::string &solverName, const std::map<std::string, std::string> &parameters,
+                 std::shared_ptr<const InstanceContext> instanceContext = nullptr);
+
+    // Runs the solver once; stochastic solvers are run again while timeLimitMs (<= 0 - no limit) is not used up.
+    // Returns the best value, outSolution must be empty.
+    static int solveWithinTimeLimit(const fSolver &solver, bool isStochastic, const IGraph *tspInstance,
+                                    int timeLimitMs, std::vector<int> &outSolution, int &outRunsNumber);
+
+private:
+    SolverRegistry() = default;
+
+    static LocalSearchParameters
+    createSimulatedAnnealingParameters(const std::map<std::string, std::string> &parameters);
+
+    static LocalSearchParameters createTabuSearchParameters(const std::map<std::string, std::string> &parameters);
+
+    static GeneticAlgorithmParameters
+    createGeneticAlgorithmParameters(const std::map<std::string, std::string> &parameters);
+
+    static int parseInt(const std::string &parameterName, const std::string &value);
+
+    static double parseDouble(const std::string &parameterName, const std::string &value);
+
+    static TSPGreedyAlgorithms::fTSPAlgorithm parseInitialSolutionFunction(const std::string &value);
+
+    static TSPLocalSearchAlgorithms::fNeighbourhood parseNeighbourhoodFunction(const std::string &value);
+};
+
+
+#endif //PEA_P1_SOLVERREGISTRY_H
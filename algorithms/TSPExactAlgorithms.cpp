@@ -1,4 +1,19 @@
 #include "TSPExactAlgorithms.h"
+#include "AssignmentSolver.h"
+#include "InstanceContext.h"
+#include "TSPLocalSearchAlgorithms.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <unordered_map>
+
+#include <unistd.h>
+
+#include "../utilities/BinaryStream.h"
+#include "../utilities/CheckpointWriter.h"
+#include "../utilities/MappedFile.h"
 
 int TSPExactAlgorithms::bruteForce(const IGraph *tspInstance, std::vector<int> &outSolution) {
     // Get size of the ATSP instance
@@ -10,26 +25,67 @@ int TSPExactAlgorithms::bruteForce(const IGraph *tspInstance, std::vector<int> &
         outSolution.emplace_back(tspInstance->getEdgeParameter(0, 1));
     }
 
+    // Copy of the instance - no virtual calls in the main loop
+    const int nVertex = permutationSize + 1;
+    std::vector<int> costs(nVertex * nVertex);
+    // Cheapest edge leaving each vertex - for lower bounds of the unfixed part of the tour
+    std::vector<int> rowMinima(nVertex, std::numeric_limits<int>::max());
+    for (int i = 0; i != nVertex; ++i) {
+        for (int j = 0; j != nVertex; ++j) {
+            costs[i * nVertex + j] = tspInstance->getEdgeParameter(i, j);
+            if (i != j) {
+                rowMinima[i] = std::min(rowMinima[i], costs[i * nVertex + j]);
+            }
+        }
+    }
+
     // Initialize natural permutation
     std::vector<int> permutation(permutationSize);
     for (int position = 0; position < permutationSize; ++position) {
         permutation[position] = position;
     }
 
+    // Vertex at position (-1 and permutationSize - fixed start vertex)
+    auto vertexAt = [&permutation, permutationSize](int position) -> int {
+        return position < 0 || position >= permutationSize ? permutationSize : permutation[position];
+    };
+    // Cost of the edge leaving position
+    auto edgeCost = [&costs, &vertexAt, nVertex](int position) -> int {
+        return costs[vertexAt(position) * nVertex + vertexAt(position + 1)];
+    };
+
+    // Heap's algorithm permutes positions [0, k) before position k changes. For k >= BF_MIN_PRUNING_LEVEL:
+    // suffixCosts[k] - cost of the tour from position k back to the start vertex,
+    // suffixRowMinima[k] - sum of rowMinima of vertices at positions [k, permutationSize)
+    std::vector<int> suffixCosts(permutationSize + 1, 0);
+    std::vector<int> suffixRowMinima(permutationSize + 1, 0);
+    const int rowMinimaSum = std::accumulate(rowMinima.begin(), rowMinima.end(), 0);
+    auto updateSuffixes = [&](int fromLevel) {
+        for (int level = std::min(fromLevel, permutationSize - 1); level >= BF_MIN_PRUNING_LEVEL; --level) {
+            suffixCosts[level] = edgeCost(level) + suffixCosts[level + 1];
+            suffixRowMinima[level] = rowMinima[permutation[level]] + suffixRowMinima[level + 1];
+        }
+    };
+    updateSuffixes(permutationSize - 1);
+
     // Holds currently processed (sub)permutation last element's index (size of the permutation - 1)
     int stackSlotIndex = 1;
     // Holds number of swap operation to be performed on (sub)permutations
     std::vector<int> stackCounters(permutationSize, 1);
     // Holds index of permutation's element to swap with last element in the permutation
     int swapIndex;
-    // Current permutation's target function value
+    // Current permutation's target function value - updated with edges changed by each swap
     int currentPathTargetFunctionValue;
+    // Edges (by leaving position) changed by the swap - 3 if the swapped positions are adjacent, otherwise 4
+    int changedEdges[4];
+    int nChangedEdges;
 
     // Save natural permutation as current solution (without fixed starting vertex)
     outSolution = permutation;
     // Check target function value for natural permutation and take as best for now
     int bestPathTargetFunctionValue = TSPUtils::calculateTargetFunctionValue(tspInstance, permutationSize,
                                                                              permutation);
+    currentPathTargetFunctionValue = bestPathTargetFunctionValue;
     do {
         // Test if there are still available swaps in (sub)permutation to be performed
         // (stackSlotIndex + 1) is a position (not index) of stack's slot
@@ -40,16 +96,44 @@ int TSPExactAlgorithms::bruteForce(const IGraph *tspInstance, std::vector<int> &
             } else {
                 swapIndex = stackCounters[stackSlotIndex] - 1;
             }
+
+            // Only edges around the swapped positions change (swapIndex < stackSlotIndex)
+            nChangedEdges = 0;
+            changedEdges[nChangedEdges++] = swapIndex - 1;
+            changedEdges[nChangedEdges++] = swapIndex;
+            if (stackSlotIndex - 1 != swapIndex) {
+                changedEdges[nChangedEdges++] = stackSlotIndex - 1;
+            }
+            changedEdges[nChangedEdges++] = stackSlotIndex;
+            for (int edgeIdx = 0; edgeIdx < nChangedEdges; ++edgeIdx) {
+                currentPathTargetFunctionValue -= edgeCost(changedEdges[edgeIdx]);
+            }
             // Do the swap to generate next permutation
             std::swap(permutation[stackSlotIndex], permutation[swapIndex]);
+            for (int edgeIdx = 0; edgeIdx < nChangedEdges; ++edgeIdx) {
+                currentPathTargetFunctionValue += edgeCost(changedEdges[edgeIdx]);
+            }
             // Update number of swaps of the permutation already performed
             ++stackCounters[stackSlotIndex];
+
+            // Reject all permutations of positions [0, stackSlotIndex) at once if even the cheapest edges leaving
+            // the start vertex and the unfixed vertices can't complete a tour better than the best one
+            if (stackSlotIndex >= BF_MIN_PRUNING_LEVEL) {
+                updateSuffixes(stackSlotIndex);
+                if (suffixCosts[stackSlotIndex] + rowMinimaSum - suffixRowMinima[stackSlotIndex]
+                    >= bestPathTargetFunctionValue) {
+                    // Leave the permutation as Heap's algorithm would after processing the skipped ones
+                    bfSkipHeapSubPermutations(permutation, stackSlotIndex);
+                    updateSuffixes(stackSlotIndex - 1);
+                    currentPathTargetFunctionValue = TSPUtils::calculateTargetFunctionValue(
+                            tspInstance, permutationSize, permutation);
+                    continue;
+                }
+            }
             // Generate sub-permutations
             stackSlotIndex = 1;
 
             // Compare with current best permutation and update if better solution was found
-            currentPathTargetFunctionValue = TSPUtils::calculateTargetFunctionValue(tspInstance, permutationSize,
-                                                                                    permutation);
             if (currentPathTargetFunctionValue < bestPathTargetFunctionValue) {
                 bestPathTargetFunctionValue = currentPathTargetFunctionValue;
                 outSolution = permutation;
@@ -67,6 +151,27 @@ int TSPExactAlgorithms::bruteForce(const IGraph *tspInstance, std::vector<int> &
     return bestPathTargetFunctionValue;
 }
 
+void TSPExactAlgorithms::bfSkipHeapSubPermutations(std::vector<int> &permutation, int size) {
+    // Net effect of Heap's algorithm on positions [0, size) after generating all their permutations
+    if (size % 2 == 1) {
+        std::swap(permutation[0], permutation[size - 1]);
+    } else if (size == 2) {
+        std::swap(permutation[0], permutation[1]);
+    } else {
+        // [a0 a1 .. a(size-1)] -> [a(size-3) a(size-2) a1 a2 .. a(size-4) a(size-1) a0]
+        const int first = permutation[0];
+        const int third = permutation[size - 3];
+        const int second = permutation[size - 2];
+        for (int position = size - 3; position >= 2; --position) {
+            permutation[position] = permutation[position - 1];
+        }
+        permutation[0] = third;
+        permutation[1] = second;
+        permutation[size - 2] = permutation[size - 1];
+        permutation[size - 1] = first;
+    }
+}
+
 int TSPExactAlgorithms::bruteForceTree(const IGraph *tspInstance, std::vector<int> &outSolution) {
     // Last vertex is the starting vertex
     const int permutationSize = tspInstance->getVertexCount() - 1;
@@ -185,6 +290,480 @@ int TSPExactAlgorithms::dynamicProgrammingHeldKarp(const IGraph *tspInstance, st
     return bestPathCost;
 }
 
+int TSPExactAlgorithms::dynamicProgrammingHeldKarpPruned(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("dynamicProgrammingHeldKarpPruned");
+
+    const int nVertex = tspInstance->getVertexCount();
+    if (nVertex > DP_PRUNED_MAX_INSTANCE_SIZE) {
+        throw std::invalid_argument("Instance size " + std::to_string(nVertex) + " is bigger than "
+                                    + std::to_string(DP_PRUNED_MAX_INSTANCE_SIZE));
+    }
+    if (nVertex <= 2) {
+        // The only tour
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    // Upper bound - only states that can lead to a cheaper tour are kept
+    std::vector<int> upperBoundSolution;
+    const int upperBound = designateImprovedHeuristicSolution(tspInstance, upperBoundSolution);
+    return dpSearchPruned(dpCopyCosts(tspInstance), nVertex, upperBound, upperBoundSolution, outSolution);
+}
+
+int TSPExactAlgorithms::designateImprovedHeuristicSolution(const IGraph *tspInstance,
+                                                           std::vector<int> &outSolution) {
+    // Pruning depends on the upper bound far more than on lower bounds, so the better heuristic tour is improved
+    // by a local descent
+    std::vector<int> greedySolution, patchingSolution;
+    int upperBound = TSPGreedyAlgorithms::nearestNeighbour(tspInstance, outSolution);
+    const int greedySolutionValue = TSPGreedyAlgorithms::greedy(tspInstance, greedySolution);
+    if (greedySolutionValue < upperBound) {
+        upperBound = greedySolutionValue;
+        outSolution.swap(greedySolution);
+    }
+    const int patchingSolutionValue = TSPGreedyAlgorithms::karpPatching(tspInstance, patchingSolution);
+    if (patchingSolutionValue < upperBound) {
+        upperBound = patchingSolutionValue;
+        outSolution.swap(patchingSolution);
+    }
+    return TSPLocalSearchAlgorithms::localDescent(tspInstance, outSolution, upperBound);
+}
+
+int TSPExactAlgorithms::dpSearchPruned(const std::vector<int> &costs, int nVertex, int upperBound,
+                                       const std::vector<int> &upperBoundSolution, std::vector<int> &outSolution) {
+    // (nVertex - 1) is the fixed start vertex; successors / predecessors of each vertex by ascending edge cost
+    const int startVertex = nVertex - 1;
+    std::vector<std::vector<int>> sortedSuccessors(nVertex), sortedPredecessors(nVertex);
+    for (int vertex = 0; vertex < nVertex; ++vertex) {
+        for (int neighbour = 0; neighbour < nVertex; ++neighbour) {
+            if (neighbour != vertex && costs[vertex * nVertex + neighbour] != std::numeric_limits<int>::max()) {
+                sortedSuccessors[vertex].emplace_back(neighbour);
+            }
+            if (neighbour != vertex && costs[neighbour * nVertex + vertex] != std::numeric_limits<int>::max()) {
+                sortedPredecessors[vertex].emplace_back(neighbour);
+            }
+        }
+        std::stable_sort(sortedSuccessors[vertex].begin(), sortedSuccessors[vertex].end(),
+                         [&costs, vertex, nVertex](int lhs, int rhs) -> bool {
+                             return costs[vertex * nVertex + lhs] < costs[vertex * nVertex + rhs];
+                         });
+        std::stable_sort(sortedPredecessors[vertex].begin(), sortedPredecessors[vertex].end(),
+                         [&costs, vertex, nVertex](int lhs, int rhs) -> bool {
+                             return costs[lhs * nVertex + vertex] < costs[rhs * nVertex + vertex];
+                         });
+    }
+    // Cheapest edge from vertex to / into one of vertexSet (INT_MAX if there is none)
+    auto getCheapestEdgeTo = [&](int vertex, std::uint64_t vertexSet) -> long long {
+        for (int successor : sortedSuccessors[vertex]) {
+            if (vertexSet & (1ull << successor)) {
+                return costs[vertex * nVertex + successor];
+            }
+        }
+        return std::numeric_limits<int>::max();
+    };
+    auto getCheapestEdgeFrom = [&](int vertex, std::uint64_t vertexSet) -> long long {
+        for (int predecessor : sortedPredecessors[vertex]) {
+            if (vertexSet & (1ull << predecessor)) {
+                return costs[predecessor * nVertex + vertex];
+            }
+        }
+        return std::numeric_limits<int>::max();
+    };
+
+    // layers[l] - states of paths from the start vertex through l other vertices
+    const std::uint64_t fullPathSet = (1ull << (nVertex - 1)) - 1;
+    const std::uint64_t startVertexBit = 1ull << startVertex;
+    std::vector<std::unordered_map<std::uint64_t, DPStateData>> layers(nVertex);
+    layers[0].insert({dpGetStateKey(0, startVertex), {0, -1}});
+    // [vertex] - cheapest edge into vertex from the unvisited ones
+    std::vector<long long> cheapestIncomingEdges(nVertex);
+    for (int layerIdx = 0; layerIdx < nVertex - 1; ++layerIdx) {
+        TRACE_SCOPE("dynamicProgrammingHeldKarpPruned: layer");
+        auto &nextLayer = layers[layerIdx + 1];
+        for (const auto &state : layers[layerIdx]) {
+            const std::uint64_t pathSet = state.first >> 6u;
+            const int endVertex = static_cast<int>(state.first & 63u);
+            const std::uint64_t unvisitedSet = fullPathSet & ~pathSet;
+
+            // After the path is extended by one of the unvisited vertices, the rest of the tour leaves every
+            // unvisited vertex (towards the unvisited ones or the start vertex) and enters all but the new end
+            // vertex and the start vertex (from the unvisited ones)
+            long long leavingBound = 0, enteringBound = getCheapestEdgeFrom(startVertex, unvisitedSet);
+            for (int vertex = 0; vertex < nVertex - 1; ++vertex) {
+                if (unvisitedSet & (1ull << vertex)) {
+                    leavingBound += getCheapestEdgeTo(vertex, unvisitedSet | startVertexBit);
+                    cheapestIncomingEdges[vertex] = getCheapestEdgeFrom(vertex, unvisitedSet);
+                    enteringBound += cheapestIncomingEdges[vertex];
+                }
+            }
+
+            for (int vertex = 0; vertex < nVertex - 1; ++vertex) {
+                const int edgeCost = costs[endVertex * nVertex + vertex];
+                if (!(unvisitedSet & (1ull << vertex)) || edgeCost == std::numeric_limits<int>::max()) {
+                    continue;
+                }
+                const int pathCost = state.second.pathCost + edgeCost;
+                if (pathCost + std::max(leavingBound, enteringBound - cheapestIncomingEdges[vertex]) >= upperBound) {
+                    continue;
+                }
+                auto inserted = nextLayer.insert({dpGetStateKey(pathSet | (1ull << vertex), vertex),
+                                                  {pathCost, endVertex}});
+                if (!inserted.second && pathCost < inserted.first->second.pathCost) {
+                    inserted.first->second = {pathCost, endVertex};
+                }
+            }
+        }
+    }
+
+    // Close the cheapest full path
+    int bestPathCost = upperBound;
+    int bestEndVertex = -1;
+    for (const auto &state : layers[nVertex - 1]) {
+        const int endVertex = static_cast<int>(state.first & 63u);
+        const int edgeCost = costs[endVertex * nVertex + startVertex];
+        if (edgeCost != std::numeric_limits<int>::max() && state.second.pathCost + edgeCost < bestPathCost) {
+            bestPathCost = state.second.pathCost + edgeCost;
+            bestEndVertex = endVertex;
+        }
+    }
+    if (bestEndVertex == -1) {
+        // Nothing cheaper than the heuristic tour
+        outSolution = upperBoundSolution;
+        return upperBound;
+    }
+
+    // Follow predecessors back to the start vertex
+    outSolution.assign(nVertex, startVertex);
+    std::uint64_t pathSet = fullPathSet;
+    int vertex = bestEndVertex;
+    for (int position = nVertex - 1; position >= 1; --position) {
+        outSolution[position] = vertex;
+        const int predecessor = layers[position].at(dpGetStateKey(pathSet, vertex)).predecessor;
+        pathSet &= ~(1ull << vertex);
+        vertex = predecessor;
+    }
+    return bestPathCost;
+}
+
+int TSPExactAlgorithms::dynamicProgrammingHeldKarpWithEdgeElimination(const IGraph *tspInstance,
+                                                                     std::vector<int> &outSolution) {
+    TRACE_SCOPE("dynamicProgrammingHeldKarpWithEdgeElimination");
+    const int nVertex = tspInstance->getVertexCount();
+    if (nVertex > DP_PRUNED_MAX_INSTANCE_SIZE) {
+        throw std::invalid_argument("Instance size " + std::to_string(nVertex) + " is bigger than "
+                                    + std::to_string(DP_PRUNED_MAX_INSTANCE_SIZE));
+    }
+    if (nVertex <= 2) {
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    std::vector<int> upperBoundSolution;
+    const int upperBound = designateImprovedHeuristicSolution(tspInstance, upperBoundSolution);
+    std::vector<int> costs = dpCopyCosts(tspInstance);
+    eliminateEdges(costs, nVertex, upperBound);
+    return dpSearchPruned(costs, nVertex, upperBound, upperBoundSolution, outSolution);
+}
+
+std::uint64_t TSPExactAlgorithms::dpGetStateKey(std::uint64_t pathSet, int endVertex) {
+    return (pathSet << 6u) | static_cast<std::uint64_t>(endVertex);
+}
+
+int TSPExactAlgorithms::dynamicProgrammingHeldKarpOutOfCore(const IGraph *tspInstance,
+                                                             const std::string &workingDirectory,
+                                                             std::vector<int> &outSolution) {
+    TRACE_SCOPE("dynamicProgrammingHeldKarpOutOfCore");
+
+    // (nVertex - 1) is the fixed start vertex, pathSetSize other vertices are on paths
+    const int nVertex = tspInstance->getVertexCount();
+    if (nVertex > DP_OUT_OF_CORE_MAX_INSTANCE_SIZE) {
+        throw std::invalid_argument("Instance size " + std::to_string(nVertex) + " is bigger than "
+                                    + std::to_string(DP_OUT_OF_CORE_MAX_INSTANCE_SIZE));
+    }
+    if (nVertex <= 2) {
+        // The only tour
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
+    const int startVertex = nVertex - 1;
+    const int pathSetSize = nVertex - 1;
+    const std::vector<int> costs = dpCopyCosts(tspInstance);
+    const std::vector<std::vector<std::uint64_t>> binomials = dpCreateBinomials(pathSetSize);
+
+    // Files of this run - removed however it ends
+    struct LayerFiles {
+        std::string pathPrefix;
+        std::vector<std::string> paths;
+
+        std::string getPath(int layer, const char *kind) {
+            paths.emplace_back(pathPrefix + std::to_string(layer) + kind);
+            return paths.back();
+        }
+
+        ~LayerFiles() {
+            for (const auto &path : paths) {
+                std::remove(path.c_str());
+            }
+        }
+    } layerFiles;
+    static std::atomic<unsigned int> runCounter(0);
+    layerFiles.pathPrefix = workingDirectory + "/held_karp_" + std::to_string(::getpid()) + "_"
+                            + std::to_string(runCounter.fetch_add(1)) + "_";
+
+    std::vector<MappedFile> parentLayerFiles(pathSetSize + 1);
+    std::vector<const std::uint8_t *> parentLayers(pathSetSize + 1, nullptr);
+    MappedFile previousCostLayer, costLayer;
+    std::string previousCostLayerPath;
+    for (int layer = 1; layer <= pathSetSize; ++layer) {
+        TRACE_SCOPE("dynamicProgrammingHeldKarpOutOfCore: layer");
+        const std::uint64_t nPathSets = binomials[pathSetSize][layer];
+        const std::string costLayerPath = layerFiles.getPath(layer, ".cost");
+        costLayer = MappedFile::create(costLayerPath, nPathSets * layer * sizeof(int));
+        parentLayerFiles[layer] = MappedFile::create(layerFiles.getPath(layer, ".parent"), nPathSets * layer);
+        // Both are written front to back
+        costLayer.adviseSequential();
+        parentLayerFiles[layer].adviseSequential();
+        dpComputeLayer(costs, nVertex, layer, binomials, reinterpret_cast<const int *>(previousCostLayer.getData()),
+                       reinterpret_cast<int *>(costLayer.getData()),
+                       reinterpret_cast<std::uint8_t *>(parentLayerFiles[layer].getData()));
+        parentLayers[layer] = reinterpret_cast<const std::uint8_t *>(parentLayerFiles[layer].getData());
+
+        // Costs of the layer before the previous one are not needed anymore
+        previousCostLayer = std::move(costLayer);
+        if (!previousCostLayerPath.empty()) {
+            std::remove(previousCostLayerPath.c_str());
+        }
+        previousCostLayerPath = costLayerPath;
+    }
+
+    // v∗ = min(opt(N, t) + dist(t, x) : t ∈ N) - the full set is the only record of the last layer
+    const auto *fullPathCosts = reinterpret_cast<const int *>(previousCostLayer.getData());
+    int bestPathCost = DP_NO_PATH, bestEndVertex = -1;
+    for (int vertex = 0; vertex < pathSetSize; ++vertex) {
+        const int edgeCost = costs[vertex * nVertex + startVertex];
+        if (fullPathCosts[vertex] != DP_NO_PATH && edgeCost != DP_NO_PATH
+            && fullPathCosts[vertex] + edgeCost < bestPathCost) {
+            bestPathCost = fullPathCosts[vertex] + edgeCost;
+            bestEndVertex = vertex;
+        }
+    }
+    if (bestEndVertex == -1) {
+        // No tour - the natural permutation like the other algorithms would return
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    // The path is followed from its end - it fills the tour backwards
+    const std::vector<int> path = dpFollowLayerParents((1u << pathSetSize) - 1, bestEndVertex, parentLayers,
+                                                       binomials);
+    outSolution.assign(nVertex, startVertex);
+    std::copy(path.begin(), path.end(), outSolution.rbegin());
+    return bestPathCost;
+}
+
+int TSPExactAlgorithms::dynamicProgrammingHeldKarpSymmetric(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("dynamicProgrammingHeldKarpSymmetric");
+
+    // (nVertex - 1) is the fixed start vertex, pathSetSize other vertices are on paths
+    const int nVertex = tspInstance->getVertexCount();
+    if (nVertex > DP_SYMMETRIC_MAX_INSTANCE_SIZE) {
+        throw std::invalid_argument("Instance size " + std::to_string(nVertex) + " is bigger than "
+                                    + std::to_string(DP_SYMMETRIC_MAX_INSTANCE_SIZE));
+    }
+    const std::vector<int> costs = dpCopyCosts(tspInstance);
+    for (int i = 0; i < nVertex; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (costs[i * nVertex + j] != costs[j * nVertex + i]) {
+                throw std::invalid_argument("Instance is not symmetric");
+            }
+        }
+    }
+    if (nVertex <= 3) {
+        // The only tour (up to direction)
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
+    const int startVertex = nVertex - 1;
+    const int pathSetSize = nVertex - 1;
+    const std::vector<std::vector<std::uint64_t>> binomials = dpCreateBinomials(pathSetSize);
+
+    // Every tour is start -> (path over S) -> j -> k -> (path over the rest of vertices) -> start. Read backwards,
+    // the second part is a path from the start vertex too, so paths over at most half of vertices are enough.
+    const int halfSize = (pathSetSize + 1) / 2;
+    std::vector<std::vector<int>> costLayers(halfSize + 1);
+    std::vector<std::vector<std::uint8_t>> parentLayerData(halfSize + 1);
+    std::vector<const std::uint8_t *> parentLayers(halfSize + 1, nullptr);
+    for (int layer = 1; layer <= halfSize; ++layer) {
+        TRACE_SCOPE("dynamicProgrammingHeldKarpSymmetric: layer");
+        const std::uint64_t nPathSets = binomials[pathSetSize][layer];
+        costLayers[layer].resize(nPathSets * layer);
+        parentLayerData[layer].resize(nPathSets * layer);
+        dpComputeLayer(costs, nVertex, layer, binomials, costLayers[layer - 1].data(), costLayers[layer].data(),
+                       parentLayerData[layer].data());
+        parentLayers[layer] = parentLayerData[layer].data();
+    }
+
+    // Join each path over a halfSize-vertex set with the paths over the other vertices
+    const int otherSize = pathSetSize - halfSize;
+    const std::uint32_t fullPathSet = (1u << pathSetSize) - 1;
+    std::vector<int> setVertices(halfSize), otherVertices(otherSize);
+    int bestTourCost = DP_NO_PATH, bestEndVertex = -1, bestOtherEndVertex = -1;
+    std::uint32_t bestPathSet = 0;
+    std::uint32_t pathSet = (1u << halfSize) - 1;
+    for (std::uint64_t rank = 0; rank < binomials[pathSetSize][halfSize]; ++rank) {
+        const std::uint32_t otherPathSet = fullPathSet & ~pathSet;
+        for (int vertex = 0, setIdx = 0, otherIdx = 0; vertex < pathSetSize; ++vertex) {
+            if (pathSet & (1u << vertex)) {
+                setVertices[setIdx++] = vertex;
+            } else {
+                otherVertices[otherIdx++] = vertex;
+            }
+        }
+        const int *pathCosts = costLayers[halfSize].data() + rank * halfSize;
+        const int *otherPathCosts = costLayers[otherSize].data() + dpGetPathSetRank(otherPathSet, binomials) * otherSize;
+        for (int endIdx = 0; endIdx < halfSize; ++endIdx) {
+            if (pathCosts[endIdx] == DP_NO_PATH) {
+                continue;
+            }
+            for (int otherEndIdx = 0; otherEndIdx < otherSize; ++otherEndIdx) {
+                const int edgeCost = costs[setVertices[endIdx] * nVertex + otherVertices[otherEndIdx]];
+                if (otherPathCosts[otherEndIdx] != DP_NO_PATH && edgeCost != DP_NO_PATH
+                    && pathCosts[endIdx] + edgeCost + otherPathCosts[otherEndIdx] < bestTourCost) {
+                    bestTourCost = pathCosts[endIdx] + edgeCost + otherPathCosts[otherEndIdx];
+                    bestPathSet = pathSet;
+                    bestEndVertex = setVertices[endIdx];
+                    bestOtherEndVertex = otherVertices[otherEndIdx];
+                }
+            }
+        }
+
+        // Next combination of the same size (Gosper's hack)
+        const std::uint32_t lowestBit = pathSet & -pathSet;
+        const std::uint32_t carried = pathSet + lowestBit;
+        pathSet = (((carried ^ pathSet) >> 2u) / lowestBit) | carried;
+    }
+    if (bestEndVertex == -1) {
+        // No tour - the natural permutation like the other algorithms would return
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    // First path fills positions halfSize .. 1 (followed from its end), the other one the rest - reversed
+    const std::vector<int> path = dpFollowLayerParents(bestPathSet, bestEndVertex, parentLayers, binomials);
+    const std::vector<int> otherPath = dpFollowLayerParents(fullPathSet & ~bestPathSet, bestOtherEndVertex,
+                                                            parentLayers, binomials);
+    outSolution.assign(1, startVertex);
+    outSolution.insert(outSolution.end(), path.rbegin(), path.rend());
+    outSolution.insert(outSolution.end(), otherPath.begin(), otherPath.end());
+    return bestTourCost;
+}
+
+std::vector<int> TSPExactAlgorithms::dpCopyCosts(const IGraph *tspInstance) {
+    const int nVertex = tspInstance->getVertexCount();
+    std::vector<int> costs(nVertex * nVertex);
+    for (int i = 0; i < nVertex; ++i) {
+        for (int j = 0; j < nVertex; ++j) {
+            costs[i * nVertex + j] = tspInstance->getEdgeParameter(i, j);
+        }
+    }
+    return costs;
+}
+
+std::vector<std::vector<std::uint64_t>> TSPExactAlgorithms::dpCreateBinomials(int maxSetSize) {
+    std::vector<std::vector<std::uint64_t>> binomials(maxSetSize + 1, std::vector<std::uint64_t>(maxSetSize + 2, 0));
+    for (int a = 0; a <= maxSetSize; ++a) {
+        binomials[a][0] = 1;
+        for (int b = 1; b <= a; ++b) {
+            binomials[a][b] = binomials[a - 1][b - 1] + (b < a ? binomials[a - 1][b] : 0);
+        }
+    }
+    return binomials;
+}
+
+void TSPExactAlgorithms::dpComputeLayer(const std::vector<int> &costs, int nVertex, int layer,
+                                        const std::vector<std::vector<std::uint64_t>> &binomials,
+                                        const int *previousPathCosts, int *pathCosts, std::uint8_t *parents) {
+    const int startVertex = nVertex - 1;
+    const int pathSetSize = nVertex - 1;
+    const std::uint64_t nPathSets = binomials[pathSetSize][layer];
+
+    // Set vertices, ascending, and colexicographic ranks of the set without each of them
+    std::vector<int> setVertices(layer);
+    std::vector<std::uint64_t> subsetRanks(layer);
+    // Sets of one size in colexicographic order are consecutive bit combinations
+    std::uint32_t pathSet = (1u << layer) - 1;
+    for (std::uint64_t rank = 0; rank < nPathSets; ++rank) {
+        for (int vertex = 0, setIdx = 0; setIdx < layer; ++vertex) {
+            if (pathSet & (1u << vertex)) {
+                setVertices[setIdx++] = vertex;
+            }
+        }
+        // rank(set) = sum of binomials[setVertices[t]][t + 1]; without a vertex the ones above it shift down
+        std::uint64_t lowerRank = 0;
+        for (int setIdx = 0; setIdx < layer; ++setIdx) {
+            subsetRanks[setIdx] = lowerRank;
+            lowerRank += binomials[setVertices[setIdx]][setIdx + 1];
+        }
+        std::uint64_t upperRank = 0;
+        for (int setIdx = layer - 1; setIdx >= 0; --setIdx) {
+            subsetRanks[setIdx] += upperRank;
+            upperRank += binomials[setVertices[setIdx]][setIdx];
+        }
+
+        int *recordCosts = pathCosts + rank * layer;
+        std::uint8_t *recordParents = parents + rank * layer;
+        for (int endIdx = 0; endIdx < layer; ++endIdx) {
+            const int endVertex = setVertices[endIdx];
+            if (layer == 1) {
+                // opt({q}, q) = dist(x, q)
+                recordCosts[endIdx] = costs[startVertex * nVertex + endVertex];
+                recordParents[endIdx] = static_cast<std::uint8_t>(startVertex);
+                continue;
+            }
+            // opt(S, t) = min(opt(S \ {t}, q) + dist(q, t) : q ∈ S \ {t})
+            const int *subsetCosts = previousPathCosts + subsetRanks[endIdx] * (layer - 1);
+            int bestPathCost = DP_NO_PATH, bestParent = startVertex;
+            for (int subsetIdx = 0; subsetIdx < layer - 1; ++subsetIdx) {
+                const int vertex = setVertices[subsetIdx < endIdx ? subsetIdx : subsetIdx + 1];
+                const int edgeCost = costs[vertex * nVertex + endVertex];
+                if (subsetCosts[subsetIdx] != DP_NO_PATH && edgeCost != DP_NO_PATH
+                    && subsetCosts[subsetIdx] + edgeCost < bestPathCost) {
+                    bestPathCost = subsetCosts[subsetIdx] + edgeCost;
+                    bestParent = vertex;
+                }
+            }
+            recordCosts[endIdx] = bestPathCost;
+            recordParents[endIdx] = static_cast<std::uint8_t>(bestParent);
+        }
+
+        // Next combination of the same size (Gosper's hack)
+        const std::uint32_t lowestBit = pathSet & -pathSet;
+        const std::uint32_t carried = pathSet + lowestBit;
+        pathSet = (((carried ^ pathSet) >> 2u) / lowestBit) | carried;
+    }
+}
+
+std::uint64_t TSPExactAlgorithms::dpGetPathSetRank(std::uint32_t pathSet,
+                                                   const std::vector<std::vector<std::uint64_t>> &binomials) {
+    std::uint64_t rank = 0;
+    for (int vertex = 0, setIdx = 0; pathSet >> static_cast<unsigned int>(vertex); ++vertex) {
+        if (pathSet & (1u << vertex)) {
+            rank += binomials[vertex][++setIdx];
+        }
+    }
+    return rank;
+}
+
+std::vector<int> TSPExactAlgorithms::dpFollowLayerParents(std::uint32_t pathSet, int endVertex,
+                                                          const std::vector<const std::uint8_t *> &parentLayers,
+                                                          const std::vector<std::vector<std::uint64_t>> &binomials) {
+    std::vector<int> path;
+    int vertex = endVertex;
+    for (int layer = __builtin_popcount(pathSet); layer >= 1; --layer) {
+        path.emplace_back(vertex);
+        const std::uint64_t rank = dpGetPathSetRank(pathSet, binomials);
+        // Position of vertex among vertices of the set
+        const int endIdx = __builtin_popcount(pathSet & ((1u << vertex) - 1));
+        pathSet &= ~(1u << vertex);
+        vertex = parentLayers[layer][rank * layer + endIdx];
+    }
+    return path;
+}
+
 int TSPExactAlgorithms::dpGetPartialPathCost(unsigned int partialPathSet, int endVertexIdx,
                                              std::vector<std::vector<int>> &partialPathCostTable,
                                              const IGraph *tspInstance) {
@@ -219,18 +798,239 @@ int TSPExactAlgorithms::dpGetPartialPathCost(unsigned int partialPathSet, int en
 }
 
 int TSPExactAlgorithms::branchAndBound(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBound");
+
+    std::list<int> tspSolution;
+    int upperBound = bbDesignateHeuristicSolution(tspInstance, tspSolution);
+
+    upperBound = bbSearch(tspInstance, bbCreateRootNode(tspInstance), upperBound, tspSolution);
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+int TSPExactAlgorithms::branchAndBoundStrongBranching(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBoundStrongBranching");
+
+    std::list<int> tspSolution;
+    int upperBound = bbDesignateHeuristicSolution(tspInstance, tspSolution);
+
+    upperBound = bbSearch(tspInstance, bbCreateRootNode(tspInstance), upperBound, tspSolution,
+                          BB_STRONG_BRANCHING_CANDIDATES);
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+int TSPExactAlgorithms::branchAndBoundWithCheckpoint(const IGraph *tspInstance, const std::string &checkpointPath,
+                                                     int checkpointIntervalMs, std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBoundWithCheckpoint");
+    const std::uint64_t fingerprint = InstanceContext::calculateFingerprint(tspInstance);
+    const std::vector<int> costs = dpCopyCosts(tspInstance);
+
+    std::unique_ptr<BBSearchState> state;
+    try {
+        state = bbLoadSearchState(CheckpointWriter::read(checkpointPath, BB_CHECKPOINT_KIND, fingerprint),
+                                  tspInstance, costs);
+    } catch (const std::exception &) {
+        // Missing, stale or damaged - the search starts over
+    }
+    if (state == nullptr) {
+        std::list<int> tspSolution;
+        const int upperBound = bbDesignateHeuristicSolution(tspInstance, tspSolution);
+        const BBNodeData rootNode = bbCreateRootNode(tspInstance);
+        state = std::make_unique<BBSearchState>(std::min(rootNode.lowerBound, upperBound), upperBound,
+                                                std::move(tspSolution), tspInstance->getVertexCount());
+        if (rootNode.lowerBound < upperBound) {
+            state->nodes.push(BBNodeData(rootNode), rootNode.lowerBound, rootNode.edgesOnPath);
+        }
+    }
+
+    CheckpointWriter checkpointWriter(checkpointPath, BB_CHECKPOINT_KIND, fingerprint);
+    const auto checkpointInterval = std::chrono::milliseconds(checkpointIntervalMs);
+    auto nextCheckpointTime = std::chrono::steady_clock::now() + checkpointInterval;
+    bbRunSearch(tspInstance, *state, 0, [&](BBSearchState &searchState) {
+        if (std::chrono::steady_clock::now() < nextCheckpointTime) {
+            return;
+        }
+        TRACE_SCOPE("branchAndBound: checkpoint");
+        // The previous checkpoint is usually written long ago - at most two payloads exist
+        checkpointWriter.flush();
+        checkpointWriter.submit(bbSaveSearchState(searchState, costs));
+        nextCheckpointTime = std::chrono::steady_clock::now() + checkpointInterval;
+    });
+    checkpointWriter.discard();
+    for (const auto &vertex : state->tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return state->upperBound;
+}
+
+int TSPExactAlgorithms::branchAndBoundCompactNodes(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBoundCompactNodes");
+    std::list<int> tspSolution;
+    int upperBound = bbDesignateHeuristicSolution(tspInstance, tspSolution);
+
+    const std::vector<int> costs = dpCopyCosts(tspInstance);
     const int instanceSize = tspInstance->getVertexCount();
+    // Reduced costs of the node being processed - the only matrix of the search
+    std::vector<int> reducedCosts(instanceSize * instanceSize);
 
     auto bbNodeComparator =
-            [](const BBNodeData &lhs, const BBNodeData &rhs) -> bool {
+            [](const BBCompactNodeData &lhs, const BBCompactNodeData &rhs) -> bool {
                 if (lhs.lowerBound == rhs.lowerBound) {
-                    return lhs.edgesOnPath < rhs.edgesOnPath;
+                    return lhs.forcedEdges.size() < rhs.forcedEdges.size();
                 }
                 return lhs.lowerBound > rhs.lowerBound;
             };
-    std::priority_queue<BBNodeData, std::vector<BBNodeData>, decltype(bbNodeComparator)> bbNodes(bbNodeComparator);
+    std::priority_queue<BBCompactNodeData, std::vector<BBCompactNodeData>, decltype(bbNodeComparator)>
+            bbNodes(bbNodeComparator);
+    BBCompactNodeData rootNode(instanceSize);
+    bbEvaluateCompactNode(costs, rootNode, reducedCosts);
+    bbNodes.push(rootNode);
+
+    BBCompactNodeData leftNode, rightNode;
+    int calculatedUpperBound;
+    while (!bbNodes.empty() && bbNodes.top().lowerBound < upperBound) {
+        if (!bbNodes.top().isFinal) {
+            leftNode = bbNodes.top();
+            rightNode = bbNodes.top();
+            bbNodes.pop();
+
+            leftNode.forbiddenEdges.emplace_back(leftNode.highestZeroPenaltiesIndexes);
+            bbEvaluateCompactNode(costs, leftNode, reducedCosts);
+            if (leftNode.lowerBound < upperBound) {
+                bbNodes.push(leftNode);
+            }
+
+            rightNode.forcedEdges.emplace_back(rightNode.highestZeroPenaltiesIndexes);
+            bbEvaluateCompactNode(costs, rightNode, reducedCosts);
+            if (rightNode.lowerBound < upperBound) {
+                bbNodes.push(rightNode);
+            }
+        } else {
+            // Only nodes with all but the closing edge forced are tours - others have no edges left
+            if (bbNodes.top().forcedEdges.size() == instanceSize - 1) {
+                std::list<int> tour = bbGetCompactNodePath(bbNodes.top(), instanceSize);
+                calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
+                if (calculatedUpperBound < upperBound) {
+                    upperBound = calculatedUpperBound;
+                    tspSolution = tour;
+                }
+            }
+            bbNodes.pop();
+        }
+    }
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+int TSPExactAlgorithms::branchAndBoundDepthFirst(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBoundDepthFirst");
+    std::list<int> tspSolution;
+    int upperBound = bbDesignateHeuristicSolution(tspInstance, tspSolution);
+
+    BBDepthFirstData data(tspInstance->getVertexCount());
+    data.distances = dpCopyCosts(tspInstance);
+    data.rows = bbGetRowPointers(data.distances, data.instanceSize);
+    bbDepthFirstSearch(tspInstance, data, 0, 0, upperBound, tspSolution);
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+int TSPExactAlgorithms::branchAndBoundWithEdgeElimination(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBoundWithEdgeElimination");
+    const int instanceSize = tspInstance->getVertexCount();
+    if (instanceSize <= 2) {
+        return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
+    }
 
-    // region heuristics
+    std::vector<int> heuristicSolution;
+    int upperBound = designateImprovedHeuristicSolution(tspInstance, heuristicSolution);
+    std::vector<int> costs = dpCopyCosts(tspInstance);
+    eliminateEdges(costs, instanceSize, upperBound);
+
+    BBNodeData rootNode(instanceSize);
+    for (int i = 0; i != instanceSize; ++i) {
+        std::copy(costs.begin() + i * instanceSize, costs.begin() + (i + 1) * instanceSize,
+                  rootNode.distances[i].begin());
+    }
+    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(rootNode);
+    // Tours are evaluated on the original instance - the edge closing a tour isn't checked against removed ones
+    std::list<int> tspSolution(heuristicSolution.begin(), heuristicSolution.end());
+    upperBound = bbSearch(tspInstance, rootNode, upperBound, tspSolution);
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+int TSPExactAlgorithms::eliminateEdges(std::vector<int> &costs, int nVertex, int upperBound) {
+    TRACE_SCOPE("eliminateEdges");
+    AssignmentSolver assignmentSolver(costs, nVertex);
+    const long long lowerBound = assignmentSolver.solve();
+    if (lowerBound == -1) {
+        // No tour at all
+        return 0;
+    }
+    const std::vector<long long> &rowPotentials = assignmentSolver.getRowPotentials();
+    const std::vector<long long> &columnPotentials = assignmentSolver.getColumnPotentials();
+
+    int nRemovedEdges = 0;
+    for (int i = 0; i != nVertex; ++i) {
+        for (int j = 0; j != nVertex; ++j) {
+            int &cost = costs[i * nVertex + j];
+            if (cost != std::numeric_limits<int>::max()
+                && lowerBound + cost - rowPotentials[i] - columnPotentials[j] > upperBound) {
+                cost = std::numeric_limits<int>::max();
+                ++nRemovedEdges;
+            }
+        }
+    }
+    return nRemovedEdges;
+}
+
+int TSPExactAlgorithms::branchAndBoundWithContext(const IGraph *tspInstance, const InstanceContext &instanceContext,
+                                                  std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBoundWithContext");
+    instanceContext.checkInstance(tspInstance);
+
+    // The same choice as in branchAndBound - first of natural, nearest neighbour, greedy and Karp patching with the
+    // lowest value
+    int upperBound;
+    std::list<int> tspSolution;
+    std::vector<int> heuristicSolution;
+    upperBound = instanceContext.designateTour(tspInstance, TSPGreedyAlgorithms::createNaturalPermutation,
+                                               heuristicSolution);
+    if (instanceContext.getNearestNeighbourTourValue() < upperBound) {
+        upperBound = instanceContext.getNearestNeighbourTourValue();
+        heuristicSolution = instanceContext.getNearestNeighbourTour();
+    }
+    if (instanceContext.getGreedyTourValue() < upperBound) {
+        upperBound = instanceContext.getGreedyTourValue();
+        heuristicSolution = instanceContext.getGreedyTour();
+    }
+    if (instanceContext.getKarpPatchingTourValue() < upperBound) {
+        upperBound = instanceContext.getKarpPatchingTourValue();
+        heuristicSolution = instanceContext.getKarpPatchingTour();
+    }
+    tspSolution.assign(heuristicSolution.begin(), heuristicSolution.end());
+
+    upperBound = bbSearch(tspInstance, instanceContext.getRootNode(), upperBound, tspSolution);
+    for (const auto &vertex : tspSolution) {
+        outSolution.emplace_back(vertex);
+    }
+    return upperBound;
+}
+
+int TSPExactAlgorithms::bbDesignateHeuristicSolution(const IGraph *tspInstance, std::list<int> &outSolution) {
+    TRACE_SCOPE("branchAndBound: heuristics");
     std::vector<int> heuristicSolution;
     int heuristicSolutionValue;
     std::list<std::pair<int, std::vector<int>>> heuristicsStorage;
@@ -245,153 +1045,782 @@ int TSPExactAlgorithms::branchAndBound(const IGraph *tspInstance, std::vector<in
     heuristicSolution.clear();
     heuristicSolutionValue = TSPGreedyAlgorithms::greedy(tspInstance, heuristicSolution);
     heuristicsStorage.emplace_back(heuristicSolutionValue, heuristicSolution);
-    // endregion heuristics
+
+    heuristicSolution.clear();
+    heuristicSolutionValue = TSPGreedyAlgorithms::karpPatching(tspInstance, heuristicSolution);
+    heuristicsStorage.emplace_back(heuristicSolutionValue, heuristicSolution);
 
     auto bestHeuristicSolutionIt = std::min_element(heuristicsStorage.begin(), heuristicsStorage.end(),
                                                     [](const std::pair<int, std::vector<int>> &lhs,
                                                        const std::pair<int, std::vector<int>> &rhs) -> bool {
                                                         return lhs.first < rhs.first;
                                                     });
+    outSolution.assign(bestHeuristicSolutionIt->second.begin(), bestHeuristicSolutionIt->second.end());
+    return bestHeuristicSolutionIt->first;
+}
 
-    int upperBound = bestHeuristicSolutionIt->first;
-    std::list<int> tspSolution;
-    for (const auto &vertex : bestHeuristicSolutionIt->second) {
-        tspSolution.emplace_back(vertex);
+void TSPExactAlgorithms::bbEvaluateCompactNode(const std::vector<int> &costs, BBCompactNodeData &nodeData,
+                                               std::vector<int> &reducedCosts) {
+    const int instanceSize = static_cast<int>(nodeData.rowPotentials.size());
+    const int infinity = std::numeric_limits<int>::max();
+
+    // Rows / columns of forced edges are out of the matrix
+    std::vector<int> successors(instanceSize, -1), predecessors(instanceSize, -1);
+    for (const auto &forcedEdge : nodeData.forcedEdges) {
+        successors[forcedEdge.i] = forcedEdge.j;
+        predecessors[forcedEdge.j] = forcedEdge.i;
+    }
+    for (int i = 0; i != instanceSize; ++i) {
+        for (int j = 0; j != instanceSize; ++j) {
+            const int cost = costs[i * instanceSize + j];
+            reducedCosts[i * instanceSize + j] =
+                    successors[i] != -1 || predecessors[j] != -1 || cost == infinity
+                    ? infinity : cost - nodeData.rowPotentials[i] - nodeData.columnPotentials[j];
+        }
+    }
+    for (const auto &forbiddenEdge : nodeData.forbiddenEdges) {
+        reducedCosts[forbiddenEdge.i * instanceSize + forbiddenEdge.j] = infinity;
+    }
+    // Edge from the end to the beginning of each partial path would close a subtour
+    for (int head = 0; head != instanceSize; ++head) {
+        if (predecessors[head] == -1 && successors[head] != -1) {
+            int tail = head;
+            while (successors[tail] != -1) {
+                tail = successors[tail];
+            }
+            reducedCosts[tail * instanceSize + head] = infinity;
+        }
+    }
+
+    // Row and column reductions - moved into potentials
+    const std::vector<int *> rows = bbGetRowPointers(reducedCosts, instanceSize);
+    std::vector<int> rowReductions(instanceSize), columnReductions(instanceSize);
+    const int reduction = bbReduceMatrix(rows, instanceSize - static_cast<int>(nodeData.forcedEdges.size()),
+                                         rowReductions, columnReductions);
+    if (reduction == BB_NO_EDGES) {
+        nodeData.isFinal = true;
+        return;
+    } else if (reduction == BB_NO_TOUR) {
+        nodeData.lowerBound = std::numeric_limits<int>::max();
+        return;
+    }
+    for (int idx = 0; idx != instanceSize; ++idx) {
+        nodeData.rowPotentials[idx] += rowReductions[idx];
+        nodeData.columnPotentials[idx] += columnReductions[idx];
+    }
+    nodeData.lowerBound += reduction;
+    nodeData.highestZeroPenalty = bbFindHighestZeroPenalty(rows, nodeData.highestZeroPenaltiesIndexes);
+}
+
+std::vector<int *> TSPExactAlgorithms::bbGetRowPointers(std::vector<int> &matrix, int instanceSize) {
+    std::vector<int *> rows(instanceSize);
+    for (int i = 0; i != instanceSize; ++i) {
+        rows[i] = matrix.data() + i * instanceSize;
+    }
+    return rows;
+}
+
+std::vector<int *> TSPExactAlgorithms::bbGetRowPointers(std::vector<std::vector<int>> &matrix) {
+    std::vector<int *> rows(matrix.size());
+    for (int i = 0; i != matrix.size(); ++i) {
+        rows[i] = matrix[i].data();
+    }
+    return rows;
+}
+
+int TSPExactAlgorithms::bbReduceMatrix(const std::vector<int *> &rows, int nOpenRows, std::vector<int> &rowReductions,
+                                       std::vector<int> &columnReductions) {
+    // Loops below are branchless over whole rows, so they are vectorized; unavailable entries (infinity) are
+    // masked out of subtractions
+    const int instanceSize = static_cast<int>(rows.size());
+    const int infinity = std::numeric_limits<int>::max();
+
+    int reduction = 0;
+    int nAvailableRows = 0;
+    for (int i = 0; i != instanceSize; ++i) {
+        int *const row = rows[i];
+        int rowMinimum = infinity;
+        for (int j = 0; j != instanceSize; ++j) {
+            rowMinimum = std::min(rowMinimum, row[j]);
+        }
+        if (rowMinimum == infinity) {
+            rowReductions[i] = 0;
+            continue;
+        }
+        ++nAvailableRows;
+        rowReductions[i] = rowMinimum;
+        if (rowMinimum == 0) {
+            continue;
+        }
+        for (int j = 0; j != instanceSize; ++j) {
+            row[j] -= row[j] != infinity ? rowMinimum : 0;
+        }
+        reduction += rowMinimum;
+    }
+    if (nAvailableRows == 0) {
+        return BB_NO_EDGES;
     }
 
-    BBNodeData initNode(instanceSize);
+    // Column minima accumulated row by row - no strided walks over columns
+    std::fill(columnReductions.begin(), columnReductions.end(), infinity);
+    int *const columnMinima = columnReductions.data();
     for (int i = 0; i != instanceSize; ++i) {
+        const int *const row = rows[i];
         for (int j = 0; j != instanceSize; ++j) {
-            if (i == j) {
-                initNode.distances[i][j] = std::numeric_limits<int>::max();
+            columnMinima[j] = std::min(columnMinima[j], row[j]);
+        }
+    }
+    int columnsReduction = 0;
+    int nAvailableColumns = 0;
+    for (int j = 0; j != instanceSize; ++j) {
+        nAvailableColumns += columnMinima[j] != infinity ? 1 : 0;
+        columnMinima[j] = columnMinima[j] != infinity ? columnMinima[j] : 0;
+        columnsReduction += columnMinima[j];
+    }
+    if (columnsReduction != 0) {
+        for (int i = 0; i != instanceSize; ++i) {
+            int *const row = rows[i];
+            for (int j = 0; j != instanceSize; ++j) {
+                row[j] -= row[j] != infinity ? columnMinima[j] : 0;
             }
-            initNode.distances[i][j] = tspInstance->getEdgeParameter(i, j);
         }
     }
-    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(initNode);
-    bbNodes.push(initNode);
+    if (nAvailableRows < nOpenRows || nAvailableColumns < nOpenRows) {
+        return BB_NO_TOUR;
+    }
+    return reduction + columnsReduction;
+}
 
-    BBNodeData leftNode, rightNode;
-    int calculatedUpperBound;
-    while (bbNodes.top().lowerBound < upperBound && !bbNodes.empty()) {
-        if (!bbNodes.top().isFinal) {
-            leftNode = bbNodes.top();
-            rightNode = bbNodes.top();
-            bbNodes.pop();
+int TSPExactAlgorithms::bbFindHighestZeroPenalty(const std::vector<int *> &rows, EdgeCities &outZero) {
+    std::vector<std::pair<int, EdgeCities>> zeroPenalties;
+    bbFindZeroPenalties(rows, zeroPenalties);
 
-            bbUpdateLeftNodeData(leftNode);
-            bbCalculateLowerBoundAndDesignateHighestZeroPenalties(leftNode);
-            if (leftNode.lowerBound < upperBound) {
-                bbNodes.push(leftNode);
+    int highestZeroPenalty = -1;
+    for (const auto &zeroPenalty : zeroPenalties) {
+        if (zeroPenalty.first > highestZeroPenalty) {
+            highestZeroPenalty = zeroPenalty.first;
+            outZero = zeroPenalty.second;
+        }
+    }
+    return highestZeroPenalty;
+}
+
+void TSPExactAlgorithms::bbFindZeroPenalties(const std::vector<int *> &rows,
+                                             std::vector<std::pair<int, EdgeCities>> &outZeroPenalties) {
+    const int instanceSize = static_cast<int>(rows.size());
+    const int infinity = std::numeric_limits<int>::max();
+
+    // In a reduced matrix zeroes are minima of their rows and columns, so the cheapest other entry is the second
+    // smallest one (equal to 0 if there are more zeroes)
+    std::vector<int> rowSecondMinima(instanceSize);
+    std::vector<int> columnMinima(instanceSize, infinity), columnSecondMinima(instanceSize, infinity);
+    std::vector<EdgeCities> zeroes;
+    zeroes.reserve(2 * instanceSize);
+    for (int i = 0; i != instanceSize; ++i) {
+        const int *const row = rows[i];
+        int rowMinimum = infinity, rowSecondMinimum = infinity;
+        for (int j = 0; j != instanceSize; ++j) {
+            rowSecondMinimum = std::min(rowSecondMinimum, std::max(rowMinimum, row[j]));
+            rowMinimum = std::min(rowMinimum, row[j]);
+        }
+        rowSecondMinima[i] = rowSecondMinimum;
+        for (int j = 0; j != instanceSize; ++j) {
+            columnSecondMinima[j] = std::min(columnSecondMinima[j], std::max(columnMinima[j], row[j]));
+            columnMinima[j] = std::min(columnMinima[j], row[j]);
+        }
+        if (rowMinimum == 0) {
+            for (int j = 0; j != instanceSize; ++j) {
+                if (row[j] == 0) {
+                    zeroes.emplace_back(i, j);
+                }
             }
+        }
+    }
 
-            bbUpdateRightNodeData(rightNode);
-            bbCalculateLowerBoundAndDesignateHighestZeroPenalties(rightNode);
-            if (rightNode.lowerBound < upperBound) {
-                bbNodes.push(rightNode);
+    outZeroPenalties.reserve(zeroes.size());
+    for (const auto &zero : zeroes) {
+        outZeroPenalties.emplace_back((rowSecondMinima[zero.i] != infinity ? rowSecondMinima[zero.i] : 0)
+                                      + (columnSecondMinima[zero.j] != infinity ? columnSecondMinima[zero.j] : 0),
+                                      zero);
+    }
+}
+
+int TSPExactAlgorithms::bbReduceDepthFirstNode(BBDepthFirstData &data, int nOpenRows, int &lowerBound) {
+    std::vector<int> rowReductions(data.instanceSize), columnReductions(data.instanceSize);
+    const int reduction = bbReduceMatrix(data.rows, nOpenRows, rowReductions, columnReductions);
+    // Recorded whatever the result - the matrix is reduced anyway
+    for (int idx = 0; idx != data.instanceSize; ++idx) {
+        if (rowReductions[idx] != 0) {
+            data.recordRowReduction(idx, rowReductions[idx]);
+        }
+        if (columnReductions[idx] != 0) {
+            data.recordColumnReduction(idx, columnReductions[idx]);
+        }
+    }
+    if (reduction >= 0) {
+        lowerBound += reduction;
+    }
+    return reduction;
+}
+
+void TSPExactAlgorithms::bbDepthFirstSearch(const IGraph *tspInstance, BBDepthFirstData &data, int lowerBound,
+                                            int edgesOnPath, int &upperBound, std::list<int> &tspSolution) {
+    const int instanceSize = data.instanceSize;
+    const int infinity = std::numeric_limits<int>::max();
+    const std::size_t mark = data.trail.size();
+
+    const int reduction = bbReduceDepthFirstNode(data, instanceSize - edgesOnPath, lowerBound);
+    if (reduction == BB_NO_EDGES) {
+        // Only a path over all vertices is a tour - otherwise edges ran out
+        if (edgesOnPath == instanceSize - 1) {
+            std::list<int> tour = bbGetPath(data.pathVertices);
+            const int tourValue = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
+            if (tourValue < upperBound) {
+                upperBound = tourValue;
+                tspSolution = tour;
             }
-        } else {
-            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance,
-                                                                          bbNodes.top().partialPaths.front());
-            if (calculatedUpperBound < upperBound) {
-                upperBound = calculatedUpperBound;
-                tspSolution = bbNodes.top().partialPaths.front();
+        }
+        data.undo(mark);
+        return;
+    }
+    if (reduction == BB_NO_TOUR || lowerBound >= upperBound) {
+        data.undo(mark);
+        return;
+    }
+
+    EdgeCities zero;
+    const int penalty = bbFindHighestZeroPenalty(data.rows, zero);
+    const std::size_t nodeMark = data.trail.size();
+
+    // Right subtree - zero added to the path: its row and column leave the matrix and the edge closing the merged
+    // path is forbidden
+    const int head = data.pathVertices[zero.i].pathHead;
+    const int tail = data.pathVertices[zero.j].pathTail;
+    for (int idx = 0; idx != instanceSize; ++idx) {
+        if (data.distances[zero.i * instanceSize + idx] != infinity) {
+            data.assign(data.distances[zero.i * instanceSize + idx], infinity);
+        }
+        if (data.distances[idx * instanceSize + zero.j] != infinity) {
+            data.assign(data.distances[idx * instanceSize + zero.j], infinity);
+        }
+    }
+    if (data.distances[tail * instanceSize + head] != infinity) {
+        data.assign(data.distances[tail * instanceSize + head], infinity);
+    }
+    data.assign(data.pathVertices[zero.i].successor, zero.j);
+    data.assign(data.pathVertices[head].pathTail, tail);
+    data.assign(data.pathVertices[tail].pathHead, head);
+    bbDepthFirstSearch(tspInstance, data, lowerBound, edgesOnPath + 1, upperBound, tspSolution);
+    data.undo(nodeMark);
+
+    // Left subtree - zero forbidden; its row and column will be reduced at least by the penalty
+    if (lowerBound + penalty < upperBound) {
+        data.assign(data.distances[zero.i * instanceSize + zero.j], infinity);
+        bbDepthFirstSearch(tspInstance, data, lowerBound, edgesOnPath, upperBound, tspSolution);
+    }
+    data.undo(mark);
+}
+
+std::list<int> TSPExactAlgorithms::bbGetPath(const std::vector<BBPathVertex> &pathVertices) {
+    int vertex = 0;
+    while (pathVertices[vertex].successor != -1) {
+        ++vertex;
+    }
+    std::list<int> path;
+    for (vertex = pathVertices[vertex].pathHead; vertex != -1; vertex = pathVertices[vertex].successor) {
+        path.emplace_back(vertex);
+    }
+    return path;
+}
+
+std::list<int> TSPExactAlgorithms::bbGetCompactNodePath(const BBCompactNodeData &nodeData, int instanceSize) {
+    std::vector<int> successors(instanceSize, -1);
+    std::vector<bool> hasPredecessor(instanceSize, false);
+    for (const auto &forcedEdge : nodeData.forcedEdges) {
+        successors[forcedEdge.i] = forcedEdge.j;
+        hasPredecessor[forcedEdge.j] = true;
+    }
+    std::list<int> path;
+    int vertex = static_cast<int>(std::find(hasPredecessor.begin(), hasPredecessor.end(), false)
+                                  - hasPredecessor.begin());
+    while (vertex != -1) {
+        path.emplace_back(vertex);
+        vertex = successors[vertex];
+    }
+    return path;
+}
+
+BBNodeData TSPExactAlgorithms::bbCreateRootNode(const IGraph *tspInstance) {
+    const int instanceSize = tspInstance->getVertexCount();
+
+    BBNodeData rootNode(instanceSize);
+    for (int i = 0; i != instanceSize; ++i) {
+        for (int j = 0; j != instanceSize; ++j) {
+            // getEdgeParameter returns INT_MAX for i == j
+            rootNode.distances[i][j] = tspInstance->getEdgeParameter(i, j);
+        }
+    }
+    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(rootNode);
+    return rootNode;
+}
+
+int TSPExactAlgorithms::bbCompleteAndImproveTour(const IGraph *tspInstance, const BBNodeData &nodeData,
+                                                 std::vector<int> &outSolution) {
+    TRACE_SCOPE("branchAndBound: incumbent improvement");
+    const int instanceSize = static_cast<int>(nodeData.distances.size());
+    std::vector<TSPEdge> sortedEntries;
+    for (int i = 0; i != instanceSize; ++i) {
+        for (int j = 0; j != instanceSize; ++j) {
+            if (nodeData.distances[i][j] != std::numeric_limits<int>::max()) {
+                sortedEntries.emplace_back(i, j, nodeData.distances[i][j]);
             }
-            bbNodes.pop();
         }
     }
-    for (const auto &vertex : tspSolution) {
-        outSolution.emplace_back(vertex);
+    std::stable_sort(sortedEntries.begin(), sortedEntries.end(), [](const TSPEdge &lhs, const TSPEdge &rhs) -> bool {
+        return lhs.cost < rhs.cost;
+    });
+
+    // Entries of open rows and columns join a path end to another path start, as in bbUpdateRightNodeData
+    std::vector<BBPathVertex> pathVertices = nodeData.pathVertices;
+    std::vector<bool> hasPredecessor(instanceSize, false);
+    for (const auto &pathVertex : pathVertices) {
+        if (pathVertex.successor != -1) {
+            hasPredecessor[pathVertex.successor] = true;
+        }
     }
-    return upperBound;
+    int edgesOnPath = nodeData.edgesOnPath;
+    for (const TSPEdge &entry : sortedEntries) {
+        if (edgesOnPath == instanceSize - 1) {
+            break;
+        }
+        const int head = pathVertices[entry.i].pathHead;
+        if (pathVertices[entry.i].successor != -1 || hasPredecessor[entry.j] || head == entry.j) {
+            continue;
+        }
+        const int tail = pathVertices[entry.j].pathTail;
+        pathVertices[entry.i].successor = entry.j;
+        hasPredecessor[entry.j] = true;
+        pathVertices[head].pathTail = tail;
+        pathVertices[tail].pathHead = head;
+        ++edgesOnPath;
+    }
+
+    // Paths left by forbidden entries follow each other by their starting vertices
+    for (int start = 0; start != instanceSize; ++start) {
+        if (hasPredecessor[start]) {
+            continue;
+        }
+        for (int vertex = start; vertex != -1; vertex = pathVertices[vertex].successor) {
+            outSolution.emplace_back(vertex);
+        }
+    }
+    return TSPLocalSearchAlgorithms::localDescent(tspInstance, outSolution,
+                                                  TSPUtils::calculateTargetFunctionValue(tspInstance, outSolution));
 }
 
-void TSPExactAlgorithms::bbCalculateLowerBoundAndDesignateHighestZeroPenalties(BBNodeData &nodeData) {
-    // pair: <Indexes of zero, penalty>
-    std::list<std::pair<EdgeCities, int>> matrixZeroes;
+TSPExactAlgorithms::BBSearchState::BBSearchState(int minKey, int upperBound, std::list<int> tspSolution,
+                                                 int instanceSize)
+        : nodes(minKey, upperBound, instanceSize + 1), upperBound(upperBound), tspSolution(std::move(tspSolution)),
+          nExpandedNodes(0), improvementInterval(BB_IMPROVEMENT_INTERVAL), nextImprovementNode(0) {}
 
-    int rowMinimum;
-    bool edgesAreAvailable = false;
-    for (int i = 0; i != nodeData.distances.size(); ++i) {
-        rowMinimum = *std::min_element(nodeData.distances[i].begin(), nodeData.distances[i].end());
-        if (rowMinimum == std::numeric_limits<int>::max()) {
+int TSPExactAlgorithms::bbSearch(const IGraph *tspInstance, const BBNodeData &rootNode, int upperBound,
+                                 std::list<int> &tspSolution, int nStrongBranchingCandidates) {
+    if (rootNode.lowerBound >= upperBound) {
+        return upperBound;
+    }
+    BBSearchState state(rootNode.lowerBound, upperBound, std::move(tspSolution),
+                        static_cast<int>(rootNode.distances.size()));
+    state.nodes.push(BBNodeData(rootNode), rootNode.lowerBound, rootNode.edgesOnPath);
+    bbRunSearch(tspInstance, state, nStrongBranchingCandidates, nullptr);
+    tspSolution = std::move(state.tspSolution);
+    return state.upperBound;
+}
+
+void TSPExactAlgorithms::bbRunSearch(const IGraph *tspInstance, BBSearchState &state, int nStrongBranchingCandidates,
+                                     const std::function<void(BBSearchState &)> &betweenIterations) {
+    BucketQueue<BBNodeData> &bbNodes = state.nodes;
+    int &upperBound = state.upperBound;
+    BBNodeData leftNode, rightNode, parentNode;
+    int calculatedUpperBound;
+    std::vector<int> improvedTour;
+    while (!bbNodes.isEmpty()) {
+        if (betweenIterations) {
+            betweenIterations(state);
+            if (bbNodes.isEmpty()) {
+                break;
+            }
+        }
+        rightNode = bbNodes.pop();
+        // Nodes above the upper bound remain only in buckets shared with nodes below it
+        if (rightNode.lowerBound >= upperBound) {
             continue;
         }
-        edgesAreAvailable = true;
-        for (int j = 0; j != nodeData.distances.size(); ++j) {
-            if (nodeData.distances[i][j] == std::numeric_limits<int>::max()) {
-                continue;
+        if (!rightNode.isFinal) {
+            if (state.nExpandedNodes++ == state.nextImprovementNode) {
+                improvedTour.clear();
+                calculatedUpperBound = bbCompleteAndImproveTour(tspInstance, rightNode, improvedTour);
+                state.improvementInterval = calculatedUpperBound < upperBound ? BB_IMPROVEMENT_INTERVAL
+                                                                              : 2 * state.improvementInterval;
+                state.nextImprovementNode += state.improvementInterval;
+                if (calculatedUpperBound < upperBound) {
+                    upperBound = calculatedUpperBound;
+                    state.tspSolution.assign(improvedTour.begin(), improvedTour.end());
+                    bbNodes.eraseFrom(upperBound);
+                    if (rightNode.lowerBound >= upperBound) {
+                        continue;
+                    }
+                }
             }
-            nodeData.distances[i][j] -= rowMinimum;
-            if (nodeData.distances[i][j] == 0) {
-                matrixZeroes.emplace_back(EdgeCities(i, j), 0);
+            if (nStrongBranchingCandidates > 0) {
+                parentNode = std::move(rightNode);
+                bbBranchStrongly(parentNode, nStrongBranchingCandidates, upperBound, leftNode, rightNode);
+            } else {
+                leftNode = rightNode;
+                bbUpdateLeftNodeData(leftNode);
+                bbCalculateLowerBoundAndDesignateHighestZeroPenalties(leftNode);
+                bbUpdateRightNodeData(rightNode);
+                bbCalculateLowerBoundAndDesignateHighestZeroPenalties(rightNode);
+            }
+
+            if (leftNode.lowerBound < upperBound) {
+                const int lowerBound = leftNode.lowerBound;
+                const int edgesOnPath = leftNode.edgesOnPath;
+                bbNodes.push(std::move(leftNode), lowerBound, edgesOnPath);
+            }
+            if (rightNode.lowerBound < upperBound) {
+                const int lowerBound = rightNode.lowerBound;
+                const int edgesOnPath = rightNode.edgesOnPath;
+                bbNodes.push(std::move(rightNode), lowerBound, edgesOnPath);
+            }
+        } else if (rightNode.edgesOnPath == static_cast<int>(rightNode.pathVertices.size()) - 1) {
+            // Other final nodes ran out of edges (instances with missing edges)
+            std::list<int> tour = bbGetPath(rightNode.pathVertices);
+            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
+            if (calculatedUpperBound < upperBound) {
+                upperBound = calculatedUpperBound;
+                state.tspSolution = tour;
+                bbNodes.eraseFrom(upperBound);
             }
         }
-        nodeData.lowerBound += rowMinimum;
     }
+}
 
-    if (!edgesAreAvailable) {
-        nodeData.isFinal = true;
-        return;
+std::string TSPExactAlgorithms::bbSaveSearchState(const BBSearchState &state, const std::vector<int> &costs) {
+    BinaryWriter writer;
+    writer.writeInt32(state.upperBound);
+    writer.writeInt32Vector(std::vector<int>(state.tspSolution.begin(), state.tspSolution.end()));
+    writer.writeInt64(state.nExpandedNodes);
+    writer.writeInt64(state.improvementInterval);
+    writer.writeInt64(state.nextImprovementNode);
+    writer.writeUInt64(static_cast<std::uint64_t>(state.nodes.getSize()));
+    state.nodes.forEach([&writer, &costs](const BBNodeData &nodeData) {
+        bbWriteNodeConstraints(writer, nodeData, costs);
+    });
+    return writer.getBuffer();
+}
+
+std::unique_ptr<TSPExactAlgorithms::BBSearchState>
+TSPExactAlgorithms::bbLoadSearchState(const std::string &payload, const IGraph *tspInstance,
+                                      const std::vector<int> &costs) {
+    const int instanceSize = tspInstance->getVertexCount();
+    BinaryReader reader(payload);
+    const int upperBound = reader.readInt32();
+    const std::vector<int> tour = reader.readInt32Vector();
+    if (!TSPUtils::isSolutionValid(tspInstance, tour, upperBound)) {
+        throw std::out_of_range("Invalid incumbent");
+    }
+    const long long nExpandedNodes = reader.readInt64();
+    const long long improvementInterval = reader.readInt64();
+    const long long nextImprovementNode = reader.readInt64();
+    const std::uint64_t nNodes = reader.readUInt64();
+
+    std::vector<BBNodeData> nodes;
+    int minKey = upperBound;
+    for (std::uint64_t nodeIdx = 0; nodeIdx < nNodes; ++nodeIdx) {
+        BBNodeData nodeData = bbReadNodeConstraints(reader, costs, instanceSize);
+        if (nodeData.lowerBound < upperBound) {
+            minKey = std::min(minKey, nodeData.lowerBound);
+            nodes.emplace_back(std::move(nodeData));
+        }
+    }
+    if (!reader.isAtEnd()) {
+        throw std::out_of_range("Data after the last node");
     }
 
-    int columnMinimum;
-    for (int j = 0; j != nodeData.distances.size(); ++j) {
-        columnMinimum = nodeData.distances[0][j];
-        for (int i = 1; i != nodeData.distances.size(); ++i) {
-            if (nodeData.distances[i][j] < columnMinimum) {
-                columnMinimum = nodeData.distances[i][j];
-            }
+    auto state = std::make_unique<BBSearchState>(minKey, upperBound, std::list<int>(tour.begin(), tour.end()),
+                                                 instanceSize);
+    state->nExpandedNodes = nExpandedNodes;
+    state->improvementInterval = improvementInterval;
+    state->nextImprovementNode = nextImprovementNode;
+    for (auto &nodeData : nodes) {
+        const int lowerBound = nodeData.lowerBound;
+        const int edgesOnPath = nodeData.edgesOnPath;
+        state->nodes.push(std::move(nodeData), lowerBound, edgesOnPath);
+    }
+    return state;
+}
+
+void TSPExactAlgorithms::bbWriteNodeConstraints(BinaryWriter &writer, const BBNodeData &nodeData,
+                                               const std::vector<int> &costs) {
+    const int instanceSize = static_cast<int>(nodeData.distances.size());
+    const int infinity = std::numeric_limits<int>::max();
+    std::vector<bool> hasPredecessor(instanceSize, false);
+    // Entries as i * instanceSize + j
+    std::vector<int> forcedEdges, forbiddenEntries;
+    for (int i = 0; i != instanceSize; ++i) {
+        const int successor = nodeData.pathVertices[i].successor;
+        if (successor != -1) {
+            forcedEdges.emplace_back(i * instanceSize + successor);
+            hasPredecessor[successor] = true;
         }
-        if (columnMinimum == std::numeric_limits<int>::max() || columnMinimum == 0) {
+    }
+    for (int i = 0; i != instanceSize; ++i) {
+        if (nodeData.pathVertices[i].successor != -1) {
             continue;
         }
-        for (int i = 0; i != nodeData.distances.size(); ++i) {
-            if (nodeData.distances[i][j] == std::numeric_limits<int>::max()) {
-                continue;
+        for (int j = 0; j != instanceSize; ++j) {
+            if (i != j && !hasPredecessor[j] && nodeData.distances[i][j] == infinity
+                && costs[i * instanceSize + j] != infinity) {
+                forbiddenEntries.emplace_back(i * instanceSize + j);
             }
-            nodeData.distances[i][j] -= columnMinimum;
+        }
+    }
+    writer.writeInt32Vector(forcedEdges);
+    writer.writeInt32Vector(forbiddenEntries);
+}
+
+BBNodeData TSPExactAlgorithms::bbReadNodeConstraints(BinaryReader &reader, const std::vector<int> &costs,
+                                                    int instanceSize) {
+    const int infinity = std::numeric_limits<int>::max();
+    const std::vector<int> forcedEdges = reader.readInt32Vector();
+    const std::vector<int> forbiddenEntries = reader.readInt32Vector();
+    const int nEntries = instanceSize * instanceSize;
+
+    BBNodeData nodeData(instanceSize);
+    std::vector<bool> hasPredecessor(instanceSize, false);
+    long long forcedEdgesCost = 0;
+    for (const int entry : forcedEdges) {
+        if (entry < 0 || entry >= nEntries) {
+            throw std::out_of_range("Invalid forced edge");
+        }
+        const int i = entry / instanceSize, j = entry % instanceSize;
+        if (i == j || nodeData.pathVertices[i].successor != -1 || hasPredecessor[j] || costs[entry] == infinity) {
+            throw std::out_of_range("Invalid forced edge");
+        }
+        nodeData.pathVertices[i].successor = j;
+        hasPredecessor[j] = true;
+        forcedEdgesCost += costs[entry];
+    }
+    // Paths are joined by their endpoints; a cycle leaves its vertices unvisited
+    int nVisitedVertices = 0;
+    for (int head = 0; head != instanceSize; ++head) {
+        if (hasPredecessor[head]) {
+            continue;
+        }
+        int tail = head;
+        for (++nVisitedVertices; nodeData.pathVertices[tail].successor != -1; ++nVisitedVertices) {
+            tail = nodeData.pathVertices[tail].successor;
+        }
+        nodeData.pathVertices[head].pathTail = tail;
+        nodeData.pathVertices[tail].pathHead = head;
+    }
+    if (nVisitedVertices != instanceSize || forcedEdges.size() >= static_cast<std::size_t>(std::max(instanceSize, 1))
+        || forcedEdgesCost >= infinity) {
+        throw std::out_of_range("Forced edges are not paths");
+    }
+    nodeData.edgesOnPath = static_cast<int>(forcedEdges.size());
+
+    for (int i = 0; i != instanceSize; ++i) {
+        for (int j = 0; j != instanceSize; ++j) {
+            nodeData.distances[i][j] = i == j || nodeData.pathVertices[i].successor != -1 || hasPredecessor[j]
+                                       ? infinity : costs[i * instanceSize + j];
+        }
+    }
+    for (const int entry : forbiddenEntries) {
+        if (entry < 0 || entry >= nEntries) {
+            throw std::out_of_range("Invalid forbidden entry");
+        }
+        nodeData.distances[entry / instanceSize][entry % instanceSize] = infinity;
+    }
+    nodeData.lowerBound = static_cast<int>(forcedEdgesCost);
+    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(nodeData);
+    return nodeData;
+}
+
+void TSPExactAlgorithms::bbBranchStrongly(BBNodeData &nodeData, int nStrongBranchingCandidates, int upperBound,
+                                          BBNodeData &outLeftNode, BBNodeData &outRightNode) {
+    const int instanceSize = static_cast<int>(nodeData.distances.size());
+    const int infinity = std::numeric_limits<int>::max();
+    std::vector<std::pair<int, EdgeCities>> zeroPenalties;
+    bbFindZeroPenalties(bbGetRowPointers(nodeData.distances), zeroPenalties);
+    if (zeroPenalties.empty() || nodeData.edgesOnPath + 2 >= instanceSize) {
+        // Nothing to choose from / children without open rows - the usual branching
+        outLeftNode = nodeData;
+        bbUpdateLeftNodeData(outLeftNode);
+        bbCalculateLowerBoundAndDesignateHighestZeroPenalties(outLeftNode);
+        outRightNode = std::move(nodeData);
+        bbUpdateRightNodeData(outRightNode);
+        bbCalculateLowerBoundAndDesignateHighestZeroPenalties(outRightNode);
+        return;
+    }
+    // Highest penalties first, row-major order on ties - the first candidate is the usual branching zero
+    std::stable_sort(zeroPenalties.begin(), zeroPenalties.end(),
+                     [](const std::pair<int, EdgeCities> &lhs, const std::pair<int, EdgeCities> &rhs) -> bool {
+                         return lhs.first > rhs.first;
+                     });
+    const auto lastCandidateIt = zeroPenalties.begin() + std::min<std::size_t>(nStrongBranchingCandidates,
+                                                                                zeroPenalties.size());
+
+    std::vector<int> rowZeroCounts(instanceSize, 0), columnZeroCounts(instanceSize, 0);
+    for (int i = 0; i != instanceSize; ++i) {
+        for (int j = 0; j != instanceSize; ++j) {
             if (nodeData.distances[i][j] == 0) {
-                matrixZeroes.emplace_back(EdgeCities(i, j), 0);
+                ++rowZeroCounts[i];
+                ++columnZeroCounts[j];
+            }
+        }
+    }
+
+    // Excluding a zero raises the bound by exactly its penalty (only its row and column lose their zero)
+    std::vector<std::pair<int, int>> rowReductions, columnReductions, branchingRowReductions, branchingColumnReductions;
+    int weakerChildBound = -1, strongerChildBound = -1, rightChildBound = infinity;
+    auto branchingZeroIt = zeroPenalties.begin();
+    for (auto candidateIt = zeroPenalties.begin(); candidateIt != lastCandidateIt; ++candidateIt) {
+        const int candidateRightBound = bbEvaluateRightChild(nodeData, candidateIt->second, rowZeroCounts,
+                                                             columnZeroCounts, rowReductions, columnReductions);
+        const int candidateLeftBound = static_cast<int>(std::min<long long>(
+                static_cast<long long>(nodeData.lowerBound) + candidateIt->first, infinity));
+        const int candidateWeakerBound = std::min(candidateLeftBound, candidateRightBound);
+        const int candidateStrongerBound = std::max(candidateLeftBound, candidateRightBound);
+        if (candidateWeakerBound > weakerChildBound
+            || (candidateWeakerBound == weakerChildBound && candidateStrongerBound > strongerChildBound)) {
+            weakerChildBound = candidateWeakerBound;
+            strongerChildBound = candidateStrongerBound;
+            rightChildBound = candidateRightBound;
+            branchingZeroIt = candidateIt;
+            branchingRowReductions.swap(rowReductions);
+            branchingColumnReductions.swap(columnReductions);
+            if (weakerChildBound >= upperBound) {
+                // Both children are pruned
+                break;
             }
         }
-        nodeData.lowerBound += columnMinimum;
     }
-    bbDesignateHighestZeroPenalty(nodeData, matrixZeroes);
-}
 
-void TSPExactAlgorithms::bbDesignateHighestZeroPenalty(BBNodeData &nodeData,
-                                                       std::list<std::pair<EdgeCities, int>> &matrixZeroes) {
-    int rowMinimum, columnMinimum;
-    for (auto &matrixZero : matrixZeroes) {
-        rowMinimum = std::numeric_limits<int>::max();
-        for (int j = 0; j != nodeData.distances.size(); ++j) {
-            if (nodeData.distances[matrixZero.first.i][j] < rowMinimum && j != matrixZero.first.j) {
-                rowMinimum = nodeData.distances[matrixZero.first.i][j];
+    // The right child gets the reductions found by the evaluation instead of a new bbReduceMatrix
+    nodeData.highestZeroPenaltiesIndexes = branchingZeroIt->second;
+    nodeData.highestZeroPenalty = branchingZeroIt->first;
+    outRightNode = nodeData;
+    bbUpdateRightNodeData(outRightNode);
+    if (rightChildBound == infinity) {
+        outRightNode.lowerBound = infinity;
+    } else {
+        for (const auto &rowReduction : branchingRowReductions) {
+            for (auto &entry : outRightNode.distances[rowReduction.first]) {
+                if (entry != infinity) {
+                    entry -= rowReduction.second;
+                }
             }
         }
-        columnMinimum = std::numeric_limits<int>::max();
-        for (int i = 0; i != nodeData.distances.size(); ++i) {
-            if (nodeData.distances[i][matrixZero.first.j] < columnMinimum && i != matrixZero.first.i) {
-                columnMinimum = nodeData.distances[i][matrixZero.first.j];
+        for (const auto &columnReduction : branchingColumnReductions) {
+            for (auto &row : outRightNode.distances) {
+                if (row[columnReduction.first] != infinity) {
+                    row[columnReduction.first] -= columnReduction.second;
+                }
             }
         }
-//        matrixZero.second = 0; // No need for initialization
-        if (rowMinimum != std::numeric_limits<int>::max()) {
-            matrixZero.second += rowMinimum;
+        outRightNode.lowerBound = rightChildBound;
+        outRightNode.highestZeroPenalty = bbFindHighestZeroPenalty(bbGetRowPointers(outRightNode.distances),
+                                                                   outRightNode.highestZeroPenaltiesIndexes);
+    }
+
+    outLeftNode = std::move(nodeData);
+    bbUpdateLeftNodeData(outLeftNode);
+    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(outLeftNode);
+}
+
+int TSPExactAlgorithms::bbEvaluateRightChild(const BBNodeData &nodeData, const EdgeCities &addedEdge,
+                                             const std::vector<int> &rowZeroCounts,
+                                             const std::vector<int> &columnZeroCounts,
+                                             std::vector<std::pair<int, int>> &outRowReductions,
+                                             std::vector<std::pair<int, int>> &outColumnReductions) {
+    const int instanceSize = static_cast<int>(nodeData.distances.size());
+    const int infinity = std::numeric_limits<int>::max();
+    const std::vector<std::vector<int>> &distances = nodeData.distances;
+    const int i = addedEdge.i, j = addedEdge.j;
+    // As in bbUpdateRightNodeData: row i and column j are closed, (tail, head) is prohibited
+    const int head = nodeData.pathVertices[i].pathHead;
+    const int tail = nodeData.pathVertices[j].pathTail;
+    auto getChildEntry = [&distances, i, j, head, tail](int row, int column) -> int {
+        return row == i || column == j || (row == tail && column == head) ? infinity : distances[row][column];
+    };
+    outRowReductions.clear();
+    outColumnReductions.clear();
+    long long lowerBound = nodeData.lowerBound;
+
+    // Rows whose zeroes were all in column j or at (tail, head)
+    std::vector<int> rowReductions(instanceSize, 0);
+    for (int row = 0; row != instanceSize; ++row) {
+        if (row == i || (row != tail && distances[row][j] != 0)) {
+            continue;
         }
-        if (columnMinimum != std::numeric_limits<int>::max()) {
-            matrixZero.second += columnMinimum;
+        const int nRemovedZeroes = (distances[row][j] == 0 ? 1 : 0)
+                                   + (row == tail && distances[row][head] == 0 ? 1 : 0);
+        if (nRemovedZeroes == 0 || nRemovedZeroes != rowZeroCounts[row]) {
+            continue;
         }
+        int rowMinimum = infinity;
+        for (int column = 0; column != instanceSize; ++column) {
+            rowMinimum = std::min(rowMinimum, getChildEntry(row, column));
+        }
+        if (rowMinimum == infinity) {
+            return infinity;
+        }
+        rowReductions[row] = rowMinimum;
+        outRowReductions.emplace_back(row, rowMinimum);
+        lowerBound += rowMinimum;
     }
 
-    auto highestPenaltyZeroData = std::max_element(matrixZeroes.begin(), matrixZeroes.end(),
-                                                   [](std::pair<EdgeCities, int> &lhs,
-                                                      std::pair<EdgeCities, int> &rhs) -> bool {
-                                                       return lhs.second < rhs.second;
-                                                   });
-    nodeData.highestZeroPenaltiesIndexes = highestPenaltyZeroData->first;
-    nodeData.highestZeroPenalty = highestPenaltyZeroData->second;
+    // Columns whose zeroes were all in row i or at (tail, head) - reduced rows have no zeroes outside column j
+    for (int column = 0; column != instanceSize; ++column) {
+        if (column == j || (column != head && distances[i][column] != 0)) {
+            continue;
+        }
+        const int nRemovedZeroes = (distances[i][column] == 0 ? 1 : 0)
+                                   + (column == head && distances[tail][column] == 0 ? 1 : 0);
+        if (nRemovedZeroes == 0 || nRemovedZeroes != columnZeroCounts[column]) {
+            continue;
+        }
+        int columnMinimum = infinity;
+        for (int row = 0; row != instanceSize; ++row) {
+            const int entry = getChildEntry(row, column);
+            if (entry != infinity) {
+                columnMinimum = std::min(columnMinimum, entry - rowReductions[row]);
+            }
+        }
+        if (columnMinimum == infinity) {
+            return infinity;
+        }
+        outColumnReductions.emplace_back(column, columnMinimum);
+        lowerBound += columnMinimum;
+    }
+    return static_cast<int>(std::min<long long>(lowerBound, infinity));
+}
+
+void TSPExactAlgorithms::bbCalculateLowerBoundAndDesignateHighestZeroPenalties(BBNodeData &nodeData) {
+    const std::vector<int *> rows = bbGetRowPointers(nodeData.distances);
+    std::vector<int> rowReductions(rows.size()), columnReductions(rows.size());
+    const int reduction = bbReduceMatrix(rows, static_cast<int>(rows.size()) - nodeData.edgesOnPath, rowReductions,
+                                         columnReductions);
+    if (reduction == BB_NO_EDGES) {
+        nodeData.isFinal = true;
+        return;
+    } else if (reduction == BB_NO_TOUR) {
+        nodeData.lowerBound = std::numeric_limits<int>::max();
+        return;
+    }
+    nodeData.lowerBound += reduction;
+    nodeData.highestZeroPenalty = bbFindHighestZeroPenalty(rows, nodeData.highestZeroPenaltiesIndexes);
 }
 
 void TSPExactAlgorithms::bbUpdateLeftNodeData(BBNodeData &nodeData) {
@@ -399,46 +1828,18 @@ void TSPExactAlgorithms::bbUpdateLeftNodeData(BBNodeData &nodeData) {
 }
 
 void TSPExactAlgorithms::bbUpdateRightNodeData(BBNodeData &nodeData) {
-    int iCityPathIdx = -1;
-    int jCityPathIdx = -1;
-    for (int k = 0; k != nodeData.partialPaths.size(); ++k) {
-        if (nodeData.partialPaths[k].back() == nodeData.highestZeroPenaltiesIndexes.i) {
-            iCityPathIdx = k;
-        } else if (nodeData.partialPaths[k].front() == nodeData.highestZeroPenaltiesIndexes.j) {
-            jCityPathIdx = k;
-        }
-    }
-
-    EdgeCities prohibitedEdge;
-    if (iCityPathIdx == -1 && jCityPathIdx == -1) {
-        nodeData.partialPaths.emplace_back();
-        auto newPathIt = nodeData.partialPaths.end();
-        --newPathIt;
-        newPathIt->emplace_back(nodeData.highestZeroPenaltiesIndexes.i);
-        newPathIt->emplace_back(nodeData.highestZeroPenaltiesIndexes.j);
-        prohibitedEdge.i = nodeData.highestZeroPenaltiesIndexes.j;
-        prohibitedEdge.j = nodeData.highestZeroPenaltiesIndexes.i;
-        nodeData.edgesOnPath += 1;
-    } else if (iCityPathIdx != -1 && jCityPathIdx == -1) {
-        nodeData.partialPaths[iCityPathIdx].emplace_back(nodeData.highestZeroPenaltiesIndexes.j);
-        prohibitedEdge.i = nodeData.highestZeroPenaltiesIndexes.j;
-        prohibitedEdge.j = nodeData.partialPaths[iCityPathIdx].front();
-        nodeData.edgesOnPath += 1;
-    } else if (iCityPathIdx == -1 /*&& jCityPathIdx != -1*/) {
-        nodeData.partialPaths[jCityPathIdx].emplace_front(nodeData.highestZeroPenaltiesIndexes.i);
-        prohibitedEdge.i = nodeData.partialPaths[jCityPathIdx].back();
-        prohibitedEdge.j = nodeData.highestZeroPenaltiesIndexes.i;
-        nodeData.edgesOnPath += 1;
-    } else if (iCityPathIdx != jCityPathIdx) {
-        nodeData.partialPaths[iCityPathIdx].splice(nodeData.partialPaths[iCityPathIdx].end(),
-                                                   nodeData.partialPaths[jCityPathIdx]);
-        prohibitedEdge.i = nodeData.partialPaths[iCityPathIdx].back();
-        prohibitedEdge.j = nodeData.partialPaths[iCityPathIdx].front();
-        nodeData.partialPaths.erase(nodeData.partialPaths.begin() + jCityPathIdx);
-        nodeData.edgesOnPath += 1;
-    } else { // iCityPathIdx == jCityPathIdx
+    const EdgeCities &addedEdge = nodeData.highestZeroPenaltiesIndexes;
+    // i ends a path and j starts one - edge from the end of j's path to the beginning of i's path would close a cycle
+    const int head = nodeData.pathVertices[addedEdge.i].pathHead;
+    const int tail = nodeData.pathVertices[addedEdge.j].pathTail;
+    if (head == addedEdge.j) {
         throw std::exception();
     }
+    nodeData.pathVertices[addedEdge.i].successor = addedEdge.j;
+    nodeData.pathVertices[head].pathTail = tail;
+    nodeData.pathVertices[tail].pathHead = head;
+    const EdgeCities prohibitedEdge(tail, head);
+    nodeData.edgesOnPath += 1;
 
     for (int j = 0; j != nodeData.distances.size(); ++j) {
         nodeData.distances[nodeData.highestZeroPenaltiesIndexes.i][j] = std::numeric_limits<int>::max();
@@ -450,8 +1851,6 @@ void TSPExactAlgorithms::bbUpdateRightNodeData(BBNodeData &nodeData) {
 }
 
 int TSPExactAlgorithms::branchAndBound0Heuristics(const IGraph *tspInstance, std::vector<int> &outSolution) {
-    const int instanceSize = tspInstance->getVertexCount();
-
     auto bbNodeComparator =
             [](const BBNodeData &lhs, const BBNodeData &rhs) -> bool {
                 if (lhs.lowerBound == rhs.lowerBound) {
@@ -464,17 +1863,7 @@ int TSPExactAlgorithms::branchAndBound0Heuristics(const IGraph *tspInstance, std
     int upperBound = std::numeric_limits<int>::max();
     std::list<int> tspSolution;
 
-    BBNodeData initNode(instanceSize);
-    for (int i = 0; i != instanceSize; ++i) {
-        for (int j = 0; j != instanceSize; ++j) {
-            if (i == j) {
-                initNode.distances[i][j] = std::numeric_limits<int>::max();
-            }
-            initNode.distances[i][j] = tspInstance->getEdgeParameter(i, j);
-        }
-    }
-    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(initNode);
-    bbNodes.push(initNode);
+    bbNodes.push(bbCreateRootNode(tspInstance));
 
     BBNodeData leftNode, rightNode;
     int calculatedUpperBound;
@@ -496,11 +1885,11 @@ int TSPExactAlgorithms::branchAndBound0Heuristics(const IGraph *tspInstance, std
                 bbNodes.push(rightNode);
             }
         } else {
-            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance,
-                                                                          bbNodes.top().partialPaths.front());
+            std::list<int> tour = bbGetPath(bbNodes.top().pathVertices);
+            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
             if (calculatedUpperBound < upperBound) {
                 upperBound = calculatedUpperBound;
-                tspSolution = bbNodes.top().partialPaths.front();
+                tspSolution = tour;
             }
             bbNodes.pop();
         }
@@ -512,8 +1901,6 @@ int TSPExactAlgorithms::branchAndBound0Heuristics(const IGraph *tspInstance, std
 }
 
 int TSPExactAlgorithms::branchAndBoundNNHeuristic(const IGraph *tspInstance, std::vector<int> &outSolution) {
-    const int instanceSize = tspInstance->getVertexCount();
-
     auto bbNodeComparator =
             [](const BBNodeData &lhs, const BBNodeData &rhs) -> bool {
                 if (lhs.lowerBound == rhs.lowerBound) {
@@ -530,17 +1917,7 @@ int TSPExactAlgorithms::branchAndBoundNNHeuristic(const IGraph *tspInstance, std
         tspSolution.emplace_back(vertex);
     }
 
-    BBNodeData initNode(instanceSize);
-    for (int i = 0; i != instanceSize; ++i) {
-        for (int j = 0; j != instanceSize; ++j) {
-            if (i == j) {
-                initNode.distances[i][j] = std::numeric_limits<int>::max();
-            }
-            initNode.distances[i][j] = tspInstance->getEdgeParameter(i, j);
-        }
-    }
-    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(initNode);
-    bbNodes.push(initNode);
+    bbNodes.push(bbCreateRootNode(tspInstance));
 
     BBNodeData leftNode, rightNode;
     int calculatedUpperBound;
@@ -562,11 +1939,11 @@ int TSPExactAlgorithms::branchAndBoundNNHeuristic(const IGraph *tspInstance, std
                 bbNodes.push(rightNode);
             }
         } else {
-            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance,
-                                                                          bbNodes.top().partialPaths.front());
+            std::list<int> tour = bbGetPath(bbNodes.top().pathVertices);
+            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
             if (calculatedUpperBound < upperBound) {
                 upperBound = calculatedUpperBound;
-                tspSolution = bbNodes.top().partialPaths.front();
+                tspSolution = tour;
             }
             bbNodes.pop();
         }
@@ -578,8 +1955,6 @@ int TSPExactAlgorithms::branchAndBoundNNHeuristic(const IGraph *tspInstance, std
 }
 
 int TSPExactAlgorithms::branchAndBoundGHeuristic(const IGraph *tspInstance, std::vector<int> &outSolution) {
-    const int instanceSize = tspInstance->getVertexCount();
-
     auto bbNodeComparator =
             [](const BBNodeData &lhs, const BBNodeData &rhs) -> bool {
                 if (lhs.lowerBound == rhs.lowerBound) {
@@ -596,17 +1971,7 @@ int TSPExactAlgorithms::branchAndBoundGHeuristic(const IGraph *tspInstance, std:
         tspSolution.emplace_back(vertex);
     }
 
-    BBNodeData initNode(instanceSize);
-    for (int i = 0; i != instanceSize; ++i) {
-        for (int j = 0; j != instanceSize; ++j) {
-            if (i == j) {
-                initNode.distances[i][j] = std::numeric_limits<int>::max();
-            }
-            initNode.distances[i][j] = tspInstance->getEdgeParameter(i, j);
-        }
-    }
-    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(initNode);
-    bbNodes.push(initNode);
+    bbNodes.push(bbCreateRootNode(tspInstance));
 
     BBNodeData leftNode, rightNode;
     int calculatedUpperBound;
@@ -628,11 +1993,11 @@ int TSPExactAlgorithms::branchAndBoundGHeuristic(const IGraph *tspInstance, std:
                 bbNodes.push(rightNode);
             }
         } else {
-            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance,
-                                                                          bbNodes.top().partialPaths.front());
+            std::list<int> tour = bbGetPath(bbNodes.top().pathVertices);
+            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
             if (calculatedUpperBound < upperBound) {
                 upperBound = calculatedUpperBound;
-                tspSolution = bbNodes.top().partialPaths.front();
+                tspSolution = tour;
             }
             bbNodes.pop();
         }
@@ -644,8 +2009,6 @@ int TSPExactAlgorithms::branchAndBoundGHeuristic(const IGraph *tspInstance, std:
 }
 
 int TSPExactAlgorithms::branchAndBound2Heuristics(const IGraph *tspInstance, std::vector<int> &outSolution) {
-    const int instanceSize = tspInstance->getVertexCount();
-
     auto bbNodeComparator =
             [](const BBNodeData &lhs, const BBNodeData &rhs) -> bool {
                 if (lhs.lowerBound == rhs.lowerBound) {
@@ -680,17 +2043,7 @@ int TSPExactAlgorithms::branchAndBound2Heuristics(const IGraph *tspInstance, std
         tspSolution.emplace_back(vertex);
     }
 
-    BBNodeData initNode(instanceSize);
-    for (int i = 0; i != instanceSize; ++i) {
-        for (int j = 0; j != instanceSize; ++j) {
-            if (i == j) {
-                initNode.distances[i][j] = std::numeric_limits<int>::max();
-            }
-            initNode.distances[i][j] = tspInstance->getEdgeParameter(i, j);
-        }
-    }
-    bbCalculateLowerBoundAndDesignateHighestZeroPenalties(initNode);
-    bbNodes.push(initNode);
+    bbNodes.push(bbCreateRootNode(tspInstance));
 
     BBNodeData leftNode, rightNode;
     int calculatedUpperBound;
@@ -712,11 +2065,11 @@ int TSPExactAlgorithms::branchAndBound2Heuristics(const IGraph *tspInstance, std
                 bbNodes.push(rightNode);
             }
         } else {
-            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance,
-                                                                          bbNodes.top().partialPaths.front());
+            std::list<int> tour = bbGetPath(bbNodes.top().pathVertices);
+            calculatedUpperBound = TSPUtils::calculateTargetFunctionValue(tspInstance, tour);
             if (calculatedUpperBound < upperBound) {
                 upperBound = calculatedUpperBound;
-                tspSolution = bbNodes.top().partialPaths.front();
+                tspSolution = tour;
             }
             bbNodes.pop();
         }
@@ -1,19 +1,32 @@
 #ifndef PEA_P1_TSPEXACTALGORITHMS_H
 #define PEA_P1_TSPEXACTALGORITHMS_H
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <queue>
 #include <list>
 #include <limits>
 #include <algorithm>
+#include <functional>
+#include <memory>
 
+#include "../structures/BucketQueue.h"
 #include "../utilities/TSPUtils.h"
 #include "helper_structures/TSPHelperStructures.h"
 #include "TSPGreedyAlgorithms.h"
 
+class InstanceContext;
+class BinaryWriter;
+class BinaryReader;
+class DistributedBranchAndBound;
+
 // outSolution is a permutation of vertices (not cycle) - MUST be provided (as an argument) empty
 class TSPExactAlgorithms {
 
+    // Runs bbSearch on nodes exchanged between processes
+    friend class DistributedBranchAndBound;
+
 public:
     static int bruteForce(const IGraph *tspInstance, std::vector<int> &outSolution);
 
@@ -22,8 +35,70 @@ public:
 
     static int dynamicProgrammingHeldKarp(const IGraph *tspInstance, std::vector<int> &outSolution);
 
+    // Held-Karp over reachable states only: layers (by path length) are hash tables of states whose cost plus
+    // the cheapest edges leaving/entering the unvisited vertices is below the NN/greedy tour value.
+    // Throws std::invalid_argument for instances bigger than DP_PRUNED_MAX_INSTANCE_SIZE.
+    static int dynamicProgrammingHeldKarpPruned(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Path set and end vertex of a state are packed into one 64-bit key
+    static const int DP_PRUNED_MAX_INSTANCE_SIZE = 58;
+
+    // dynamicProgrammingHeldKarpPruned on the instance without edges removed by eliminateEdges.
+    // Throws std::invalid_argument for instances bigger than DP_PRUNED_MAX_INSTANCE_SIZE.
+    static int dynamicProgrammingHeldKarpWithEdgeElimination(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Held-Karp keeping layers of path sets (by size) in memory-mapped files in workingDirectory: a layer is computed
+    // from the previous one only, so just two layers of costs exist at a time; one parent byte per state is kept
+    // until the tour is rebuilt. All files are removed on return. Throws std::invalid_argument for instances
+    // bigger than DP_OUT_OF_CORE_MAX_INSTANCE_SIZE and std::runtime_error if the files can't be created.
+    static int dynamicProgrammingHeldKarpOutOfCore(const IGraph *tspInstance, const std::string &workingDirectory,
+                                                   std::vector<int> &outSolution);
+
+    static const int DP_OUT_OF_CORE_MAX_INSTANCE_SIZE = 32;
+
+    // Held-Karp for symmetric instances: a tour read backwards is a path from the start vertex too, so tours are
+    // joined from two paths over halves of the vertices - only layers up to half of the instance are computed.
+    // Throws std::invalid_argument for asymmetric instances and ones bigger than DP_SYMMETRIC_MAX_INSTANCE_SIZE.
+    static int dynamicProgrammingHeldKarpSymmetric(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    static const int DP_SYMMETRIC_MAX_INSTANCE_SIZE = 32;
+
     static int branchAndBound(const IGraph *tspInstance, std::vector<int> &outSolution);
 
+    // branchAndBound with heuristic tours and root node taken from instanceContext (created for tspInstance)
+    static int branchAndBoundWithContext(const IGraph *tspInstance, const InstanceContext &instanceContext,
+                                         std::vector<int> &outSolution);
+
+    // branchAndBound with nodes kept as dual potentials and forced / forbidden edges - O(n + depth) per node instead
+    // of a reduced matrix; reduced costs are rebuilt from the instance when a node is expanded
+    static int branchAndBoundCompactNodes(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Depth-first branchAndBound on one matrix changed in place; changes are kept on an undo trail and reverted on
+    // backtrack, so memory is O(n^2 + depth * n). Edge inclusion is explored first.
+    static int branchAndBoundDepthFirst(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // branchAndBound branching on the edge that maximises the lower bound of the weaker child among
+    // BB_STRONG_BRANCHING_CANDIDATES zeroes with the highest penalties. Children including an edge are evaluated
+    // incrementally, the reductions found for the chosen one are reused to build it.
+    static int branchAndBoundStrongBranching(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // branchAndBound saving its frontier, incumbent and counters to checkpointPath (CheckpointWriter - written by a
+    // background thread) every checkpointIntervalMs; a valid checkpoint of the instance found there is resumed, other
+    // files are overwritten. The file is removed when the search ends. Throws std::runtime_error if a checkpoint
+    // can't be written.
+    static int branchAndBoundWithCheckpoint(const IGraph *tspInstance, const std::string &checkpointPath,
+                                            int checkpointIntervalMs, std::vector<int> &outSolution);
+
+    static const int BB_CHECKPOINT_INTERVAL_MS = 60000;
+
+    // branchAndBound started from the instance without edges removed by eliminateEdges
+    static int branchAndBoundWithEdgeElimination(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Reduced-cost edge elimination: the assignment relaxation gives lower bound LB and dual values u, v; a tour
+    // with edge (i, j) costs at least LB + c(i, j) - u[i] - v[j], so edges for which it exceeds upperBound are
+    // removed (set to INT_MAX) from costs (flat nVertex x nVertex). Returns the number of removed edges.
+    static int eliminateEdges(std::vector<int> &costs, int nVertex, int upperBound);
+
     // For tests
     static int branchAndBound0Heuristics(const IGraph *tspInstance, std::vector<int> &outSolution);
 
@@ -33,22 +108,182 @@ public:
 
     static int branchAndBound2Heuristics(const IGraph *tspInstance, std::vector<int> &outSolution);
 
+    // Reduced instance matrix with lower bound and designated branching zero - root of the B&B tree
+    static BBNodeData bbCreateRootNode(const IGraph *tspInstance);
+
 private:
 
+    // Minimum size of a sub-permutation rejected at once by bruteForce (smaller ones aren't worth the bound)
+    static const int BF_MIN_PRUNING_LEVEL = 3;
+
+    static void bfSkipHeapSubPermutations(std::vector<int> &permutation, int size);
+
     static void
     bruteForceTreeRecursiveBuild(std::vector<int> &availableElements, std::vector<int> &usedElements,
                                  int &bestSolutionValue, const IGraph *tspInstance,
                                  std::vector<int> &solution);
 
+    // State of dynamicProgrammingHeldKarpPruned
+    struct DPStateData {
+        int pathCost;
+        int predecessor;
+    };
+
+    static std::uint64_t dpGetStateKey(std::uint64_t pathSet, int endVertex);
+
+    // Best of nearest neighbour, greedy and Karp patching tours improved by TSPLocalSearchAlgorithms::localDescent
+    static int designateImprovedHeuristicSolution(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Search of dynamicProgrammingHeldKarpPruned over costs (flat nVertex x nVertex, INT_MAX - no edge) for a tour
+    // cheaper than upperBound; upperBoundSolution is returned if there is none
+    static int dpSearchPruned(const std::vector<int> &costs, int nVertex, int upperBound,
+                              const std::vector<int> &upperBoundSolution, std::vector<int> &outSolution);
+
+    // Cost of a missing path in layers of the layered Held-Karp
+    static const int DP_NO_PATH = std::numeric_limits<int>::max();
+
+    // Instance as a flat row-major matrix
+    static std::vector<int> dpCopyCosts(const IGraph *tspInstance);
+
+    // [a][b] - a choose b
+    static std::vector<std::vector<std::uint64_t>> dpCreateBinomials(int maxSetSize);
+
+    // Position of pathSet among sets of the same size in colexicographic order
+    static std::uint64_t dpGetPathSetRank(std::uint32_t pathSet, const std::vector<std::vector<std::uint64_t>> &binomials);
+
+    // Layer of the layered Held-Karp: for every set of layer vertices (colexicographic order), costs and parents
+    // of the paths from the start vertex ending in each vertex of the set (ascending), from the previous layer
+    static void dpComputeLayer(const std::vector<int> &costs, int nVertex, int layer,
+                               const std::vector<std::vector<std::uint64_t>> &binomials,
+                               const int *previousPathCosts, int *pathCosts, std::uint8_t *parents);
+
+    // Path over pathSet ending in endVertex, from its end (the start vertex excluded)
+    static std::vector<int> dpFollowLayerParents(std::uint32_t pathSet, int endVertex,
+                                                 const std::vector<const std::uint8_t *> &parentLayers,
+                                                 const std::vector<std::vector<std::uint64_t>> &binomials);
+
     static int
     dpGetPartialPathCost(unsigned int partialPathSet, int endVertexIdx,
                          std::vector<std::vector<int>> &partialPathCostTable,
                          const IGraph *tspInstance);
 
-    static void bbCalculateLowerBoundAndDesignateHighestZeroPenalties(BBNodeData &nodeData);
+    // Best of natural, nearest neighbour, greedy and Karp patching tours (the first one on ties) - initial upper bound
+    static int bbDesignateHeuristicSolution(const IGraph *tspInstance, std::list<int> &outSolution);
 
-    static void
-    bbDesignateHighestZeroPenalty(BBNodeData &nodeData, std::list<std::pair<EdgeCities, int>> &matrixZeroes);
+    // Rebuilds reduced costs of nodeData from costs (instance matrix) and reduces them further: potentials,
+    // lower bound, isFinal and the branching zero are updated as in bbCalculateLowerBoundAndDesignateHighestZeroPenalties
+    static void bbEvaluateCompactNode(const std::vector<int> &costs, BBCompactNodeData &nodeData,
+                                      std::vector<int> &reducedCosts);
+
+    // Rows of a flat row-major matrix / of a matrix
+    static std::vector<int *> bbGetRowPointers(std::vector<int> &matrix, int instanceSize);
+
+    static std::vector<int *> bbGetRowPointers(std::vector<std::vector<int>> &matrix);
+
+    // Results of bbReduceMatrix other than the reduction
+    static const int BB_NO_EDGES = -1;
+    static const int BB_NO_TOUR = -2;
+
+    // Core of every B&B node: subtracts row, then column minima from available entries of the square matrix given by
+    // rows (infinity - unavailable), writes them to rowReductions / columnReductions (0 if nothing is available)
+    // and returns their sum. Returns BB_NO_EDGES if no entry is available and BB_NO_TOUR if fewer than nOpenRows
+    // rows or columns (those not on the path yet) have one - the matrix is reduced then too.
+    static int bbReduceMatrix(const std::vector<int *> &rows, int nOpenRows, std::vector<int> &rowReductions,
+                              std::vector<int> &columnReductions);
+
+    // Zero of a reduced matrix with the highest penalty - sum of the cheapest other entries of its row and column;
+    // the first one in row-major order on ties. Returns -1 if there are no zeroes.
+    static int bbFindHighestZeroPenalty(const std::vector<int *> &rows, EdgeCities &outZero);
+
+    // All zeroes of a reduced matrix in row-major order with their penalties
+    static void bbFindZeroPenalties(const std::vector<int *> &rows,
+                                    std::vector<std::pair<int, EdgeCities>> &outZeroPenalties);
+
+    static const int BB_STRONG_BRANCHING_CANDIDATES = 8;
+
+    // bbReduceMatrix of data.distances recorded on the trail; the reduction is added to lowerBound
+    static int bbReduceDepthFirstNode(BBDepthFirstData &data, int nOpenRows, int &lowerBound);
+
+    // Reduces the current node and explores its subtree; upperBound and tspSolution are replaced when a better tour
+    // is found. data is restored on return.
+    static void bbDepthFirstSearch(const IGraph *tspInstance, BBDepthFirstData &data, int lowerBound, int edgesOnPath,
+                                   int &upperBound, std::list<int> &tspSolution);
+
+    // Path ending in the first vertex without a successor
+    static std::list<int> bbGetPath(const std::vector<BBPathVertex> &pathVertices);
+
+    // Forced edges of the node as one path
+    static std::list<int> bbGetCompactNodePath(const BBCompactNodeData &nodeData, int instanceSize);
+
+    // Expanded nodes of bbSearch between two bbCompleteAndImproveTour calls after an improvement
+    static const int BB_IMPROVEMENT_INTERVAL = 512;
+
+    // Partial paths of the node joined greedily by its cheapest remaining entries (the rest in any order), then
+    // improved by TSPLocalSearchAlgorithms::localDescent
+    static int bbCompleteAndImproveTour(const IGraph *tspInstance, const BBNodeData &nodeData,
+                                        std::vector<int> &outSolution);
+
+    // Frontier, incumbent and counters of the best-first search - all a checkpoint needs
+    struct BBSearchState {
+        // Lower bounds of children never decrease, so the queue holds keys from [root lower bound, upper bound);
+        // levels - edges on path, deeper nodes first on ties
+        BucketQueue<BBNodeData> nodes;
+        int upperBound;
+        std::list<int> tspSolution;
+        long long nExpandedNodes;
+        // Doubled after each bbCompleteAndImproveTour that doesn't improve the bound
+        long long improvementInterval;
+        long long nextImprovementNode;
+
+        // Empty queue of keys from [minKey, upperBound]
+        BBSearchState(int minKey, int upperBound, std::list<int> tspSolution, int instanceSize);
+    };
+
+    // Best-first search from rootNode; returns the best value found, tspSolution is replaced when it improves.
+    // Periodically the popped node is completed to a tour that may improve the bound. With nStrongBranchingCandidates
+    // > 0 nodes are branched as in branchAndBoundStrongBranching.
+    static int bbSearch(const IGraph *tspInstance, const BBNodeData &rootNode, int upperBound,
+                        std::list<int> &tspSolution, int nStrongBranchingCandidates = 0);
+
+    // Loop of bbSearch until the queue of state is empty. betweenIterations (if set) is called before each pop, when
+    // the state holds every node left to explore - it may save the state, take nodes or lower the upper bound.
+    static void bbRunSearch(const IGraph *tspInstance, BBSearchState &state, int nStrongBranchingCandidates,
+                            const std::function<void(BBSearchState &)> &betweenIterations);
+
+    // Kind of run in checkpoints of branchAndBoundWithCheckpoint
+    static const std::uint32_t BB_CHECKPOINT_KIND = 1;
+
+    // Incumbent, counters and nodes of state; costs - instance as a flat matrix
+    static std::string bbSaveSearchState(const BBSearchState &state, const std::vector<int> &costs);
+
+    // State saved by bbSaveSearchState, nodes rebuilt by bbReadNodeConstraints. Throws std::out_of_range if the
+    // payload is inconsistent with the instance.
+    static std::unique_ptr<BBSearchState> bbLoadSearchState(const std::string &payload, const IGraph *tspInstance,
+                                                            const std::vector<int> &costs);
+
+    // Node as its forced edges and the entries of open rows and columns forbidden by branching - O(n + number of
+    // branchings) instead of the matrix; used by checkpoints and DistributedBranchAndBound
+    static void bbWriteNodeConstraints(BinaryWriter &writer, const BBNodeData &nodeData, const std::vector<int> &costs);
+
+    // Node with the written constraints reduced from the instance again: its lower bound is the cost of forced edges
+    // plus the reduction, so it may differ from the written node's. Throws std::out_of_range for invalid constraints.
+    static BBNodeData bbReadNodeConstraints(BinaryReader &reader, const std::vector<int> &costs, int instanceSize);
+
+    // Children of the node for each of the nStrongBranchingCandidates zeroes with the highest penalties; the pair with
+    // the highest lower bound of the weaker child (then of the other one) is left in outLeftNode / outRightNode
+    static void bbBranchStrongly(BBNodeData &nodeData, int nStrongBranchingCandidates, int upperBound,
+                                 BBNodeData &outLeftNode, BBNodeData &outRightNode);
+
+    // Lower bound of the child of the node including addedEdge (INT_MAX if it has no tour) without building it: only
+    // rows and columns that lose all their zeroes (counted in rowZeroCounts / columnZeroCounts) are reduced again.
+    // Their (index, reduction) pairs are written to outRowReductions / outColumnReductions. The child must keep an
+    // open row.
+    static int bbEvaluateRightChild(const BBNodeData &nodeData, const EdgeCities &addedEdge,
+                                    const std::vector<int> &rowZeroCounts, const std::vector<int> &columnZeroCounts,
+                                    std::vector<std::pair<int, int>> &outRowReductions,
+                                    std::vector<std::pair<int, int>> &outColumnReductions);
+
+    static void bbCalculateLowerBoundAndDesignateHighestZeroPenalties(BBNodeData &nodeData);
 
     static void bbUpdateLeftNodeData(BBNodeData &nodeData);
 
@@ -1,9 +1,16 @@
 #include "TSPGreedyAlgorithms.h"
+#include "AssignmentSolver.h"
+#include "../utilities/ParallelSort.h"
 #include "../utilities/Random.h"
 
 #include <vector>
 #include <list>
 #include <limits>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 int TSPGreedyAlgorithms::nearestNeighbour(const IGraph *tspInstance, std::vector<int> &outSolution) {
     const int instanceSize = tspInstance->getVertexCount();
@@ -35,35 +42,46 @@ int TSPGreedyAlgorithms::nearestNeighbour(const IGraph *tspInstance, std::vector
 int TSPGreedyAlgorithms::greedy(const IGraph *tspInstance, std::vector<int> &outSolution) {
     const int instanceSize = tspInstance->getVertexCount();
 
-    std::__cxx11::list<TSPEdge> edgesList;
+    std::vector<TSPEdge> sortedEdges;
+    sortedEdges.reserve(static_cast<std::size_t>(instanceSize) * (instanceSize > 0 ? instanceSize - 1 : 0));
     for (int i = 0; i < instanceSize; ++i) {
         for (int j = 0; j < instanceSize; ++j) {
             if (i == j) {
                 continue;
             }
-            edgesList.emplace_back(i, j, tspInstance->getEdgeParameter(i, j));
+            sortedEdges.emplace_back(i, j, tspInstance->getEdgeParameter(i, j));
         }
     }
-    edgesList.sort([](const TSPEdge &lhs, const TSPEdge &rhs) -> bool {
+    std::stable_sort(sortedEdges.begin(), sortedEdges.end(), [](const TSPEdge &lhs, const TSPEdge &rhs) -> bool {
         return lhs.cost < rhs.cost;
     });
+    return greedyOnSortedEdges(tspInstance, sortedEdges, outSolution);
+}
+
+int TSPGreedyAlgorithms::greedyOnSortedEdges(const IGraph *tspInstance, const std::vector<TSPEdge> &sortedEdges,
+                                             std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
 
     int iCityPathIdx, jCityPathIdx;
+    int edgesOnPath = 0;
     std::vector<std::list<int>> partialPaths;
     // [i][0] -> true if the city was exited, [i][1] -> true if the city was entered
     std::vector<std::vector<bool>> cityOnPath(instanceSize, std::vector<bool>(2, false));
-    while (!edgesList.empty()) {
-        if (cityOnPath[edgesList.front().i][0] || cityOnPath[edgesList.front().j][1]) {
-            edgesList.pop_front();
+    for (const TSPEdge &edge : sortedEdges) {
+        // Hamiltonian path is complete - every further edge would close a cycle
+        if (edgesOnPath == instanceSize - 1) {
+            break;
+        }
+        if (cityOnPath[edge.i][0] || cityOnPath[edge.j][1]) {
             continue;
         }
         iCityPathIdx = -1;
         jCityPathIdx = -1;
         for (int k = 0; k != partialPaths.size(); ++k) {
-            if (partialPaths[k].back() == edgesList.front().i) {
+            if (partialPaths[k].back() == edge.i) {
                 iCityPathIdx = k;
             }
-            if (partialPaths[k].front() == edgesList.front().j) {
+            if (partialPaths[k].front() == edge.j) {
                 jCityPathIdx = k;
             }
             if (iCityPathIdx != -1 && jCityPathIdx != -1) {
@@ -75,24 +93,23 @@ int TSPGreedyAlgorithms::greedy(const IGraph *tspInstance, std::vector<int> &out
             partialPaths.emplace_back();
             auto newPathIt = partialPaths.end();
             --newPathIt;
-            newPathIt->emplace_back(edgesList.front().i);
-            newPathIt->emplace_back(edgesList.front().j);
+            newPathIt->emplace_back(edge.i);
+            newPathIt->emplace_back(edge.j);
         } else if (iCityPathIdx != -1 && jCityPathIdx == -1) {
-            partialPaths[iCityPathIdx].emplace_back(edgesList.front().j);
+            partialPaths[iCityPathIdx].emplace_back(edge.j);
         } else if (iCityPathIdx == -1 /*&& jCityPathIdx != -1*/) {
-            partialPaths[jCityPathIdx].emplace_front(edgesList.front().i);
+            partialPaths[jCityPathIdx].emplace_front(edge.i);
         } else if (iCityPathIdx != jCityPathIdx) {
             partialPaths[iCityPathIdx].splice(partialPaths[iCityPathIdx].end(),
                                               partialPaths[jCityPathIdx]);
             partialPaths.erase(partialPaths.begin() + jCityPathIdx);
         } else { // iCityPathIdx == jCityPathIdx
-            edgesList.pop_front();
             continue;
         }
 
-        cityOnPath[edgesList.front().i][0] = true;
-        cityOnPath[edgesList.front().j][1] = true;
-        edgesList.pop_front();
+        cityOnPath[edge.i][0] = true;
+        cityOnPath[edge.j][1] = true;
+        ++edgesOnPath;
     }
     for (const auto &vertex : partialPaths.front()) {
         outSolution.emplace_back(vertex);
@@ -100,6 +117,213 @@ int TSPGreedyAlgorithms::greedy(const IGraph *tspInstance, std::vector<int> &out
     return TSPUtils::calculateTargetFunctionValue(tspInstance, outSolution);
 }
 
+int TSPGreedyAlgorithms::karpPatching(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
+    if (instanceSize <= 2) {
+        // The only tour
+        return createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    std::vector<int> costs(static_cast<std::size_t>(instanceSize) * instanceSize);
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = 0; j < instanceSize; ++j) {
+            costs[i * instanceSize + j] = tspInstance->getEdgeParameter(i, j);
+        }
+    }
+    AssignmentSolver assignmentSolver(std::move(costs), instanceSize);
+    if (assignmentSolver.solve() == -1) {
+        // Too sparse for a cycle cover
+        return nearestNeighbour(tspInstance, outSolution);
+    }
+    std::vector<int> successors = assignmentSolver.getAssignment();
+
+    std::vector<int> cycleIds(instanceSize, -1), cycleSizes;
+    for (int vertex = 0; vertex < instanceSize; ++vertex) {
+        if (cycleIds[vertex] != -1) {
+            continue;
+        }
+        cycleSizes.emplace_back(0);
+        for (int cycleVertex = vertex; cycleIds[cycleVertex] == -1; cycleVertex = successors[cycleVertex]) {
+            cycleIds[cycleVertex] = static_cast<int>(cycleSizes.size()) - 1;
+            ++cycleSizes.back();
+        }
+    }
+
+    long long patchCost, cheapestPatchCost;
+    int patchedVertex, otherPatchedVertex;
+    for (int nCycles = static_cast<int>(cycleSizes.size()); nCycles > 1; --nCycles) {
+        const int largestCycleId = static_cast<int>(
+                std::max_element(cycleSizes.begin(), cycleSizes.end()) - cycleSizes.begin());
+        cheapestPatchCost = std::numeric_limits<long long>::max();
+        for (int a = 0; a < instanceSize; ++a) {
+            if (cycleIds[a] != largestCycleId) {
+                continue;
+            }
+            const int removedCost = assignmentSolver.getCost(a, successors[a]);
+            for (int b = 0; b < instanceSize; ++b) {
+                if (cycleIds[b] == largestCycleId) {
+                    continue;
+                }
+                const int firstCost = assignmentSolver.getCost(a, successors[b]);
+                const int secondCost = assignmentSolver.getCost(b, successors[a]);
+                if (firstCost == AssignmentSolver::NO_EDGE || secondCost == AssignmentSolver::NO_EDGE) {
+                    continue;
+                }
+                patchCost = static_cast<long long>(firstCost) + secondCost - removedCost
+                            - assignmentSolver.getCost(b, successors[b]);
+                if (patchCost < cheapestPatchCost) {
+                    cheapestPatchCost = patchCost;
+                    patchedVertex = a;
+                    otherPatchedVertex = b;
+                }
+            }
+        }
+        if (cheapestPatchCost == std::numeric_limits<long long>::max()) {
+            // Too sparse to patch
+            return nearestNeighbour(tspInstance, outSolution);
+        }
+
+        const int mergedCycleId = cycleIds[otherPatchedVertex];
+        std::swap(successors[patchedVertex], successors[otherPatchedVertex]);
+        for (auto &cycleId : cycleIds) {
+            if (cycleId == mergedCycleId) {
+                cycleId = largestCycleId;
+            }
+        }
+        cycleSizes[largestCycleId] += cycleSizes[mergedCycleId];
+        cycleSizes[mergedCycleId] = 0;
+    }
+
+    outSolution.emplace_back(0);
+    while (outSolution.size() != instanceSize) {
+        outSolution.emplace_back(successors[outSolution.back()]);
+    }
+    return TSPUtils::calculateTargetFunctionValue(tspInstance, outSolution);
+}
+
+int TSPGreedyAlgorithms::savings(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
+    if (instanceSize <= 2) {
+        // The only tour
+        return createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    int hub = 0;
+    long long hubCostsSum = std::numeric_limits<long long>::max(), costsSum;
+    for (int vertex = 0; vertex < instanceSize; ++vertex) {
+        costsSum = 0;
+        for (int neighbour = 0; neighbour < instanceSize; ++neighbour) {
+            if (neighbour != vertex) {
+                costsSum += static_cast<long long>(tspInstance->getEdgeParameter(vertex, neighbour))
+                            + tspInstance->getEdgeParameter(neighbour, vertex);
+            }
+        }
+        if (costsSum < hubCostsSum) {
+            hubCostsSum = costsSum;
+            hub = vertex;
+        }
+    }
+    return savingsWithHub(tspInstance, hub, outSolution);
+}
+
+int TSPGreedyAlgorithms::savingsWithHub(const IGraph *tspInstance, int hub, std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
+    if (hub < 0 || hub >= instanceSize) {
+        throw std::invalid_argument("Hub " + std::to_string(hub) + " is not a vertex of the instance");
+    }
+    if (instanceSize <= 2) {
+        // The only tour
+        return createNaturalPermutation(tspInstance, outSolution);
+    }
+
+    std::vector<int> costs(static_cast<std::size_t>(instanceSize) * instanceSize);
+    bool isSymmetric = true;
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = 0; j < instanceSize; ++j) {
+            costs[i * instanceSize + j] = tspInstance->getEdgeParameter(i, j);
+        }
+    }
+    for (int i = 0; i < instanceSize && isSymmetric; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (costs[i * instanceSize + j] != costs[j * instanceSize + i]) {
+                isSymmetric = false;
+                break;
+            }
+        }
+    }
+
+    std::vector<TSPSaving> sortedSavings;
+    sortedSavings.reserve(static_cast<std::size_t>(instanceSize - 1) * (instanceSize - 2) / (isSymmetric ? 2 : 1));
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = isSymmetric ? i + 1 : 0; j < instanceSize; ++j) {
+            if (i == hub || j == hub || i == j || costs[i * instanceSize + j] == std::numeric_limits<int>::max()) {
+                continue;
+            }
+            sortedSavings.emplace_back(static_cast<long long>(costs[i * instanceSize + hub])
+                                       + costs[hub * instanceSize + j] - costs[i * instanceSize + j], i, j);
+        }
+    }
+    // Ties by vertices - the same order for any number of threads
+    parallelSort(sortedSavings.begin(), sortedSavings.end(), [](const TSPSaving &lhs, const TSPSaving &rhs) -> bool {
+        if (lhs.saving != rhs.saving) {
+            return lhs.saving > rhs.saving;
+        }
+        return lhs.i != rhs.i ? lhs.i < rhs.i : lhs.j < rhs.j;
+    });
+
+    // Routes between the hub visits; otherEnds is valid for route ends only. On symmetric instances links hold
+    // both neighbours of a vertex ([2v], [2v + 1]), otherwise [2v] - successor and [2v + 1] - predecessor.
+    std::vector<int> links(2 * instanceSize, -1), otherEnds(instanceSize);
+    std::iota(otherEnds.begin(), otherEnds.end(), 0);
+    int nLinks = 0;
+    for (const TSPSaving &saving : sortedSavings) {
+        if (nLinks == instanceSize - 2) {
+            break;
+        }
+        const int i = saving.i, j = saving.j;
+        if (otherEnds[i] == j) {
+            continue;
+        }
+        if (isSymmetric) {
+            if (links[2 * i + 1] != -1 || links[2 * j + 1] != -1) {
+                continue;
+            }
+            links[2 * i + (links[2 * i] == -1 ? 0 : 1)] = j;
+            links[2 * j + (links[2 * j] == -1 ? 0 : 1)] = i;
+        } else {
+            if (links[2 * i] != -1 || links[2 * j + 1] != -1) {
+                continue;
+            }
+            links[2 * i] = j;
+            links[2 * j + 1] = i;
+        }
+        const int iOtherEnd = otherEnds[i], jOtherEnd = otherEnds[j];
+        otherEnds[iOtherEnd] = jOtherEnd;
+        otherEnds[jOtherEnd] = iOtherEnd;
+        ++nLinks;
+    }
+
+    // Hub, then routes from their starts (more than one only if some edges are missing)
+    std::vector<bool> isVertexVisited(instanceSize, false);
+    outSolution.emplace_back(hub);
+    isVertexVisited[hub] = true;
+    for (int start = 0; start < instanceSize; ++start) {
+        if (isVertexVisited[start] || links[2 * start + 1] != -1) {
+            continue;
+        }
+        for (int vertex = start, previous = -1, next; vertex != -1; previous = vertex, vertex = next) {
+            outSolution.emplace_back(vertex);
+            isVertexVisited[vertex] = true;
+            if (isSymmetric) {
+                next = links[2 * vertex] != previous ? links[2 * vertex] : links[2 * vertex + 1];
+            } else {
+                next = links[2 * vertex];
+            }
+        }
+    }
+    return TSPUtils::calculateTargetFunctionValue(tspInstance, outSolution);
+}
+
 int TSPGreedyAlgorithms::createNaturalPermutation(const IGraph *tspInstance, std::vector<int> &outSolution) {
     for (int i = 0; i != tspInstance->getVertexCount(); ++i) {
         outSolution.emplace_back(i);
@@ -2,6 +2,7 @@
 #define PEA_P1_TSPGREEDYALGORITHMS_H
 
 #include "../utilities/TSPUtils.h"
+#include "helper_structures/TSPHelperStructures.h"
 
 // outSolution is a permutation of vertices (not cycle) - MUST be provided (as an argument) empty
 class TSPGreedyAlgorithms {
@@ -11,6 +12,21 @@ public:
 
     static int greedy(const IGraph *tspInstance, std::vector<int> &outSolution);
 
+    // Greedy on edges (i != j) already sorted by ascending cost (stable - ties keep row-major order)
+    static int greedyOnSortedEdges(const IGraph *tspInstance, const std::vector<TSPEdge> &sortedEdges,
+                                   std::vector<int> &outSolution);
+
+    // Assignment problem relaxation, then its cycles are patched into one: the largest cycle is merged with the other
+    // cycle whose cheapest exchange of edges (a, s(a)), (b, s(b)) -> (a, s(b)), (b, s(a)) adds the least
+    static int karpPatching(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Clarke-Wright savings from the most central vertex (lowest sum of its edge costs) as the hub
+    static int savings(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    // Routes hub -> v -> hub are joined by descending savings c(i, hub) + c(hub, j) - c(i, j) while i and j are ends of
+    // different routes; edges are undirected on symmetric instances, i must be a route end and j a start otherwise
+    static int savingsWithHub(const IGraph *tspInstance, int hub, std::vector<int> &outSolution);
+
     static int createNaturalPermutation(const IGraph *tspInstance, std::vector<int> &outSolution);
 
     static int createRandomPermutation(const IGraph *tspInstance, std::vector<int> &outSolution);
@@ -1,10 +1,12 @@
 #include "TSPLocalSearchAlgorithms.h"
+#include "InstanceContext.h"
 
 //region Simulated annealing
 
 int TSPLocalSearchAlgorithms::simulatedAnnealing(const IGraph *tspInstance,
                                                  const LocalSearchParameters &parameters,
                                                  std::vector<int> &outSolution) {
+    TRACE_SCOPE("simulatedAnnealing");
     if (parameters.initialTemperature <= 0 || parameters.coolingSchemeParameter <= 0
         || parameters.epochIterationsNumber <= 0 || parameters.iterationsNumber <= 0) {
         throw std::invalid_argument("Simulated annealing started with invalid parameters");
@@ -22,7 +24,9 @@ int TSPLocalSearchAlgorithms::simulatedAnnealing(const IGraph *tspInstance,
     if (parameters.initialSolutionFunction != TSPGreedyAlgorithms::createNaturalPermutation
         && parameters.initialSolutionFunction != TSPGreedyAlgorithms::createRandomPermutation
         && parameters.initialSolutionFunction != TSPGreedyAlgorithms::greedy
-        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::nearestNeighbour) {
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::nearestNeighbour
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::karpPatching
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::savings) {
         throw std::invalid_argument("Tabu search started with invalid initial solution designation function");
     }
     if (parameters.coolingSchemeFunction == TSPLocalSearchAlgorithms::geometricCoolingScheme
@@ -36,22 +40,26 @@ int TSPLocalSearchAlgorithms::simulatedAnnealing(const IGraph *tspInstance,
         return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
     }
 
-    fCoolingScheme getNextTemperature = parameters.coolingSchemeFunction;
-    TSPGreedyAlgorithms::fTSPAlgorithm designateInitialSolution = parameters.initialSolutionFunction;
-    fNeighbourhood getNextNeighbour = parameters.nextNeighbourFunction;
+    return dispatchNeighbourhood(parameters.nextNeighbourFunction, [&](auto neighbourhoodPolicy) {
+        return dispatchCoolingScheme(parameters.coolingSchemeFunction, [&](auto coolingPolicy) {
+            return runSimulatedAnnealing<decltype(neighbourhoodPolicy), decltype(coolingPolicy)>(
+                    tspInstance, parameters, outSolution);
+        });
+    });
+}
 
-    fNeighbourhoodDiff calculateNextSolutionTargetFunctionValue = nullptr;
-    if (getNextNeighbour == swapNeighbourhood) {
-        calculateNextSolutionTargetFunctionValue = swapNeighbourhoodTFValue;
-    } else if (getNextNeighbour == insertNeighbourhood) {
-        calculateNextSolutionTargetFunctionValue = insertNeighbourhoodTFValue;
-    } else {
-        calculateNextSolutionTargetFunctionValue = invertNeighbourhoodTFValue;
-    }
+template<class NeighbourhoodPolicy, class CoolingPolicy>
+int TSPLocalSearchAlgorithms::runSimulatedAnnealing(const IGraph *tspInstance, const LocalSearchParameters &parameters,
+                                                    std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
+    TSPGreedyAlgorithms::fTSPAlgorithm designateInitialSolution = parameters.initialSolutionFunction;
 
     std::vector<int> currentSolution, nextSolution, bestSolution;
     int currentSolutionValue, nextSolutionValue, bestSolutionValue;
-    currentSolutionValue = designateInitialSolution(tspInstance, currentSolution);
+    currentSolutionValue = parameters.instanceContext != nullptr
+                           ? parameters.instanceContext->designateTour(tspInstance, designateInitialSolution,
+                                                                       currentSolution)
+                           : designateInitialSolution(tspInstance, currentSolution);
 
     bestSolution = currentSolution;
     bestSolutionValue = currentSolutionValue;
@@ -59,6 +67,7 @@ int TSPLocalSearchAlgorithms::simulatedAnnealing(const IGraph *tspInstance,
     int i, j;
     double currentTemperature = parameters.initialTemperature;
     for (int currentIterationIdx = 0; currentIterationIdx < parameters.iterationsNumber; ++currentIterationIdx) {
+        TRACE_SCOPE("simulatedAnnealing: epoch");
         for (int currentEpochIterationIdx = 0;
              currentEpochIterationIdx < parameters.epochIterationsNumber; ++currentEpochIterationIdx) {
             i = Random::getInt(0, instanceSize - 1);
@@ -81,10 +90,9 @@ int TSPLocalSearchAlgorithms::simulatedAnnealing(const IGraph *tspInstance,
                 }
             }
 
-            nextSolution = getNextNeighbour(i, j, currentSolution);
-            nextSolutionValue = calculateNextSolutionTargetFunctionValue(tspInstance, i, j, currentSolution,
-                                                                         nextSolution,
-                                                                         currentSolutionValue);
+            nextSolution = NeighbourhoodPolicy::getNeighbour(i, j, currentSolution);
+            nextSolutionValue = NeighbourhoodPolicy::getNeighbourValue(tspInstance, i, j, currentSolution,
+                                                                       nextSolution, currentSolutionValue);
             // Core of the algorithm
             if (nextSolutionValue < currentSolutionValue) {
                 currentSolution = nextSolution;
@@ -105,8 +113,9 @@ int TSPLocalSearchAlgorithms::simulatedAnnealing(const IGraph *tspInstance,
                 bestSolution = nextSolution;
             }
         }
-        currentTemperature = getNextTemperature(currentTemperature, parameters.initialTemperature,
-                                                parameters.coolingSchemeParameter, currentIterationIdx);
+        currentTemperature = CoolingPolicy::getNextTemperature(currentTemperature, parameters.initialTemperature,
+                                                               parameters.coolingSchemeParameter,
+                                                               currentIterationIdx);
     }
     outSolution = bestSolution;
     return bestSolutionValue;
@@ -358,6 +367,64 @@ double TSPLocalSearchAlgorithms::sigmoidFunction(double x) {
     return 1.0 / (1.0 + exp(-x));
 }
 
+template<class Solve>
+int TSPLocalSearchAlgorithms::dispatchNeighbourhood(fNeighbourhood neighbourhood, Solve solve) {
+    if (neighbourhood == swapNeighbourhood) {
+        return solve(SwapPolicy());
+    } else if (neighbourhood == insertNeighbourhood) {
+        return solve(InsertPolicy());
+    } else if (neighbourhood == invertNeighbourhood) {
+        return solve(InvertPolicy());
+    }
+    throw std::invalid_argument("Unknown neighbour designation function");
+}
+
+template<class Solve>
+int TSPLocalSearchAlgorithms::dispatchCoolingScheme(fCoolingScheme coolingScheme, Solve solve) {
+    if (coolingScheme == linearCoolingScheme) {
+        return solve(LinearCoolingPolicy());
+    } else if (coolingScheme == geometricCoolingScheme) {
+        return solve(GeometricCoolingPolicy());
+    } else if (coolingScheme == logarithmicCoolingScheme) {
+        return solve(LogarithmicCoolingPolicy());
+    }
+    throw std::invalid_argument("Unknown cooling scheme function");
+}
+
+//endregion
+
+//region Local descent
+
+int TSPLocalSearchAlgorithms::localDescent(const IGraph *tspInstance, std::vector<int> &solution, int solutionValue) {
+    TRACE_SCOPE("localDescent");
+    const int solutionSize = static_cast<int>(solution.size());
+    std::vector<int> nextSolution;
+    int nextSolutionValue;
+    bool isImproved = true;
+    while (isImproved) {
+        isImproved = false;
+        for (int i = 0; i < solutionSize; ++i) {
+            for (int j = 0; j < solutionSize; ++j) {
+                if (i == j) {
+                    continue;
+                }
+                nextSolution = insertNeighbourhood(i, j, solution);
+                nextSolutionValue = TSPUtils::calculateTargetFunctionValue(tspInstance, nextSolution);
+                if (nextSolutionValue >= solutionValue && i < j) {
+                    nextSolution = invertNeighbourhood(i, j, solution);
+                    nextSolutionValue = TSPUtils::calculateTargetFunctionValue(tspInstance, nextSolution);
+                }
+                if (nextSolutionValue < solutionValue) {
+                    solution.swap(nextSolution);
+                    solutionValue = nextSolutionValue;
+                    isImproved = true;
+                }
+            }
+        }
+    }
+    return solutionValue;
+}
+
 //endregion
 
 int TSPLocalSearchAlgorithms::tabuSearchList(const IGraph *tspInstance, const LocalSearchParameters &parameters,
@@ -374,7 +441,9 @@ int TSPLocalSearchAlgorithms::tabuSearchList(const IGraph *tspInstance, const Lo
     if (parameters.initialSolutionFunction != TSPGreedyAlgorithms::createNaturalPermutation
         && parameters.initialSolutionFunction != TSPGreedyAlgorithms::createRandomPermutation
         && parameters.initialSolutionFunction != TSPGreedyAlgorithms::greedy
-        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::nearestNeighbour) {
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::nearestNeighbour
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::karpPatching
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::savings) {
         throw std::invalid_argument("Tabu search started with invalid initial solution designation function");
     }
 
@@ -383,78 +452,52 @@ int TSPLocalSearchAlgorithms::tabuSearchList(const IGraph *tspInstance, const Lo
         return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
     }
 
+    return dispatchNeighbourhood(parameters.nextNeighbourFunction, [&](auto neighbourhoodPolicy) {
+        return runTabuSearchList<decltype(neighbourhoodPolicy)>(tspInstance, parameters, outSolution);
+    });
+}
+
+template<class NeighbourhoodPolicy>
+int TSPLocalSearchAlgorithms::runTabuSearchList(const IGraph *tspInstance, const LocalSearchParameters &parameters,
+                                                std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
     const int cadenzaLength = std::max(static_cast<int>(instanceSize * parameters.cadenzaLengthParameter), 1);
 
-    std::vector<int> currentSolution, nextSolution, neighbourSolution, bestSolution;
-    int currentSolutionValue, nextSolutionValue, neighbourSolutionValue, bestSolutionValue;
-    currentSolutionValue = parameters.initialSolutionFunction(tspInstance, currentSolution);
+    std::vector<int> currentSolution, bestSolution;
+    int currentSolutionValue, nextSolutionValue, bestSolutionValue;
+    currentSolutionValue = parameters.instanceContext != nullptr
+                           ? parameters.instanceContext->designateTour(tspInstance,
+                                                                       parameters.initialSolutionFunction,
+                                                                       currentSolution)
+                           : parameters.initialSolutionFunction(tspInstance, currentSolution);
     bestSolution = currentSolution;
     bestSolutionValue = currentSolutionValue;
 
-    TSPLocalSearchAlgorithms::fNeighbourhoodDiff nextSolutionTFValue;
-    if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::swapNeighbourhood) {
-        nextSolutionTFValue = TSPLocalSearchAlgorithms::swapNeighbourhoodTFValue;
-    } else if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
-        nextSolutionTFValue = TSPLocalSearchAlgorithms::insertNeighbourhoodTFValue;
-    } else {
-        nextSolutionTFValue = TSPLocalSearchAlgorithms::invertNeighbourhoodTFValue;
-    }
+    // Values of all moves, updated after each move instead of scanning the whole neighbourhood
+    TabuMoveTable moveTable(tspInstance, NeighbourhoodPolicy::MOVE_TYPE);
+    moveTable.reset(currentSolution, currentSolutionValue);
 
     // ((i, j), cadenza)
     std::list<std::pair<std::pair<int, int>, int>> tabuList;
-    std::list<std::vector<int>> cachedSolutions;
 
     int iterationsWithoutImprovement = 0;
-    bool neighbourInTabu;
+    bool isMoveFound;
     std::pair<std::pair<int, int>, int> tabuMove;
     for (int currentIteration = 0; currentIteration < parameters.iterationsNumber; ++currentIteration) {
-        nextSolution.clear();
-        nextSolutionValue = std::numeric_limits<int>::max();
-        for (int i = 0; i < instanceSize; ++i) {
-            int j;
-            if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
-                j = 0;
-            } else {
-                // swapNeighbourhood or invertNeighbourhood
-                j = i + 1;
-            }
-            for (; j < instanceSize; ++j) {
-                if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
-                    if (i == j || i == j + 1) {
-                        continue;
+        isMoveFound = moveTable.findBestMove(
+                [&tabuList, bestSolutionValue](int i, int j, int neighbourSolutionValue) {
+                    // Aspiration criterium
+                    if (neighbourSolutionValue < bestSolutionValue) {
+                        return true;
                     }
-                }
-                neighbourInTabu = false;
-                for (const auto &move : tabuList) {
-                    if (std::pair<int, int>(i, j) == move.first) {
-                        neighbourInTabu = true;
-                        break;
+                    for (const auto &move : tabuList) {
+                        if (std::pair<int, int>(i, j) == move.first) {
+                            return false;
+                        }
                     }
-                }
-                neighbourSolution = parameters.nextNeighbourFunction(i, j, currentSolution);
-                neighbourSolutionValue = nextSolutionTFValue(tspInstance, i, j, currentSolution, neighbourSolution,
-                                                             currentSolutionValue);
-                // Aspiration criterium
-                if (neighbourInTabu && neighbourSolutionValue >= bestSolutionValue) {
-                    continue;
-                }
-
-                // Patterns
-                for (const auto &cachedSolution : cachedSolutions) {
-                    if (TSPUtils::areSolutionsEqual(neighbourSolution, cachedSolution)) {
-                        continue;
-                    }
-                }
-
-                if (nextSolution.empty() || neighbourSolutionValue < nextSolutionValue) {
-                    nextSolution = neighbourSolution;
-                    nextSolutionValue = neighbourSolutionValue;
-                    tabuMove.first.first = i;
-                    tabuMove.first.second = j;
-                    tabuMove.second = cadenzaLength;
-                }
-            }
-        }
+                    return true;
+                }, tabuMove.first.first, tabuMove.first.second, nextSolutionValue);
+        tabuMove.second = cadenzaLength;
 
         for (auto it = tabuList.begin(); it != tabuList.end();) {
             --it->second;
@@ -465,33 +508,25 @@ int TSPLocalSearchAlgorithms::tabuSearchList(const IGraph *tspInstance, const Lo
             }
         }
 
-        if (!nextSolution.empty()) {
+        if (isMoveFound) {
+            // Perform move
+            moveTable.applyMove(tabuMove.first.first, tabuMove.first.second);
+            currentSolutionValue = nextSolutionValue;
+
             if (nextSolutionValue < bestSolutionValue) {
-                bestSolution = nextSolution;
+                bestSolution = moveTable.getSolution();
                 bestSolutionValue = nextSolutionValue;
             } else {
                 ++iterationsWithoutImprovement;
             }
 
             // Tabu move insertion
-            if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
+            if constexpr (NeighbourhoodPolicy::MOVE_TYPE == TabuMoveTable::MoveType::Insert) {
                 std::swap(tabuMove.first.first, tabuMove.first.second);
             }
             if (tabuList.size() < parameters.tabuListSize) {
                 tabuList.emplace_back(tabuMove);
             }
-
-            // Perform move
-            currentSolution = nextSolution;
-            currentSolutionValue = nextSolutionValue;
-
-            // Update patterns cache
-            if (cachedSolutions.size() >= parameters.patternsNumberToCache) {
-                cachedSolutions.erase(cachedSolutions.begin());
-            }
-            if (cachedSolutions.size() < parameters.patternsNumberToCache) {
-                cachedSolutions.emplace_back(currentSolution);
-            }
         }
         // Critical event
         if (iterationsWithoutImprovement == parameters.iterationsWithoutImprovementToRestart) {
@@ -501,6 +536,7 @@ int TSPLocalSearchAlgorithms::tabuSearchList(const IGraph *tspInstance, const Lo
                 bestSolution = currentSolution;
                 bestSolutionValue = currentSolutionValue;
             }
+            moveTable.reset(currentSolution, currentSolutionValue);
             iterationsWithoutImprovement = 0;
         }
     }
@@ -522,7 +558,9 @@ int TSPLocalSearchAlgorithms::tabuSearchMatrix(const IGraph *tspInstance, const
     if (parameters.initialSolutionFunction != TSPGreedyAlgorithms::createNaturalPermutation
         && parameters.initialSolutionFunction != TSPGreedyAlgorithms::createRandomPermutation
         && parameters.initialSolutionFunction != TSPGreedyAlgorithms::greedy
-        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::nearestNeighbour) {
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::nearestNeighbour
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::karpPatching
+        && parameters.initialSolutionFunction != TSPGreedyAlgorithms::savings) {
         throw std::invalid_argument("Tabu search started with invalid initial solution designation function");
     }
 
@@ -531,116 +569,79 @@ int TSPLocalSearchAlgorithms::tabuSearchMatrix(const IGraph *tspInstance, const
         return TSPGreedyAlgorithms::createNaturalPermutation(tspInstance, outSolution);
     }
 
+    return dispatchNeighbourhood(parameters.nextNeighbourFunction, [&](auto neighbourhoodPolicy) {
+        return runTabuSearchMatrix<decltype(neighbourhoodPolicy)>(tspInstance, parameters, outSolution);
+    });
+}
+
+template<class NeighbourhoodPolicy>
+int TSPLocalSearchAlgorithms::runTabuSearchMatrix(const IGraph *tspInstance, const LocalSearchParameters &parameters,
+                                                  std::vector<int> &outSolution) {
+    const int instanceSize = tspInstance->getVertexCount();
     const int cadenzaLength = std::max(static_cast<int>(instanceSize * parameters.cadenzaLengthParameter), 1);
 
-    std::vector<int> currentSolution, nextSolution, neighbourSolution, bestSolution;
-    int currentSolutionValue, nextSolutionValue, neighbourSolutionValue, bestSolutionValue;
-    currentSolutionValue = parameters.initialSolutionFunction(tspInstance, currentSolution);
+    std::vector<int> currentSolution, bestSolution;
+    int currentSolutionValue, nextSolutionValue, bestSolutionValue;
+    currentSolutionValue = parameters.instanceContext != nullptr
+                           ? parameters.instanceContext->designateTour(tspInstance,
+                                                                       parameters.initialSolutionFunction,
+                                                                       currentSolution)
+                           : parameters.initialSolutionFunction(tspInstance, currentSolution);
     bestSolution = currentSolution;
     bestSolutionValue = currentSolutionValue;
 
-    TSPLocalSearchAlgorithms::fNeighbourhoodDiff nextSolutionTFValue;
-    if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::swapNeighbourhood) {
-        nextSolutionTFValue = TSPLocalSearchAlgorithms::swapNeighbourhoodTFValue;
-    } else if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
-        nextSolutionTFValue = TSPLocalSearchAlgorithms::insertNeighbourhoodTFValue;
-    } else {
-        nextSolutionTFValue = TSPLocalSearchAlgorithms::invertNeighbourhoodTFValue;
-    }
+    // Values of all moves, updated after each move instead of scanning the whole neighbourhood
+    TabuMoveTable moveTable(tspInstance, NeighbourhoodPolicy::MOVE_TYPE);
+    moveTable.reset(currentSolution, currentSolutionValue);
 
-    // [i][j] = cadenza
-    std::vector<std::vector<int>> tabuMatrix(instanceSize, std::vector<int>(instanceSize, 0));
-    std::list<std::vector<int>> cachedSolutions;
+    // [i][j] - last iteration in which move (i, j) is tabu, -1 if it never was
+    std::vector<std::vector<int>> tabuMatrix(instanceSize, std::vector<int>(instanceSize, -1));
+    // ((i, j), last tabu iteration) in the order of insertion - the order of expiry. Replaces decrementing the
+    // cadenzas of the whole matrix in each iteration.
+    std::list<std::pair<std::pair<int, int>, int>> tabuExpirations;
 
     int iterationsWithoutImprovement = 0;
-    bool neighbourInTabu;
+    bool isMoveFound;
     std::pair<std::pair<int, int>, int> tabuMove;
     int movesInTabuMatrix = 0;
     for (int currentIteration = 0; currentIteration < parameters.iterationsNumber; ++currentIteration) {
-        nextSolution.clear();
-        nextSolutionValue = std::numeric_limits<int>::max();
-        for (int i = 0; i < instanceSize; ++i) {
-            int j;
-            if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
-                j = 0;
-            } else {
-                // swapNeighbourhood or invertNeighbourhood
-                j = i + 1;
-            }
-            for (; j < instanceSize; ++j) {
-                if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
-                    if (i == j || i == j + 1) {
-                        continue;
-                    }
-                }
-                neighbourInTabu = false;
-                if (tabuMatrix[i][j] != 0) {
-                    neighbourInTabu = true;
-                }
-                neighbourSolution = parameters.nextNeighbourFunction(i, j, currentSolution);
-                neighbourSolutionValue = nextSolutionTFValue(tspInstance, i, j, currentSolution, neighbourSolution,
-                                                             currentSolutionValue);
-                // Aspiration criterium
-                if (neighbourInTabu && neighbourSolutionValue >= bestSolutionValue) {
-                    continue;
-                }
-
-                // Patterns
-                for (const auto &cachedSolution : cachedSolutions) {
-                    if (TSPUtils::areSolutionsEqual(neighbourSolution, cachedSolution)) {
-                        continue;
-                    }
-                }
-
-                if (nextSolution.empty() || neighbourSolutionValue < nextSolutionValue) {
-                    nextSolution = neighbourSolution;
-                    nextSolutionValue = neighbourSolutionValue;
-                    tabuMove.first.first = i;
-                    tabuMove.first.second = j;
-                    tabuMove.second = cadenzaLength;
-                }
+        isMoveFound = moveTable.findBestMove(
+                [&tabuMatrix, bestSolutionValue, currentIteration](int i, int j, int neighbourSolutionValue) {
+                    // Aspiration criterium
+                    return tabuMatrix[i][j] < currentIteration || neighbourSolutionValue < bestSolutionValue;
+                }, tabuMove.first.first, tabuMove.first.second, nextSolutionValue);
+        tabuMove.second = cadenzaLength;
+
+        while (!tabuExpirations.empty() && tabuExpirations.front().second == currentIteration) {
+            const std::pair<int, int> &expiredMove = tabuExpirations.front().first;
+            // Not inserted again since
+            if (tabuMatrix[expiredMove.first][expiredMove.second] == currentIteration) {
+                --movesInTabuMatrix;
             }
+            tabuExpirations.pop_front();
         }
 
-        for (int k = 0; k < instanceSize; ++k) {
-            for (int l = 0; l < instanceSize; ++l) {
-                if (tabuMatrix[k][l] == 1) {
-                    --movesInTabuMatrix;
-                }
-                if (tabuMatrix[k][l] > 0) {
-                    --tabuMatrix[k][l];
-                }
-            }
-        }
+        if (isMoveFound) {
+            // Perform move
+            moveTable.applyMove(tabuMove.first.first, tabuMove.first.second);
+            currentSolutionValue = nextSolutionValue;
 
-        if (!nextSolution.empty()) {
             if (nextSolutionValue < bestSolutionValue) {
-                bestSolution = nextSolution;
+                bestSolution = moveTable.getSolution();
                 bestSolutionValue = nextSolutionValue;
             } else {
                 ++iterationsWithoutImprovement;
             }
 
             // Tabu move insertion
-            if (parameters.nextNeighbourFunction == TSPLocalSearchAlgorithms::insertNeighbourhood) {
+            if constexpr (NeighbourhoodPolicy::MOVE_TYPE == TabuMoveTable::MoveType::Insert) {
                 std::swap(tabuMove.first.first, tabuMove.first.second);
             }
             if (movesInTabuMatrix < parameters.tabuListSize) {
-                tabuMatrix[tabuMove.first.first][tabuMove.first.second] = tabuMove.second;
+                tabuMatrix[tabuMove.first.first][tabuMove.first.second] = currentIteration + tabuMove.second;
+                tabuExpirations.emplace_back(tabuMove.first, currentIteration + tabuMove.second);
                 ++movesInTabuMatrix;
             }
-
-            // Perform move
-            currentSolution = nextSolution;
-            currentSolutionValue = nextSolutionValue;
-
-            // Update patterns cache
-            if (cachedSolutions.size() >= parameters.patternsNumberToCache) {
-                cachedSolutions.erase(cachedSolutions.begin());
-            }
-            if (cachedSolutions.size() < parameters.patternsNumberToCache) {
-                cachedSolutions.emplace_back(currentSolution);
-            }
         }
         // Critical event
         if (iterationsWithoutImprovement == parameters.iterationsWithoutImprovementToRestart) {
@@ -650,11 +651,10 @@ int TSPLocalSearchAlgorithms::tabuSearchMatrix(const IGraph *tspInstance, const
                 bestSolution = currentSolution;
                 bestSolutionValue = currentSolutionValue;
             }
+            moveTable.reset(currentSolution, currentSolutionValue);
             iterationsWithoutImprovement = 0;
         }
     }
     outSolution = bestSolution;
     return bestSolutionValue;
 }
-
-
@@ -11,7 +11,9 @@
 #include <string>
 
 #include "TSPGreedyAlgorithms.h"
+#include "TabuMoveTable.h"
 #include "../utilities/Random.h"
+#include "../utilities/Trace.h"
 #include "../structures/graphs/IGraph.h"
 
 class LocalSearchParameters;
@@ -30,6 +32,10 @@ public:
 
     using fLocalSearchAlgorithm = decltype(&simulatedAnnealing);
 
+    // Deterministic first-improvement descent over insert and invert moves - until no move improves the solution.
+    // Returns the value of the improved solution.
+    static int localDescent(const IGraph *tspInstance, std::vector<int> &solution, int solutionValue);
+
     // initialTemperature > 0, parameter > 0
     [[nodiscard]] static double
     linearCoolingScheme(double currentTemperature, double initialTemperature,
@@ -73,6 +79,92 @@ public:
     using fNeighbourhoodDiff = decltype(&swapNeighbourhoodTFValue);
 
     friend class LocalSearchParameters;
+
+private:
+    // Compile-time counterparts of the neighbourhood and cooling scheme functions. Solvers are instantiated for them
+    // by one branch at entry (dispatchNeighbourhood, dispatchCoolingScheme) - their loops call the functions directly
+    // instead of through fNeighbourhood, fNeighbourhoodDiff and fCoolingScheme pointers.
+    struct SwapPolicy {
+        static constexpr TabuMoveTable::MoveType MOVE_TYPE = TabuMoveTable::MoveType::Swap;
+
+        static std::vector<int> getNeighbour(int i, int j, const std::vector<int> &currentSolution) {
+            return swapNeighbourhood(i, j, currentSolution);
+        }
+
+        static int getNeighbourValue(const IGraph *tspInstance, int i, int j, const std::vector<int> &currentSolution,
+                                     const std::vector<int> &nextSolution, int currentSolutionValue) {
+            return swapNeighbourhoodTFValue(tspInstance, i, j, currentSolution, nextSolution, currentSolutionValue);
+        }
+    };
+
+    struct InsertPolicy {
+        static constexpr TabuMoveTable::MoveType MOVE_TYPE = TabuMoveTable::MoveType::Insert;
+
+        static std::vector<int> getNeighbour(int i, int j, const std::vector<int> &currentSolution) {
+            return insertNeighbourhood(i, j, currentSolution);
+        }
+
+        static int getNeighbourValue(const IGraph *tspInstance, int i, int j, const std::vector<int> &currentSolution,
+                                     const std::vector<int> &nextSolution, int currentSolutionValue) {
+            return insertNeighbourhoodTFValue(tspInstance, i, j, currentSolution, nextSolution, currentSolutionValue);
+        }
+    };
+
+    struct InvertPolicy {
+        static constexpr TabuMoveTable::MoveType MOVE_TYPE = TabuMoveTable::MoveType::Invert;
+
+        static std::vector<int> getNeighbour(int i, int j, const std::vector<int> &currentSolution) {
+            return invertNeighbourhood(i, j, currentSolution);
+        }
+
+        static int getNeighbourValue(const IGraph *tspInstance, int i, int j, const std::vector<int> &currentSolution,
+                                     const std::vector<int> &nextSolution, int currentSolutionValue) {
+            return invertNeighbourhoodTFValue(tspInstance, i, j, currentSolution, nextSolution, currentSolutionValue);
+        }
+    };
+
+    struct LinearCoolingPolicy {
+        static double getNextTemperature(double currentTemperature, double initialTemperature, double parameter,
+                                         int currentIterationOrTime) {
+            return linearCoolingScheme(currentTemperature, initialTemperature, parameter, currentIterationOrTime);
+        }
+    };
+
+    struct GeometricCoolingPolicy {
+        static double getNextTemperature(double currentTemperature, double initialTemperature, double parameter,
+                                         int currentIterationOrTime) {
+            return geometricCoolingScheme(currentTemperature, initialTemperature, parameter, currentIterationOrTime);
+        }
+    };
+
+    struct LogarithmicCoolingPolicy {
+        static double getNextTemperature(double currentTemperature, double initialTemperature, double parameter,
+                                         int currentIterationOrTime) {
+            return logarithmicCoolingScheme(currentTemperature, initialTemperature, parameter,
+                                            currentIterationOrTime);
+        }
+    };
+
+    // Returns solve(policy) for the policy of neighbourhood. Throws std::invalid_argument for other functions.
+    template<class Solve>
+    static int dispatchNeighbourhood(fNeighbourhood neighbourhood, Solve solve);
+
+    // Returns solve(policy) for the policy of coolingScheme. Throws std::invalid_argument for other functions.
+    template<class Solve>
+    static int dispatchCoolingScheme(fCoolingScheme coolingScheme, Solve solve);
+
+    // Bodies of the solvers above, after validation of parameters
+    template<class NeighbourhoodPolicy, class CoolingPolicy>
+    static int runSimulatedAnnealing(const IGraph *tspInstance, const LocalSearchParameters &parameters,
+                                     std::vector<int> &outSolution);
+
+    template<class NeighbourhoodPolicy>
+    static int runTabuSearchList(const IGraph *tspInstance, const LocalSearchParameters &parameters,
+                                 std::vector<int> &outSolution);
+
+    template<class NeighbourhoodPolicy>
+    static int runTabuSearchMatrix(const IGraph *tspInstance, const LocalSearchParameters &parameters,
+                                   std::vector<int> &outSolution);
 };
 
 #include "helper_structures/LocalSearchParameters.h"
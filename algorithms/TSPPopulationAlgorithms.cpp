@@ -1,11 +1,13 @@
 #include "TSPPopulationAlgorithms.h"
 #include "../utilities/TSPUtils.h"
 #include "../utilities/Random.h"
+#include "../utilities/Trace.h"
 #include "helper_structures/LocalSearchParameters.h"
 
 
 int TSPPopulationAlgorithms::geneticAlgorithm(const IGraph *tspInstance, const GeneticAlgorithmParameters &parameters,
                                               std::vector<int> &outSolution) {
+    TRACE_SCOPE("geneticAlgorithm");
 
     const int INSTANCE_SIZE = tspInstance->getVertexCount();
 
@@ -34,7 +36,8 @@ int TSPPopulationAlgorithms::geneticAlgorithm(const IGraph *tspInstance, const G
         throw std::invalid_argument("Algorithm supplied with invalid crossover core function");
     }
     if (parameters.createPopulationFunction != TSPPopulationAlgorithms::createRandomPopulation
-        && parameters.createPopulationFunction != TSPPopulationAlgorithms::createPopulationWithSA) {
+        && parameters.createPopulationFunction != TSPPopulationAlgorithms::createPopulationWithSA
+        && parameters.createPopulationFunction != TSPPopulationAlgorithms::createPopulationWithSavings) {
         throw std::invalid_argument("Algorithm supplied with invalid population creation function");
     }
 
@@ -49,9 +52,13 @@ int TSPPopulationAlgorithms::geneticAlgorithm(const IGraph *tspInstance, const G
     std::vector<Specimen> population, selected, elites;
     Specimen bestSpecimen;
 
-    createPopulation(tspInstance, parameters.populationSize, bestSpecimen, population);
+    {
+        TRACE_SCOPE("geneticAlgorithm: initial population");
+        createPopulation(tspInstance, parameters.populationSize, bestSpecimen, population);
+    }
 
     for (int generation = 0; generation < parameters.nGenerations; ++generation) {
+        TRACE_SCOPE("geneticAlgorithm: generation");
         if (performSelection == TSPPopulationAlgorithms::tournamentSelection) {
             performSelection(population, selected, nTournamentParticipants);
         } else {
@@ -141,6 +148,34 @@ TSPPopulationAlgorithms::createPopulationWithSA(const IGraph *tspInstance, int p
     outBestSpecimen = outPopulation[bestSpecimenIdx];
 }
 
+void
+TSPPopulationAlgorithms::createPopulationWithSavings(const IGraph *tspInstance, int populationSize,
+                                                     Specimen &outBestSpecimen,
+                                                     std::vector<Specimen> &outPopulation) {
+    Specimen currentSpecimen;
+    std::vector<int> hubs;
+    TSPGreedyAlgorithms::createRandomPermutation(tspInstance, hubs);
+    int bestSpecimenIdx = -1;
+    for (int specimenIdx = 0; specimenIdx < populationSize; ++specimenIdx) {
+        currentSpecimen.permutation.clear();
+        if (specimenIdx == 0) {
+            currentSpecimen.targetFunctionValue = TSPGreedyAlgorithms::savings(tspInstance,
+                                                                               currentSpecimen.permutation);
+        } else if (specimenIdx < static_cast<int>(hubs.size())) {
+            currentSpecimen.targetFunctionValue = TSPGreedyAlgorithms::savingsWithHub(tspInstance, hubs[specimenIdx],
+                                                                                      currentSpecimen.permutation);
+        } else {
+            currentSpecimen.targetFunctionValue = TSPGreedyAlgorithms::createRandomPermutation(
+                    tspInstance, currentSpecimen.permutation);
+        }
+        if (bestSpecimenIdx == -1 || currentSpecimen > outPopulation[bestSpecimenIdx]) {
+            bestSpecimenIdx = specimenIdx;
+        }
+        outPopulation.emplace_back(currentSpecimen.permutation, currentSpecimen.targetFunctionValue);
+    }
+    outBestSpecimen = outPopulation[bestSpecimenIdx];
+}
+
 void TSPPopulationAlgorithms::rouletteSelection(const std::vector<Specimen> &population,
                                                 std::vector<Specimen> &outSelected, int parameter) {
     double fitnessSumOverPopulation = 0;
@@ -30,6 +30,10 @@ public:
     static void createPopulationWithSA(const IGraph *tspInstance, int populationSize, Specimen &outBestSpecimen,
                                        std::vector<Specimen> &outPopulation);
 
+    // Savings tours from the central hub, then from hubs in random order; random permutations once hubs run out
+    static void createPopulationWithSavings(const IGraph *tspInstance, int populationSize, Specimen &outBestSpecimen,
+                                            std::vector<Specimen> &outPopulation);
+
     static void
     rouletteSelection(const std::vector<Specimen> &population, std::vector<Specimen> &outSelected, int parameter = -1);
 
@@ -0,0 +1,44 @@
+#include "TSPTinyExactAlgorithms.h"
+
+#include <stdexcept>
+#include <string>
+
+int TSPTinyExactAlgorithms::heldKarp(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    if (!isSupported(tspInstance)) {
+        throw std::invalid_argument("Instance size " + std::to_string(tspInstance->getVertexCount())
+                                    + " is not in [1, " + std::to_string(MAX_INSTANCE_SIZE) + "]");
+    }
+    return dispatch(tspInstance->getVertexCount(), tspInstance, outSolution,
+                    std::make_index_sequence<MAX_INSTANCE_SIZE>());
+}
+
+bool TSPTinyExactAlgorithms::isSupported(const IGraph *tspInstance) {
+    return tspInstance->getVertexCount() >= 1 && tspInstance->getVertexCount() <= MAX_INSTANCE_SIZE;
+}
+
+std::vector<int> TSPTinyExactAlgorithms::heldKarpBatch(const std::vector<const IGraph *> &tspInstances,
+                                                       std::vector<std::vector<int>> &outSolutions, int nThreads) {
+    if (nThreads <= 0) {
+        nThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    // instanceIdxsBySize[n - 1] - instances with n vertices
+    std::vector<std::vector<int>> instanceIdxsBySize(MAX_INSTANCE_SIZE);
+    for (int instanceIdx = 0; instanceIdx < tspInstances.size(); ++instanceIdx) {
+        if (!isSupported(tspInstances[instanceIdx])) {
+            throw std::invalid_argument("Instance " + std::to_string(instanceIdx) + " has size "
+                                        + std::to_string(tspInstances[instanceIdx]->getVertexCount())
+                                        + " not in [1, " + std::to_string(MAX_INSTANCE_SIZE) + "]");
+        }
+        instanceIdxsBySize[tspInstances[instanceIdx]->getVertexCount() - 1].emplace_back(instanceIdx);
+    }
+
+    std::vector<int> values(tspInstances.size());
+    outSolutions.assign(tspInstances.size(), std::vector<int>());
+    for (int instanceSize = 1; instanceSize <= MAX_INSTANCE_SIZE; ++instanceSize) {
+        if (!instanceIdxsBySize[instanceSize - 1].empty()) {
+            getBatchSolver(instanceSize, std::make_index_sequence<MAX_INSTANCE_SIZE>())(
+                    tspInstances, instanceIdxsBySize[instanceSize - 1], nThreads, values, outSolutions);
+        }
+    }
+    return values;
+}
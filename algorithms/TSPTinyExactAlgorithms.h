@@ -0,0 +1,318 @@
+#ifndef PEA_P1_TSPTINYEXACTALGORITHMS_H
+#define PEA_P1_TSPTINYEXACTALGORITHMS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../structures/graphs/IGraph.h"
+
+// Held-Karp specialized for every instance size up to MAX_INSTANCE_SIZE: the matrix is copied to std::array,
+// the bitmask DP table has a compile-time shape (on the stack while small) and the loop over predecessors is
+// unrolled. outSolution is a permutation of vertices (not cycle) - MUST be provided (as an argument) empty.
+class TSPTinyExactAlgorithms {
+
+public:
+    static constexpr int MAX_INSTANCE_SIZE = 16;
+
+    // Throws std::invalid_argument if the instance has more than MAX_INSTANCE_SIZE vertices
+    static int heldKarp(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    [[nodiscard]] static bool isSupported(const IGraph *tspInstance);
+
+    // Instance size is a template parameter - tour is written to outTour, starting with the fixed vertex N - 1
+    template<int N>
+    static int heldKarpFixed(const std::array<int, N * N> &costs, std::array<int, N> &outTour);
+
+    // Instances solved in lockstep by one batch pass - one lane per instance
+    static constexpr int BATCH_LANES = 8;
+
+    // Solves all instances (any sizes <= MAX_INSTANCE_SIZE). Instances of one size are solved BATCH_LANES at a time,
+    // batches are spread over nThreads (<= 0 - all hardware threads). outSolutions[i] is the tour of tspInstances[i],
+    // returns the tour values. Throws std::invalid_argument if any instance is too big.
+    static std::vector<int> heldKarpBatch(const std::vector<const IGraph *> &tspInstances,
+                                          std::vector<std::vector<int>> &outSolutions, int nThreads = 0);
+
+private:
+    // Sums saturate at INFINITE_COST - missing edges (INT_MAX) never overflow
+    static constexpr int INFINITE_COST = std::numeric_limits<int>::max() / 2;
+
+    // DP tables up to this size live on the stack, bigger ones in a per-thread buffer reused between calls
+    static constexpr std::size_t MAX_STACK_TABLE_SIZE = 128 * 1024;
+
+    template<int N>
+    using DPTable = std::array<std::array<int, N - 1>, (1u << (N - 1))>;
+
+    template<int N>
+    static int solve(const IGraph *tspInstance, std::vector<int> &outSolution);
+
+    using Lanes = std::array<int, BATCH_LANES>;
+
+    // partialPathCosts of all lanes - lane is the innermost dimension
+    template<int N>
+    using BatchDPTable = std::array<std::array<Lanes, N - 1>, (1u << (N - 1))>;
+
+    // Solves tspInstances[instanceIdxs[0 .. nInstances - 1]] (nInstances <= BATCH_LANES), unused lanes repeat the
+    // last instance
+    template<int N>
+    static void solveBatch(const std::vector<const IGraph *> &tspInstances, const int *instanceIdxs, int nInstances,
+                           BatchDPTable<N> &partialPathCosts, std::vector<int> &outValues,
+                           std::vector<std::vector<int>> &outSolutions);
+
+    using fSolveBatch = void (*)(const std::vector<const IGraph *> &, const std::vector<int> &, int,
+                                 std::vector<int> &, std::vector<std::vector<int>> &);
+
+    // Solves instances of size N listed in instanceIdxs with nThreads threads
+    template<int N>
+    static void solveBatches(const std::vector<const IGraph *> &tspInstances, const std::vector<int> &instanceIdxs,
+                             int nThreads, std::vector<int> &outValues, std::vector<std::vector<int>> &outSolutions);
+
+    template<int N>
+    static int heldKarpFixed(const std::array<int, N * N> &costs, std::array<int, N> &outTour,
+                             DPTable<N> &partialPathCosts);
+
+    // min(partialPathCosts[pathSet][k] + incomingCosts[endVertex][k]) over all k, one term per K - entries of
+    // vertices outside pathSet are INFINITE_COST, so no test is needed
+    template<int N, std::size_t... K>
+    static int bestPredecessorCost(const std::array<int, N * N> &incomingCosts, const DPTable<N> &partialPathCosts,
+                                   unsigned int pathSet, int endVertex, std::index_sequence<K...>) {
+        const int *costsToEnd = &incomingCosts[endVertex * N];
+        int bestCost = INFINITE_COST;
+        ((bestCost = std::min(bestCost, partialPathCosts[pathSet][K] + costsToEnd[K])), ...);
+        return bestCost;
+    }
+
+    template<std::size_t... N>
+    static fSolveBatch getBatchSolver(int instanceSize, std::index_sequence<N...>) {
+        // solvers[n - 1] - solveBatches<n>
+        static constexpr fSolveBatch solvers[] = {&solveBatches<static_cast<int>(N) + 1>...};
+        return solvers[instanceSize - 1];
+    }
+
+    template<std::size_t... N>
+    static int dispatch(int instanceSize, const IGraph *tspInstance, std::vector<int> &outSolution,
+                        std::index_sequence<N...>) {
+        using fSolve = int (*)(const IGraph *, std::vector<int> &);
+        // solvers[n - 1] - solve<n>
+        static constexpr fSolve solvers[] = {&solve<static_cast<int>(N) + 1>...};
+        return solvers[instanceSize - 1](tspInstance, outSolution);
+    }
+};
+
+template<int N>
+int TSPTinyExactAlgorithms::heldKarpFixed(const std::array<int, N * N> &costs, std::array<int, N> &outTour) {
+    if constexpr (N == 1) {
+        outTour[0] = 0;
+        return 0;
+    } else if constexpr (N == 2) {
+        outTour[0] = 1;
+        outTour[1] = 0;
+        return std::min(costs[1] + costs[2], INFINITE_COST);
+    } else if constexpr (sizeof(DPTable<N>) <= MAX_STACK_TABLE_SIZE) {
+        DPTable<N> partialPathCosts;
+        return heldKarpFixed<N>(costs, outTour, partialPathCosts);
+    } else {
+        thread_local std::unique_ptr<DPTable<N>> partialPathCosts;
+        if (!partialPathCosts) {
+            partialPathCosts.reset(new DPTable<N>);
+        }
+        return heldKarpFixed<N>(costs, outTour, *partialPathCosts);
+    }
+}
+
+template<int N>
+int TSPTinyExactAlgorithms::heldKarpFixed(const std::array<int, N * N> &costs, std::array<int, N> &outTour,
+                                          DPTable<N> &partialPathCosts) {
+    // (N - 1) is the fixed start vertex, sets hold vertices [0, N - 2]
+    constexpr int startVertex = N - 1;
+    constexpr unsigned int fullPathSet = (1u << (N - 1)) - 1;
+    constexpr auto predecessors = std::make_index_sequence<N - 1>();
+
+    // incomingCosts[j][k] = costs[k][j] - edges into one vertex are contiguous
+    std::array<int, N * N> incomingCosts;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            incomingCosts[j * N + i] = costs[i * N + j];
+        }
+    }
+
+    // partialPathCosts[S][j] - cheapest path from the start through all of S, ending in j (INFINITE_COST if j not in S)
+    for (int endVertex = 0; endVertex < N - 1; ++endVertex) {
+        partialPathCosts[0][endVertex] = INFINITE_COST;
+    }
+    for (unsigned int pathSet = 1; pathSet <= fullPathSet; ++pathSet) {
+        for (int endVertex = 0; endVertex < N - 1; ++endVertex) {
+            const unsigned int endVertexBit = 1u << endVertex;
+            if (!(pathSet & endVertexBit)) {
+                partialPathCosts[pathSet][endVertex] = INFINITE_COST;
+            } else if (pathSet == endVertexBit) {
+                partialPathCosts[pathSet][endVertex] = costs[startVertex * N + endVertex];
+            } else {
+                partialPathCosts[pathSet][endVertex] = std::min(
+                        bestPredecessorCost<N>(incomingCosts, partialPathCosts, pathSet & ~endVertexBit, endVertex,
+                                               predecessors), INFINITE_COST);
+            }
+        }
+    }
+
+    // Closing edge is an edge to the start vertex
+    int bestPathCost = std::min(bestPredecessorCost<N>(incomingCosts, partialPathCosts, fullPathSet, startVertex,
+                                                       predecessors), INFINITE_COST);
+
+    // Travel backward - take the first predecessor matching the remaining cost
+    outTour[0] = startVertex;
+    unsigned int pathSet = fullPathSet;
+    int nextVertex = startVertex;
+    int remainingCost = bestPathCost;
+    for (int position = N - 1; position >= 1; --position) {
+        for (int vertex = 0; vertex < N - 1; ++vertex) {
+            if ((pathSet & (1u << vertex))
+                && std::min(partialPathCosts[pathSet][vertex] + costs[vertex * N + nextVertex], INFINITE_COST)
+                   == remainingCost) {
+                outTour[position] = vertex;
+                remainingCost = partialPathCosts[pathSet][vertex];
+                pathSet &= ~(1u << vertex);
+                nextVertex = vertex;
+                break;
+            }
+        }
+    }
+    return bestPathCost;
+}
+
+template<int N>
+int TSPTinyExactAlgorithms::solve(const IGraph *tspInstance, std::vector<int> &outSolution) {
+    std::array<int, N * N> costs{};
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            costs[i * N + j] = std::min(tspInstance->getEdgeParameter(i, j), INFINITE_COST);
+        }
+    }
+    std::array<int, N> tour{};
+    const int bestPathCost = heldKarpFixed<N>(costs, tour);
+    outSolution.assign(tour.begin(), tour.end());
+    return bestPathCost;
+}
+
+template<int N>
+void TSPTinyExactAlgorithms::solveBatch(const std::vector<const IGraph *> &tspInstances, const int *instanceIdxs,
+                                        int nInstances, BatchDPTable<N> &partialPathCosts,
+                                        std::vector<int> &outValues, std::vector<std::vector<int>> &outSolutions) {
+    constexpr int startVertex = N - 1;
+    constexpr unsigned int fullPathSet = (1u << (N - 1)) - 1;
+
+    // incomingCosts[j * N + k][lane] = cost of edge (k, j) in the lane's instance
+    std::array<Lanes, N * N> incomingCosts;
+    for (int lane = 0; lane < BATCH_LANES; ++lane) {
+        const IGraph *tspInstance = tspInstances[instanceIdxs[std::min(lane, nInstances - 1)]];
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                incomingCosts[j * N + i][lane] = std::min(tspInstance->getEdgeParameter(i, j), INFINITE_COST);
+            }
+        }
+    }
+
+    // As in heldKarpFixed, every operation is done on all lanes - the lane loops compile to vector instructions
+    Lanes bestCosts;
+    for (int endVertex = 0; endVertex < N - 1; ++endVertex) {
+        partialPathCosts[0][endVertex].fill(INFINITE_COST);
+    }
+    for (unsigned int pathSet = 1; pathSet <= fullPathSet; ++pathSet) {
+        for (int endVertex = 0; endVertex < N - 1; ++endVertex) {
+            const unsigned int endVertexBit = 1u << endVertex;
+            Lanes &pathCosts = partialPathCosts[pathSet][endVertex];
+            if (!(pathSet & endVertexBit)) {
+                pathCosts.fill(INFINITE_COST);
+                continue;
+            } else if (pathSet == endVertexBit) {
+                pathCosts = incomingCosts[endVertex * N + startVertex];
+                continue;
+            }
+            const unsigned int previousPathSet = pathSet & ~endVertexBit;
+            bestCosts.fill(INFINITE_COST);
+            for (int k = 0; k < N - 1; ++k) {
+                const Lanes &previousCosts = partialPathCosts[previousPathSet][k];
+                const Lanes &edgeCosts = incomingCosts[endVertex * N + k];
+                for (int lane = 0; lane < BATCH_LANES; ++lane) {
+                    bestCosts[lane] = std::min(bestCosts[lane], previousCosts[lane] + edgeCosts[lane]);
+                }
+            }
+            for (int lane = 0; lane < BATCH_LANES; ++lane) {
+                pathCosts[lane] = std::min(bestCosts[lane], INFINITE_COST);
+            }
+        }
+    }
+
+    // Closing edges and tours - per lane
+    for (int lane = 0; lane < nInstances; ++lane) {
+        int bestPathCost = INFINITE_COST;
+        for (int k = 0; k < N - 1; ++k) {
+            bestPathCost = std::min(bestPathCost,
+                                    partialPathCosts[fullPathSet][k][lane] + incomingCosts[startVertex * N + k][lane]);
+        }
+
+        std::vector<int> &tour = outSolutions[instanceIdxs[lane]];
+        tour.assign(N, startVertex);
+        unsigned int pathSet = fullPathSet;
+        int nextVertex = startVertex;
+        int remainingCost = bestPathCost;
+        for (int position = N - 1; position >= 1; --position) {
+            for (int vertex = 0; vertex < N - 1; ++vertex) {
+                if ((pathSet & (1u << vertex))
+                    && std::min(partialPathCosts[pathSet][vertex][lane]
+                                + incomingCosts[nextVertex * N + vertex][lane], INFINITE_COST) == remainingCost) {
+                    tour[position] = vertex;
+                    remainingCost = partialPathCosts[pathSet][vertex][lane];
+                    pathSet &= ~(1u << vertex);
+                    nextVertex = vertex;
+                    break;
+                }
+            }
+        }
+        outValues[instanceIdxs[lane]] = bestPathCost;
+    }
+}
+
+template<int N>
+void TSPTinyExactAlgorithms::solveBatches(const std::vector<const IGraph *> &tspInstances,
+                                          const std::vector<int> &instanceIdxs, int nThreads,
+                                          std::vector<int> &outValues, std::vector<std::vector<int>> &outSolutions) {
+    if constexpr (N <= 2) {
+        // Nothing to vectorize
+        for (int instanceIdx : instanceIdxs) {
+            outSolutions[instanceIdx].clear();
+            outValues[instanceIdx] = solve<N>(tspInstances[instanceIdx], outSolutions[instanceIdx]);
+        }
+    } else {
+        const int nBatches = static_cast<int>((instanceIdxs.size() + BATCH_LANES - 1) / BATCH_LANES);
+        std::atomic<int> nextBatchIdx(0);
+        // Batches write to disjoint outValues and outSolutions elements
+        auto worker = [&]() {
+            std::unique_ptr<BatchDPTable<N>> partialPathCosts(new BatchDPTable<N>);
+            int batchIdx;
+            while ((batchIdx = nextBatchIdx.fetch_add(1)) < nBatches) {
+                const int firstIdx = batchIdx * BATCH_LANES;
+                solveBatch<N>(tspInstances, instanceIdxs.data() + firstIdx,
+                              std::min(BATCH_LANES, static_cast<int>(instanceIdxs.size()) - firstIdx),
+                              *partialPathCosts, outValues, outSolutions);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (int threadIdx = 1; threadIdx < std::min(nThreads, nBatches); ++threadIdx) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto &workerThread : workers) {
+            workerThread.join();
+        }
+    }
+}
+
+
+#endif //PEA_P1_TSPTINYEXACTALGORITHMS_H
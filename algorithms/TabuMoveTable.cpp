@@ -0,0 +1,257 @@
+#include <stdexcept>
+
+#include "TabuMoveTable.h"
+
+TabuMoveTable::TabuMoveTable(const IGraph *tspInstance, MoveType moveType)
+        : moveType(moveType), instanceSize(tspInstance->getVertexCount()),
+          costs(static_cast<std::size_t>(instanceSize) * instanceSize, 0), solutionValue(0),
+          moveValueDiffs(costs.size(), 0), moveVersions(costs.size(), 0), currentVersion(0) {
+    if (instanceSize <= 2) {
+        throw std::invalid_argument("Instance too small for the neighbourhood");
+    }
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = 0; j < instanceSize; ++j) {
+            if (i != j) {
+                costs[i * instanceSize + j] = tspInstance->getEdgeParameter(i, j);
+            }
+        }
+    }
+}
+
+void TabuMoveTable::reset(const std::vector<int> &newSolution, int newSolutionValue) {
+    if (static_cast<int>(newSolution.size()) != instanceSize) {
+        throw std::invalid_argument("Solution size differs from instance size");
+    }
+    solution = newSolution;
+    solutionValue = newSolutionValue;
+    dispatchMoveType([this](auto type) {
+        evaluateAllMoves<decltype(type)::value>();
+    });
+}
+
+void TabuMoveTable::applyMove(int i, int j) {
+    if (i < 0 || j < 0 || i >= instanceSize || j >= instanceSize) {
+        throw std::invalid_argument("Not a move of the neighbourhood");
+    }
+    dispatchMoveType([this, i, j](auto type) {
+        performMove<decltype(type)::value>(i, j);
+    });
+}
+
+int TabuMoveTable::getMoveValue(int i, int j) const {
+    bool isValidMove = i >= 0 && j >= 0 && i < instanceSize && j < instanceSize;
+    dispatchMoveType([&isValidMove, i, j](auto type) {
+        isValidMove = isValidMove && isMove<decltype(type)::value>(i, j);
+    });
+    if (!isValidMove) {
+        throw std::invalid_argument("Not a move of the neighbourhood");
+    }
+    return solutionValue + moveValueDiffs[i * instanceSize + j];
+}
+
+const std::vector<int> &TabuMoveTable::getSolution() const {
+    return solution;
+}
+
+int TabuMoveTable::getSolutionValue() const {
+    return solutionValue;
+}
+
+template<class Function>
+void TabuMoveTable::dispatchMoveType(Function function) const {
+    switch (moveType) {
+        case MoveType::Swap:
+            function(std::integral_constant<MoveType, MoveType::Swap>());
+            break;
+        case MoveType::Insert:
+            function(std::integral_constant<MoveType, MoveType::Insert>());
+            break;
+        case MoveType::Invert:
+            function(std::integral_constant<MoveType, MoveType::Invert>());
+            break;
+    }
+}
+
+template<TabuMoveTable::MoveType type>
+bool TabuMoveTable::isMove(int i, int j) {
+    if constexpr (type == MoveType::Insert) {
+        return i != j && i != j + 1;
+    } else {
+        return i < j;
+    }
+}
+
+// Same values as TSPLocalSearchAlgorithms::swapNeighbourhoodTFValue, insertNeighbourhoodTFValue and
+// invertNeighbourhoodTFValue, without building the neighbour
+template<TabuMoveTable::MoveType type>
+int TabuMoveTable::calculateValueDiff(int i, int j) const {
+    const int lastPosition = instanceSize - 1;
+    const int iLeft = i == 0 ? lastPosition : i - 1;
+    const int iRight = i == lastPosition ? 0 : i + 1;
+    const int jLeft = j == 0 ? lastPosition : j - 1;
+    const int jRight = j == lastPosition ? 0 : j + 1;
+    const int iCity = solution[i];
+    const int jCity = solution[j];
+    int valueDiff = 0;
+    if constexpr (type == MoveType::Swap) {
+        if (i == 0 && j == lastPosition) {
+            valueDiff += cost(solution[jLeft], iCity) - cost(solution[jLeft], jCity);
+            valueDiff += cost(iCity, jCity) - cost(jCity, iCity);
+            valueDiff += cost(jCity, solution[iRight]) - cost(iCity, solution[iRight]);
+            return valueDiff;
+        }
+        valueDiff += cost(solution[iLeft], jCity) - cost(solution[iLeft], iCity);
+        valueDiff += cost(iCity, solution[jRight]) - cost(jCity, solution[jRight]);
+        if (iRight == j) {
+            valueDiff += cost(jCity, iCity) - cost(iCity, jCity);
+        } else {
+            valueDiff += cost(jCity, solution[iRight]) - cost(iCity, solution[iRight]);
+            valueDiff += cost(solution[jLeft], iCity) - cost(solution[jLeft], jCity);
+        }
+    } else if constexpr (type == MoveType::Insert) {
+        // jCity moves to position i
+        if ((i == 0 && j == lastPosition) || (j == 0 && i == lastPosition)) {
+            return 0;
+        }
+        if (i < j) {
+            valueDiff += cost(solution[jLeft], solution[jRight]) - cost(jCity, solution[jRight]);
+            valueDiff += cost(solution[iLeft], jCity) - cost(solution[iLeft], iCity);
+            valueDiff += cost(jCity, iCity) - cost(solution[jLeft], jCity);
+        } else {
+            valueDiff += cost(solution[jLeft], solution[jRight]) - cost(solution[jLeft], jCity);
+            valueDiff += cost(jCity, solution[iRight]) - cost(iCity, solution[iRight]);
+            valueDiff += cost(iCity, jCity) - cost(jCity, solution[jRight]);
+        }
+    } else {
+        if (i == 0 && j == lastPosition) {
+            return backwardPathCosts[lastPosition] + cost(iCity, jCity) - solutionValue;
+        }
+        valueDiff += cost(solution[iLeft], jCity) - cost(solution[iLeft], iCity);
+        valueDiff += backwardPathCosts[j] - backwardPathCosts[i] - (forwardPathCosts[j] - forwardPathCosts[i]);
+        valueDiff += cost(iCity, solution[jRight]) - cost(jCity, solution[jRight]);
+    }
+    return valueDiff;
+}
+
+template<TabuMoveTable::MoveType type>
+void TabuMoveTable::evaluateAllMoves() {
+    ++currentVersion;
+    if constexpr (type == MoveType::Invert) {
+        calculatePathCosts();
+    }
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = 0; j < instanceSize; ++j) {
+            if (isMove<type>(i, j)) {
+                moveValueDiffs[i * instanceSize + j] = calculateValueDiff<type>(i, j);
+                moveVersions[i * instanceSize + j] = currentVersion;
+            }
+        }
+    }
+    rebuildHeap<type>();
+}
+
+template<TabuMoveTable::MoveType type>
+void TabuMoveTable::performMove(int i, int j) {
+    if (!isMove<type>(i, j)) {
+        throw std::invalid_argument("Not a move of the neighbourhood");
+    }
+    solutionValue += moveValueDiffs[i * instanceSize + j];
+    const int lastPosition = instanceSize - 1;
+    const int firstChanged = std::min(i, j);
+    const int lastChanged = std::max(i, j);
+    if constexpr (type == MoveType::Swap) {
+        std::swap(solution[i], solution[j]);
+        ++currentVersion;
+        for (const int position : {i, j}) {
+            evaluateMovesOfPosition<type>(position == 0 ? lastPosition : position - 1);
+            evaluateMovesOfPosition<type>(position);
+            evaluateMovesOfPosition<type>(position == lastPosition ? 0 : position + 1);
+        }
+    } else if constexpr (type == MoveType::Insert) {
+        if (i < j) {
+            std::rotate(solution.begin() + i, solution.begin() + j, solution.begin() + j + 1);
+        } else {
+            std::rotate(solution.begin() + j, solution.begin() + j + 1, solution.begin() + i + 1);
+        }
+        if (firstChanged == 0 && lastChanged == lastPosition) {
+            // Rotation of the whole tour
+            evaluateAllMoves<type>();
+            return;
+        }
+        ++currentVersion;
+        for (int position = firstChanged - 1; position <= lastChanged + 1; ++position) {
+            evaluateMovesOfPosition<type>((position + instanceSize) % instanceSize);
+        }
+    } else {
+        std::reverse(solution.begin() + i, solution.begin() + j + 1);
+        if (firstChanged == 0 && lastChanged == lastPosition) {
+            evaluateAllMoves<type>();
+            return;
+        }
+        ++currentVersion;
+        calculatePathCosts();
+        // Move (k, l) reads positions k - 1 to l + 1
+        for (int k = 0; k <= std::min(lastChanged + 1, lastPosition - 1); ++k) {
+            for (int l = std::max(k + 1, firstChanged - 1); l <= lastPosition; ++l) {
+                evaluateMove<type>(k, l);
+            }
+        }
+        // Cyclic neighbours: k = 0 reads the last position and l = lastPosition the first one
+        if (lastChanged == lastPosition) {
+            evaluateMovesOfPosition<type>(0);
+        }
+        if (firstChanged == 0) {
+            evaluateMovesOfPosition<type>(lastPosition);
+        }
+        evaluateMove<type>(0, lastPosition);
+    }
+    if (moveHeap.size() > 2 * moveValueDiffs.size()) {
+        rebuildHeap<type>();
+    }
+}
+
+template<TabuMoveTable::MoveType type>
+void TabuMoveTable::evaluateMove(int i, int j) {
+    if (!isMove<type>(i, j)) {
+        return;
+    }
+    const int moveIdx = i * instanceSize + j;
+    if (moveVersions[moveIdx] == currentVersion) {
+        return;
+    }
+    moveValueDiffs[moveIdx] = calculateValueDiff<type>(i, j);
+    moveVersions[moveIdx] = currentVersion;
+    moveHeap.push_back({moveValueDiffs[moveIdx], moveIdx, currentVersion});
+    std::push_heap(moveHeap.begin(), moveHeap.end(), isHeapEntryWorse);
+}
+
+template<TabuMoveTable::MoveType type>
+void TabuMoveTable::evaluateMovesOfPosition(int position) {
+    for (int other = 0; other < instanceSize; ++other) {
+        evaluateMove<type>(position, other);
+        evaluateMove<type>(other, position);
+    }
+}
+
+void TabuMoveTable::calculatePathCosts() {
+    forwardPathCosts.assign(instanceSize, 0);
+    backwardPathCosts.assign(instanceSize, 0);
+    for (int k = 1; k < instanceSize; ++k) {
+        forwardPathCosts[k] = forwardPathCosts[k - 1] + cost(solution[k - 1], solution[k]);
+        backwardPathCosts[k] = backwardPathCosts[k - 1] + cost(solution[k], solution[k - 1]);
+    }
+}
+
+template<TabuMoveTable::MoveType type>
+void TabuMoveTable::rebuildHeap() {
+    moveHeap.clear();
+    for (int i = 0; i < instanceSize; ++i) {
+        for (int j = 0; j < instanceSize; ++j) {
+            if (isMove<type>(i, j)) {
+                const int moveIdx = i * instanceSize + j;
+                moveHeap.push_back({moveValueDiffs[moveIdx], moveIdx, moveVersions[moveIdx]});
+            }
+        }
+    }
+    std::make_heap(moveHeap.begin(), moveHeap.end(), isHeapEntryWorse);
+}
@@ -0,0 +1,141 @@
+#ifndef PEA_P1_TABUMOVETABLE_H
+#define PEA_P1_TABUMOVETABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../structures/graphs/IGraph.h"
+
+// Values of all moves of one neighbourhood of the current tabu search solution. A move changes the cities of a few
+// positions (swap) or of one range (insert, invert), so after it only moves reading those positions are evaluated
+// again - O(n) of them for swap. The best move is taken from a heap over the values; entries of re-evaluated moves
+// stay in it as stale and are dropped when they come to the top or the heap is rebuilt.
+class TabuMoveTable {
+public:
+    // Moves (i, j) as in TSPLocalSearchAlgorithms::swapNeighbourhood, insertNeighbourhood and invertNeighbourhood;
+    // i < j for swap and invert, i != j and i != j + 1 for insert
+    enum class MoveType {
+        Swap, Insert, Invert
+    };
+
+    TabuMoveTable(const IGraph *tspInstance, MoveType moveType);
+
+    // Evaluates all moves of solution
+    void reset(const std::vector<int> &solution, int solutionValue);
+
+    // Performs move (i, j) on the solution and evaluates moves whose value it changed
+    void applyMove(int i, int j);
+
+    // Move of the smallest value (ties: smallest i, then j - the order of a scan) for which
+    // isAdmissible(i, j, value) holds. Returns false if there is none.
+    template<class Predicate>
+    bool findBestMove(Predicate isAdmissible, int &outI, int &outJ, int &outValue);
+
+    // Value of the solution after move (i, j)
+    [[nodiscard]] int getMoveValue(int i, int j) const;
+
+    [[nodiscard]] const std::vector<int> &getSolution() const;
+
+    [[nodiscard]] int getSolutionValue() const;
+
+private:
+    struct HeapEntry {
+        int valueDiff;
+        // i * n + j
+        int moveIdx;
+        std::uint64_t version;
+    };
+
+    MoveType moveType;
+    int instanceSize;
+    // [i * n + j]
+    std::vector<int> costs;
+
+    std::vector<int> solution;
+    int solutionValue;
+
+    // [i * n + j] - value of the move minus solutionValue and version of the evaluation (heap entries of older
+    // versions are stale)
+    std::vector<int> moveValueDiffs;
+    std::vector<std::uint64_t> moveVersions;
+    std::uint64_t currentVersion;
+
+    // Min-heap by (valueDiff, moveIdx)
+    std::vector<HeapEntry> moveHeap;
+    std::vector<HeapEntry> skippedEntries;
+
+    // Invert only: [k] - cost of the path solution[0..k] traversed forward and backward
+    std::vector<int> forwardPathCosts;
+    std::vector<int> backwardPathCosts;
+
+    static bool isHeapEntryWorse(const HeapEntry &lhs, const HeapEntry &rhs) {
+        return lhs.valueDiff > rhs.valueDiff || (lhs.valueDiff == rhs.valueDiff && lhs.moveIdx > rhs.moveIdx);
+    }
+
+    // The only branch on moveType - calls function(std::integral_constant<MoveType, moveType>()), so the loops over
+    // moves below are compiled for each type
+    template<class Function>
+    void dispatchMoveType(Function function) const;
+
+    template<MoveType type>
+    [[nodiscard]] static bool isMove(int i, int j);
+
+    [[nodiscard]] int cost(int from, int to) const {
+        return costs[from * instanceSize + to];
+    }
+
+    template<MoveType type>
+    [[nodiscard]] int calculateValueDiff(int i, int j) const;
+
+    template<MoveType type>
+    void evaluateAllMoves();
+
+    template<MoveType type>
+    void performMove(int i, int j);
+
+    // Evaluates move (i, j) unless it is not a move or was evaluated in this version
+    template<MoveType type>
+    void evaluateMove(int i, int j);
+
+    // All moves with i or j equal to position
+    template<MoveType type>
+    void evaluateMovesOfPosition(int position);
+
+    void calculatePathCosts();
+
+    template<MoveType type>
+    void rebuildHeap();
+};
+
+template<class Predicate>
+bool TabuMoveTable::findBestMove(Predicate isAdmissible, int &outI, int &outJ, int &outValue) {
+    bool isFound = false;
+    while (!moveHeap.empty()) {
+        const HeapEntry entry = moveHeap.front();
+        if (entry.version == moveVersions[entry.moveIdx]) {
+            const int i = entry.moveIdx / instanceSize;
+            const int j = entry.moveIdx % instanceSize;
+            if (isAdmissible(i, j, solutionValue + entry.valueDiff)) {
+                outI = i;
+                outJ = j;
+                outValue = solutionValue + entry.valueDiff;
+                isFound = true;
+                break;
+            }
+            skippedEntries.emplace_back(entry);
+        }
+        std::pop_heap(moveHeap.begin(), moveHeap.end(), isHeapEntryWorse);
+        moveHeap.pop_back();
+    }
+    for (const auto &entry : skippedEntries) {
+        moveHeap.emplace_back(entry);
+        std::push_heap(moveHeap.begin(), moveHeap.end(), isHeapEntryWorse);
+    }
+    skippedEntries.clear();
+    return isFound;
+}
+
+
+#endif //PEA_P1_TABUMOVETABLE_H
@@ -4,6 +4,8 @@
 #include "../TSPGreedyAlgorithms.h"
 #include "../TSPLocalSearchAlgorithms.h"
 
+class InstanceContext;
+
 class LocalSearchParameters {
 
 public:
@@ -38,10 +40,14 @@ public:
 //    TSPGreedyAlgorithms::fTSPAlgorithm initialSolutionFunction;
 //    TSPLocalSearchAlgorithms::fNeighbourhood nextNeighbourFunction;
 
+    // Both - optional, cached initial solutions are taken from it (must be created for the solved instance)
+    const InstanceContext *instanceContext;
+
     LocalSearchParameters() : initialTemperature(-1), coolingSchemeParameter(-1), epochIterationsNumber(-1),
                               iterationsNumber(-1), coolingSchemeFunction(nullptr), nextNeighbourFunction(nullptr),
                               initialSolutionFunction(nullptr), tabuListSize(-1), cadenzaLengthParameter(-1),
-                              iterationsWithoutImprovementToRestart(-1), patternsNumberToCache(-1) {}
+                              iterationsWithoutImprovementToRestart(-1), patternsNumberToCache(-1),
+                              instanceContext(nullptr) {}
 
     // Simulated annealing
     LocalSearchParameters(double initialTemperature, double coolingSchemeParameter, int epochIterationsNumber,
@@ -51,7 +57,7 @@ public:
             : initialTemperature(initialTemperature), coolingSchemeParameter(coolingSchemeParameter),
               epochIterationsNumber(epochIterationsNumber), iterationsNumber(iterationsNumber),
               coolingSchemeFunction(coolingSchemeFunction), nextNeighbourFunction(nextNeighbourFunction),
-              initialSolutionFunction(initialSolutionFunction) {}
+              initialSolutionFunction(initialSolutionFunction), instanceContext(nullptr) {}
 
     // Tabu search
     LocalSearchParameters(int iterationsNumber, int tabuListSize, double cadenzaLengthParameter,
@@ -62,7 +68,7 @@ public:
             cadenzaLengthParameter(cadenzaLengthParameter),
             iterationsWithoutImprovementToRestart(iterationsWithoutImprovementToRestart),
             patternsNumberToCache(patternsNumberToCache), initialSolutionFunction(initialSolutionFunction),
-            nextNeighbourFunction(nextNeighbourFunction) {}
+            nextNeighbourFunction(nextNeighbourFunction), instanceContext(nullptr) {}
 
     void setSimulatedAnnealingDefaultParameters() {
         initialTemperature = 1000;
@@ -2,6 +2,7 @@
 #define PEA_P1_SPECIMEN_H
 
 #include <utility>
+#include <limits>
 #include <vector>
 
 class Specimen {
@@ -1,8 +1,11 @@
 #ifndef PEA_P1_TSPHELPERSTRUCTURES_H
 #define PEA_P1_TSPHELPERSTRUCTURES_H
 
+#include <cstddef>
 #include <vector>
 #include <list>
+#include <limits>
+#include <type_traits>
 
 
 struct TSPEdge {
@@ -16,6 +19,15 @@ struct TSPEdge {
     TSPEdge(int i, int j, int cost) : i(i), j(j), cost(cost) {}
 };
 
+// Saving of joining i -> j directly instead of through the hub (Clarke-Wright)
+struct TSPSaving {
+    long long saving;
+    int i;
+    int j;
+
+    TSPSaving(long long saving, int i, int j) : saving(saving), i(i), j(j) {}
+};
+
 struct EdgeCities {
     int i;
     int j;
@@ -26,12 +38,25 @@ struct EdgeCities {
     EdgeCities(int i, int j) : i(i), j(j) {}
 };
 
+// Vertex of partial paths in B&B nodes - merging paths and finding the edge closing a subtour take O(1)
+struct BBPathVertex {
+    // Next vertex of the partial path, -1 if none
+    int successor;
+
+    // Meaningful only for path endpoints (single vertices are paths of their own): first vertex of the path ending
+    // at this one and last vertex of the path starting at it
+    int pathHead;
+    int pathTail;
+};
+
+static_assert(std::is_trivially_copyable<BBPathVertex>::value, "BBPathVertex is copied as raw memory");
+
 struct BBNodeData {
     // ATSP distances
     std::vector<std::vector<int>> distances;
 
     // Partial paths already added to possible solution
-    std::vector<std::list<int>> partialPaths;
+    std::vector<BBPathVertex> pathVertices;
 
     // Number of already added edges to the path (maximum = instanceSize)
     int edgesOnPath;
@@ -50,7 +75,13 @@ struct BBNodeData {
 
     BBNodeData() { init(); }
 
-    explicit BBNodeData(int instanceSize) : distances(instanceSize, std::vector<int>(instanceSize)) { init(); }
+    explicit BBNodeData(int instanceSize) : distances(instanceSize, std::vector<int>(instanceSize)),
+                                            pathVertices(instanceSize) {
+        for (int vertex = 0; vertex != instanceSize; ++vertex) {
+            pathVertices[vertex] = {-1, vertex, vertex};
+        }
+        init();
+    }
 
 private:
     void init() {
@@ -61,4 +92,117 @@ private:
     }
 };
 
+// Node of TSPExactAlgorithms::branchAndBoundCompactNodes - reduced cost of an available edge (i, j) is
+// distance(i, j) - rowPotentials[i] - columnPotentials[j]
+struct BBCompactNodeData {
+    std::vector<int> rowPotentials;
+    std::vector<int> columnPotentials;
+
+    // Edges already added to possible solution - their rows and columns are unavailable
+    std::vector<EdgeCities> forcedEdges;
+
+    // Edges excluded by branching (edges closing subtours are derived from forcedEdges)
+    std::vector<EdgeCities> forbiddenEdges;
+
+    // True if the node can't be processed further, otherwise false
+    bool isFinal;
+
+    // Indexes of 0 with the highest penalty in reduced costs
+    EdgeCities highestZeroPenaltiesIndexes;
+
+    // Highest penalty of 0
+    int highestZeroPenalty;
+
+    // Current lower bound - sum of potentials
+    int lowerBound;
+
+    BBCompactNodeData() : isFinal(false), highestZeroPenalty(0), lowerBound(0) {}
+
+    explicit BBCompactNodeData(int instanceSize) : rowPotentials(instanceSize, 0), columnPotentials(instanceSize, 0),
+                                                   isFinal(false), highestZeroPenalty(0), lowerBound(0) {}
+};
+
+// Change of BBDepthFirstData - reductions are undone by adding the amount back to available entries, so a node
+// records O(n) entries instead of every changed distance
+struct BBTrailEntry {
+    enum class Type {
+        Assignment, RowReduction, ColumnReduction
+    };
+
+    Type type;
+
+    // Assignment - changed variable
+    int *location;
+
+    // Reduced row / column
+    int index;
+
+    // Assignment - previous value, reductions - subtracted amount
+    int value;
+
+    BBTrailEntry(Type type, int *location, int index, int value)
+            : type(type), location(location), index(index), value(value) {}
+};
+
+// State of TSPExactAlgorithms::branchAndBoundDepthFirst - one matrix changed in place, every change goes to trail
+// and is undone on backtrack
+struct BBDepthFirstData {
+    int instanceSize;
+
+    // ATSP distances, flat row-major
+    std::vector<int> distances;
+
+    // Pointers to rows of distances
+    std::vector<int *> rows;
+
+    // Partial paths already added to possible solution
+    std::vector<BBPathVertex> pathVertices;
+
+    std::vector<BBTrailEntry> trail;
+
+    explicit BBDepthFirstData(int instanceSize)
+            : instanceSize(instanceSize), distances(instanceSize * instanceSize), pathVertices(instanceSize) {
+        for (int vertex = 0; vertex != instanceSize; ++vertex) {
+            pathVertices[vertex] = {-1, vertex, vertex};
+        }
+    }
+
+    void assign(int &location, int value) {
+        trail.emplace_back(BBTrailEntry::Type::Assignment, &location, -1, location);
+        location = value;
+    }
+
+    // Records reductions already subtracted from available entries
+    void recordRowReduction(int i, int amount) {
+        trail.emplace_back(BBTrailEntry::Type::RowReduction, nullptr, i, amount);
+    }
+
+    void recordColumnReduction(int j, int amount) {
+        trail.emplace_back(BBTrailEntry::Type::ColumnReduction, nullptr, j, amount);
+    }
+
+    // Reverts changes made after trail had mark entries
+    void undo(std::size_t mark) {
+        while (trail.size() > mark) {
+            const BBTrailEntry &entry = trail.back();
+            if (entry.type == BBTrailEntry::Type::Assignment) {
+                *entry.location = entry.value;
+            } else if (entry.type == BBTrailEntry::Type::RowReduction) {
+                for (int j = 0; j != instanceSize; ++j) {
+                    if (distances[entry.index * instanceSize + j] != std::numeric_limits<int>::max()) {
+                        distances[entry.index * instanceSize + j] += entry.value;
+                    }
+                }
+            } else {
+                for (int i = 0; i != instanceSize; ++i) {
+                    if (distances[i * instanceSize + entry.index] != std::numeric_limits<int>::max()) {
+                        distances[i * instanceSize + entry.index] += entry.value;
+                    }
+                }
+            }
+            trail.pop_back();
+        }
+    }
+};
+
 #endif //PEA_P1_TSPHELPERSTRUCTURES_H
@@ -0,0 +1,467 @@
+#include "CommandLineDriver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "../utilities/JSON.h"
+#include "../utilities/Random.h"
+
+int CommandLineDriver::run(int argc, char **argv) const {
+    const std::string programName = argc > 0 ? argv[0] : "PEA_p1_cli";
+    const std::vector<std::string> arguments(argv + std::min(argc, 1), argv + argc);
+
+    CommandLineOptions options;
+    SolverRegistry::fSolver solver;
+    std::map<std::string, int> solutionValues;
+    try {
+        options = parseArguments(arguments);
+        if (options.isHelpRequested) {
+            printUsage(std::cout, programName);
+            return EXIT_OK;
+        }
+        if (options.isSolverListRequested) {
+            printSolvers(std::cout);
+            return EXIT_OK;
+        }
+        solver = SolverRegistry::createSolver(options.solverName, options.solverParameters);
+        if (!options.solutionsPath.empty()) {
+            solutionValues = TSPUtils::loadTSPSolutionValuesAbsolutePath(options.solutionsPath);
+        }
+    } catch (const std::invalid_argument &e) {
+        std::cerr << "Error: " << e.what() << std::endl << std::endl;
+        printUsage(std::cerr, programName);
+        return EXIT_USAGE;
+    }
+    const bool isStochastic = SolverRegistry::getSolverInfo(options.solverName).isStochastic;
+
+    const int nInstances = static_cast<int>(options.instancePaths.size());
+    std::vector<CommandLineResult> results(nInstances);
+
+    // Solve start in ms since runStart: NOT_STARTED before, FINISHED after the result has been written
+    const long long NOT_STARTED = -1, FINISHED = -2;
+    std::unique_ptr<std::atomic<long long>[]> solveStarts(new std::atomic<long long>[nInstances]);
+    for (int instanceIdx = 0; instanceIdx < nInstances; ++instanceIdx) {
+        solveStarts[instanceIdx].store(NOT_STARTED);
+    }
+    std::atomic<int> nextInstanceIdx(0), nFinished(0);
+
+    const auto runStart = std::chrono::steady_clock::now();
+    auto getElapsedMs = [&runStart]() -> long long {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - runStart).count();
+    };
+
+    auto worker = [&]() {
+        int instanceIdx;
+        while ((instanceIdx = nextInstanceIdx.fetch_add(1)) < nInstances) {
+            solveStarts[instanceIdx].store(getElapsedMs());
+            solveInstance(options, solver, isStochastic, instanceIdx, results[instanceIdx]);
+            solveStarts[instanceIdx].store(FINISHED, std::memory_order_release);
+            nFinished.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int threadIdx = 0; threadIdx < std::min(options.nThreads, nInstances); ++threadIdx) {
+        workers.emplace_back(worker);
+    }
+
+    if (options.timeLimitMs > 0) {
+        while (nFinished.load(std::memory_order_acquire) < nInstances) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            bool isTimeout = false;
+            for (int instanceIdx = 0; instanceIdx < nInstances; ++instanceIdx) {
+                const long long solveStart = solveStarts[instanceIdx].load(std::memory_order_acquire);
+                if (solveStart >= 0 && getElapsedMs() - solveStart > options.timeLimitMs + TIMEOUT_GRACE_MS) {
+                    isTimeout = true;
+                }
+            }
+            if (!isTimeout) {
+                continue;
+            }
+
+            // Running solvers cannot be stopped - report what is known and leave without joining workers
+            std::vector<CommandLineResult> partialResults(nInstances);
+            for (int instanceIdx = 0; instanceIdx < nInstances; ++instanceIdx) {
+                const long long solveStart = solveStarts[instanceIdx].load(std::memory_order_acquire);
+                if (solveStart == FINISHED) {
+                    partialResults[instanceIdx] = results[instanceIdx];
+                    continue;
+                }
+                partialResults[instanceIdx].instancePath = options.instancePaths[instanceIdx];
+                if (solveStart != NOT_STARTED) {
+                    partialResults[instanceIdx].status = CommandLineResult::Status::Timeout;
+                    partialResults[instanceIdx].timeMs = static_cast<double>(getElapsedMs() - solveStart);
+                    partialResults[instanceIdx].message = "Time limit exceeded";
+                }
+            }
+            for (auto &result : partialResults) {
+                auto solutionValueIt = solutionValues.find(std::filesystem::path(result.instancePath).stem());
+                if (solutionValueIt != solutionValues.end()) {
+                    result.optimum = solutionValueIt->second;
+                }
+            }
+            try {
+                writeResults(options, partialResults);
+            } catch (const std::invalid_argument &e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            std::_Exit(EXIT_TIMEOUT);
+        }
+    }
+    for (auto &workerThread : workers) {
+        workerThread.join();
+    }
+
+    int exitStatus = EXIT_OK;
+    for (auto &result : results) {
+        auto solutionValueIt = solutionValues.find(std::filesystem::path(result.instancePath).stem());
+        if (solutionValueIt != solutionValues.end()) {
+            result.optimum = solutionValueIt->second;
+        }
+        if (result.status != CommandLineResult::Status::Solved) {
+            exitStatus = EXIT_FAILURE_SOLVE;
+        }
+    }
+    try {
+        writeResults(options, results);
+    } catch (const std::invalid_argument &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE_SOLVE;
+    }
+    return exitStatus;
+}
+
+CommandLineOptions CommandLineDriver::parseArguments(const std::vector<std::string> &arguments) {
+    CommandLineOptions options;
+    bool isSolverSet = false;
+
+    for (int argIdx = 0; argIdx < arguments.size(); ++argIdx) {
+        std::string option = arguments[argIdx];
+        std::string value;
+        bool hasInlineValue = false;
+        if (option.rfind("--", 0) == 0 && option.find('=') != std::string::npos) {
+            value = option.substr(option.find('=') + 1);
+            option = option.substr(0, option.find('='));
+            hasInlineValue = true;
+        }
+        auto getValue = [&]() -> std::string {
+            if (hasInlineValue) {
+                return value;
+            }
+            if (argIdx + 1 >= arguments.size()) {
+                throw std::invalid_argument("Option " + option + " requires a value");
+            }
+            return arguments[++argIdx];
+        };
+
+        if (option == "-h" || option == "--help") {
+            options.isHelpRequested = true;
+        } else if (option == "-l" || option == "--list-solvers") {
+            options.isSolverListRequested = true;
+        } else if (option == "-s" || option == "--solver") {
+            options.solverName = getValue();
+            isSolverSet = true;
+        } else if (option == "-i" || option == "--instance") {
+            options.instancePaths.emplace_back(getValue());
+        } else if (option == "-p" || option == "--param") {
+            const std::string parameter = getValue();
+            const std::size_t separatorPos = parameter.find('=');
+            if (separatorPos == std::string::npos || separatorPos == 0) {
+                throw std::invalid_argument("Parameter \"" + parameter + "\" is not in form NAME=VALUE");
+            }
+            options.solverParameters[parameter.substr(0, separatorPos)] = parameter.substr(separatorPos + 1);
+        } else if (option == "--solutions") {
+            options.solutionsPath = getValue();
+        } else if (option == "--type") {
+            const std::string type = getValue();
+            if (type == "auto") {
+                options.instanceType = CommandLineOptions::InstanceType::Auto;
+            } else if (type == "atsp") {
+                options.instanceType = CommandLineOptions::InstanceType::Asymmetric;
+            } else if (type == "tsp") {
+                options.instanceType = CommandLineOptions::InstanceType::Symmetric;
+            } else {
+                throw std::invalid_argument("Unknown instance type \"" + type + "\"");
+            }
+        } else if (option == "-t" || option == "--threads") {
+            options.nThreads = parseNonNegativeInt(option, getValue());
+            if (options.nThreads == 0) {
+                options.nThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            }
+        } else if (option == "--seed") {
+            options.seed = static_cast<unsigned int>(parseNonNegativeInt(option, getValue()));
+            options.isSeedSet = true;
+        } else if (option == "--time-limit") {
+            options.timeLimitMs = parseNonNegativeInt(option, getValue());
+        } else if (option == "-f" || option == "--format") {
+            const std::string format = getValue();
+            if (format == "csv") {
+                options.outputFormat = CommandLineOptions::OutputFormat::CSV;
+            } else if (format == "json") {
+                options.outputFormat = CommandLineOptions::OutputFormat::JSON;
+            } else {
+                throw std::invalid_argument("Unknown output format \"" + format + "\"");
+            }
+        } else if (option == "-o" || option == "--output") {
+            options.outputPath = getValue();
+        } else if (option == "-c" || option == "--context") {
+            options.isInstanceContextUsed = true;
+        } else if (!option.empty() && option[0] == '-') {
+            throw std::invalid_argument("Unknown option " + option);
+        } else {
+            options.instancePaths.emplace_back(option);
+        }
+    }
+
+    if (options.isHelpRequested || options.isSolverListRequested) {
+        return options;
+    }
+    if (!isSolverSet) {
+        throw std::invalid_argument("No solver given (--solver)");
+    }
+    if (options.instancePaths.empty()) {
+        throw std::invalid_argument("No instance given (--instance)");
+    }
+    return options;
+}
+
+void CommandLineDriver::printUsage(std::ostream &ostr, const std::string &programName) {
+    ostr << "Usage: " << programName << " --solver NAME [options] INSTANCE..." << std::endl
+         << std::endl
+         << "Options:" << std::endl
+         << "  -s, --solver NAME        solver to run (see --list-solvers)" << std::endl
+         << "  -i, --instance PATH      instance file, may be repeated (paths may also be given as arguments)"
+         << std::endl
+         << "  -p, --param NAME=VALUE   solver parameter, may be repeated (defaults: best known parameters)"
+         << std::endl
+         << "      --solutions FILE     optimal values file (best.txt format) - adds relative error" << std::endl
+         << "      --type auto|atsp|tsp instance type (default: auto - detected from the matrix)" << std::endl
+         << "  -t, --threads N          number of instances solved concurrently (0 - all hardware threads)"
+         << std::endl
+         << "      --seed N             seed of the random engine (instance i uses N + i)" << std::endl
+         << "      --time-limit MS      per instance; stochastic solvers are restarted until it is used up,"
+         << std::endl
+         << "                           overrunning solves end the whole run with status 3" << std::endl
+         << "  -f, --format csv|json    output format (default: csv)" << std::endl
+         << "  -o, --output FILE        output file (default: standard output)" << std::endl
+         << "  -c, --context            reuse precomputed instance data stored in INSTANCE.ctx (created when"
+         << std::endl
+         << "                           missing or stale, not counted in the solve time)" << std::endl
+         << "  -l, --list-solvers       print available solvers and their parameters" << std::endl
+         << "  -h, --help               print this message" << std::endl
+         << std::endl
+         << "Exit status: 0 - all solved, 1 - load/solve error or invalid solution, 2 - usage error, "
+         << "3 - time limit exceeded" << std::endl;
+}
+
+void CommandLineDriver::printSolvers(std::ostream &ostr) {
+    for (const auto &solverInfo : SolverRegistry::getSolvers()) {
+        ostr << std::left << std::setw(12) << solverInfo.name << solverInfo.description
+             << (solverInfo.isStochastic ? " [stochastic]" : "") << std::endl;
+        if (!solverInfo.parameterNames.empty()) {
+            ostr << std::setw(12) << "" << "parameters:";
+            for (const auto &parameterName : solverInfo.parameterNames) {
+                ostr << " " << parameterName;
+            }
+            ostr << std::endl;
+        }
+    }
+}
+
+void CommandLineDriver::solveInstance(const CommandLineOptions &options, const SolverRegistry::fSolver &solver,
+                                      bool isStochastic, int instanceIdx, CommandLineResult &outResult) {
+    const std::string &instancePath = options.instancePaths[instanceIdx];
+    outResult.instancePath = instancePath;
+
+    IGraph *tspInstance = nullptr;
+    try {
+        TSPUtils::TSPType tspType;
+        if (options.instanceType == CommandLineOptions::InstanceType::Auto) {
+            tspType = TSPUtils::getTSPTypeAbsolutePath(instancePath);
+        } else if (options.instanceType == CommandLineOptions::InstanceType::Asymmetric) {
+            tspType = TSPUtils::TSPType::Asymmetric;
+        } else {
+            tspType = TSPUtils::TSPType::Symmetric;
+        }
+        outResult.instanceName = TSPUtils::loadTSPInstanceAbsolutePath(&tspInstance, instancePath, tspType);
+        outResult.instanceSize = tspInstance->getVertexCount();
+
+        if (options.isSeedSet) {
+            Random::setSeed(options.seed + instanceIdx);
+        }
+
+        SolverRegistry::fSolver instanceSolver = solver;
+        if (options.isInstanceContextUsed) {
+            instanceSolver = SolverRegistry::createSolver(
+                    options.solverName, options.solverParameters,
+                    InstanceContext::loadOrCreate(instancePath + ".ctx", tspInstance));
+        }
+
+        const auto solveStart = std::chrono::steady_clock::now();
+        outResult.value = SolverRegistry::solveWithinTimeLimit(instanceSolver, isStochastic, tspInstance,
+                                                               options.timeLimitMs, outResult.solution,
+                                                               outResult.nRuns);
+        outResult.timeMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - solveStart).count();
+
+        if (TSPUtils::isSolutionValid(tspInstance, outResult.solution, outResult.value)) {
+            outResult.status = CommandLineResult::Status::Solved;
+        } else {
+            outResult.status = CommandLineResult::Status::Invalid;
+            outResult.message = "Solver returned an invalid solution";
+        }
+    } catch (const std::exception &e) {
+        outResult.status = CommandLineResult::Status::Error;
+        outResult.message = e.what();
+    }
+    delete tspInstance;
+}
+
+void CommandLineDriver::writeResults(const CommandLineOptions &options,
+                                     const std::vector<CommandLineResult> &results) {
+    std::ofstream file;
+    if (!options.outputPath.empty()) {
+        file.open(options.outputPath);
+        if (!file.is_open()) {
+            throw std::invalid_argument("Output file " + options.outputPath + " cannot be opened");
+        }
+    }
+    std::ostream &ostr = options.outputPath.empty() ? std::cout : file;
+    if (options.outputFormat == CommandLineOptions::OutputFormat::CSV) {
+        writeResultsCSV(ostr, options, results);
+    } else {
+        writeResultsJSON(ostr, options, results);
+    }
+    ostr.flush();
+}
+
+void CommandLineDriver::writeResultsCSV(std::ostream &ostr, const CommandLineOptions &options,
+                                        const std::vector<CommandLineResult> &results) {
+    auto quote = [](const std::string &field) -> std::string {
+        if (field.find_first_of(",\"\n") == std::string::npos) {
+            return field;
+        }
+        std::string quoted = "\"";
+        for (char c : field) {
+            if (c == '"') {
+                quoted += '"';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    };
+
+    ostr << "instance,name,size,solver,value,optimum,relative_error_percent,time_ms,runs,status,message,solution"
+         << std::endl;
+    for (const auto &result : results) {
+        ostr << quote(result.instancePath) << "," << quote(result.instanceName) << "," << result.instanceSize << ","
+             << options.solverName << "," << result.value << "," << result.optimum << ",";
+        if (result.optimum > 0 && result.status == CommandLineResult::Status::Solved) {
+            ostr << 100.0 * (result.value - result.optimum) / result.optimum;
+        }
+        ostr << "," << result.timeMs << "," << result.nRuns << "," << toString(result.status) << ","
+             << quote(result.message) << ",";
+        for (int vertexIdx = 0; vertexIdx < result.solution.size(); ++vertexIdx) {
+            ostr << (vertexIdx == 0 ? "" : " ") << result.solution[vertexIdx];
+        }
+        ostr << std::endl;
+    }
+}
+
+void CommandLineDriver::writeResultsJSON(std::ostream &ostr, const CommandLineOptions &options,
+                                         const std::vector<CommandLineResult> &results) {
+    ostr << "{" << std::endl;
+    ostr << "  \"solver\": \"" << JSONValue::escape(options.solverName) << "\"," << std::endl;
+    ostr << "  \"parameters\": {";
+    bool isFirst = true;
+    for (const auto &parameter : options.solverParameters) {
+        ostr << (isFirst ? "" : ", ") << "\"" << JSONValue::escape(parameter.first) << "\": \""
+             << JSONValue::escape(parameter.second) << "\"";
+        isFirst = false;
+    }
+    ostr << "}," << std::endl;
+    ostr << "  \"threads\": " << options.nThreads << "," << std::endl;
+    ostr << "  \"seed\": ";
+    if (options.isSeedSet) {
+        ostr << options.seed;
+    } else {
+        ostr << "null";
+    }
+    ostr << "," << std::endl;
+    ostr << "  \"timeLimitMs\": ";
+    if (options.timeLimitMs > 0) {
+        ostr << options.timeLimitMs;
+    } else {
+        ostr << "null";
+    }
+    ostr << "," << std::endl;
+    ostr << "  \"results\": [";
+    for (int resultIdx = 0; resultIdx < results.size(); ++resultIdx) {
+        const CommandLineResult &result = results[resultIdx];
+        ostr << (resultIdx == 0 ? "" : ",") << std::endl;
+        ostr << "    {\"instance\": \"" << JSONValue::escape(result.instancePath) << "\", \"name\": \""
+             << JSONValue::escape(result.instanceName) << "\", \"size\": " << result.instanceSize
+             << ", \"value\": " << result.value << ", \"optimum\": ";
+        if (result.optimum >= 0) {
+            ostr << result.optimum;
+        } else {
+            ostr << "null";
+        }
+        ostr << ", \"relativeErrorPercent\": ";
+        if (result.optimum > 0 && result.status == CommandLineResult::Status::Solved) {
+            ostr << 100.0 * (result.value - result.optimum) / result.optimum;
+        } else {
+            ostr << "null";
+        }
+        ostr << ", \"timeMs\": " << result.timeMs << ", \"runs\": " << result.nRuns
+             << ", \"status\": \"" << toString(result.status) << "\", \"message\": \"" << JSONValue::escape(result.message)
+             << "\", \"solution\": [";
+        for (int vertexIdx = 0; vertexIdx < result.solution.size(); ++vertexIdx) {
+            ostr << (vertexIdx == 0 ? "" : ", ") << result.solution[vertexIdx];
+        }
+        ostr << "]}";
+    }
+    ostr << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+std::string CommandLineDriver::toString(CommandLineResult::Status status) {
+    switch (status) {
+        case CommandLineResult::Status::Solved:
+            return "solved";
+        case CommandLineResult::Status::Invalid:
+            return "invalid";
+        case CommandLineResult::Status::Error:
+            return "error";
+        case CommandLineResult::Status::Timeout:
+            return "timeout";
+        case CommandLineResult::Status::NotStarted:
+            return "not_started";
+    }
+    return "";
+}
+
+int CommandLineDriver::parseNonNegativeInt(const std::string &option, const std::string &value) {
+    std::size_t nParsed = 0;
+    int result = -1;
+    try {
+        result = std::stoi(value, &nParsed);
+    } catch (const std::logic_error &e) {
+        nParsed = 0;
+    }
+    if (nParsed == 0 || nParsed != value.size() || result < 0) {
+        throw std::invalid_argument("Option " + option + " expects a non-negative integer, got \"" + value + "\"");
+    }
+    return result;
+}
@@ -0,0 +1,114 @@
+#ifndef PEA_P1_COMMANDLINEDRIVER_H
+#define PEA_P1_COMMANDLINEDRIVER_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../algorithms/SolverRegistry.h"
+#include "../utilities/TSPUtils.h"
+
+struct CommandLineOptions {
+    enum class OutputFormat {
+        CSV, JSON
+    };
+
+    enum class InstanceType {
+        Auto, Asymmetric, Symmetric
+    };
+
+    std::string solverName;
+    std::map<std::string, std::string> solverParameters;
+    // Paths as given (relative to the working directory)
+    std::vector<std::string> instancePaths;
+    // Optional file in input_data/*/best.txt format - adds optimum and relative error to the output
+    std::string solutionsPath;
+    InstanceType instanceType;
+    int nThreads;
+    bool isSeedSet;
+    unsigned int seed;
+    // Per instance, <= 0 means no limit
+    int timeLimitMs;
+    OutputFormat outputFormat;
+    // Empty - standard output
+    std::string outputPath;
+    // Solvers get the InstanceContext stored next to the instance as <path>.ctx (created when missing or stale)
+    bool isInstanceContextUsed;
+    bool isHelpRequested;
+    bool isSolverListRequested;
+
+    CommandLineOptions() : instanceType(InstanceType::Auto), nThreads(1), isSeedSet(false), seed(0),
+                           timeLimitMs(-1), outputFormat(OutputFormat::CSV), isInstanceContextUsed(false),
+                           isHelpRequested(false),
+                           isSolverListRequested(false) {}
+};
+
+struct CommandLineResult {
+    enum class Status {
+        Solved, Invalid, Error, Timeout, NotStarted
+    };
+
+    std::string instancePath;
+    std::string instanceName;
+    int instanceSize;
+    int value;
+    // -1 if unknown
+    int optimum;
+    double timeMs;
+    // Number of finished solver runs (stochastic solvers are restarted while time limit allows)
+    int nRuns;
+    Status status;
+    std::string message;
+    std::vector<int> solution;
+
+    CommandLineResult() : instanceSize(-1), value(-1), optimum(-1), timeMs(0), nRuns(0),
+                          status(Status::NotStarted) {}
+};
+
+// Non-interactive entry point: solver, instances and parameters come from the arguments, results are written
+// as CSV or JSON. See printUsage for the options.
+class CommandLineDriver {
+public:
+
+    enum ExitStatus {
+        EXIT_OK = 0,
+        // At least one instance could not be loaded or solved, or the solution was invalid
+        EXIT_FAILURE_SOLVE = 1,
+        EXIT_USAGE = 2,
+        // Solvers cannot be interrupted - results collected so far are written and the process exits
+        EXIT_TIMEOUT = 3
+    };
+
+    int run(int argc, char **argv) const;
+
+    // Throws std::invalid_argument on unknown option or invalid value
+    [[nodiscard]] static CommandLineOptions parseArguments(const std::vector<std::string> &arguments);
+
+    static void printUsage(std::ostream &ostr, const std::string &programName);
+
+    static void printSolvers(std::ostream &ostr);
+
+private:
+
+    // Time a solve may run past its limit before it is reported as a timeout
+    static const int TIMEOUT_GRACE_MS = 100;
+
+    static void solveInstance(const CommandLineOptions &options, const SolverRegistry::fSolver &solver,
+                              bool isStochastic, int instanceIdx, CommandLineResult &outResult);
+
+    static void writeResults(const CommandLineOptions &options, const std::vector<CommandLineResult> &results);
+
+    static void writeResultsCSV(std::ostream &ostr, const CommandLineOptions &options,
+                                const std::vector<CommandLineResult> &results);
+
+    static void writeResultsJSON(std::ostream &ostr, const CommandLineOptions &options,
+                                 const std::vector<CommandLineResult> &results);
+
+    static std::string toString(CommandLineResult::Status status);
+
+    static int parseNonNegativeInt(const std::string &option, const std::string &value);
+};
+
+
+#endif //PEA_P1_COMMANDLINEDRIVER_H
@@ -0,0 +1,7 @@
+#include "CommandLineDriver.h"
+
+
+int main(int argc, char **argv) {
+    CommandLineDriver commandLineDriver;
+    return commandLineDriver.run(argc, argv);
+}
@@ -0,0 +1,256 @@
+#include "DaemonProtocol.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "../utilities/BinaryStream.h"
+#include "../utilities/JSON.h"
+
+DaemonRequest DaemonProtocol::decodeRequest(const std::string &payload) {
+    if (!payload.empty() && static_cast<std::uint8_t>(payload[0]) == BINARY_MAGIC) {
+        return decodeBinaryRequest(payload);
+    }
+    return decodeJSONRequest(payload);
+}
+
+std::string DaemonProtocol::encodeRequest(const DaemonRequest &request) {
+    if (request.isBinary) {
+        BinaryWriter writer;
+        writer.writeUInt8(BINARY_MAGIC);
+        writer.writeUInt8(static_cast<std::uint8_t>(request.command));
+        if (request.command != DaemonRequest::Command::Solve) {
+            return writer.getBuffer();
+        }
+        writer.writeString(request.solverName);
+        writer.writeUInt32(static_cast<std::uint32_t>(request.solverParameters.size()));
+        for (const auto &parameter : request.solverParameters) {
+            writer.writeString(parameter.first);
+            writer.writeString(parameter.second);
+        }
+        writer.writeInt32(request.timeLimitMs);
+        writer.writeUInt8(request.isSeedSet ? 1 : 0);
+        writer.writeUInt32(request.seed);
+        if (request.matrix.empty()) {
+            writer.writeUInt8(0);
+            writer.writeString(request.instancePath);
+        } else {
+            writer.writeUInt8(1);
+            writer.writeString(request.instanceName);
+            writer.writeUInt32(static_cast<std::uint32_t>(request.matrix.size()));
+            for (const auto &row : request.matrix) {
+                if (row.size() != request.matrix.size()) {
+                    throw std::invalid_argument("Matrix is not square");
+                }
+                for (int value : row) {
+                    writer.writeInt32(value);
+                }
+            }
+        }
+        return writer.getBuffer();
+    }
+
+    std::ostringstream json;
+    json << "{\"command\": \"";
+    if (request.command == DaemonRequest::Command::Stats) {
+        json << "stats\"}";
+        return json.str();
+    } else if (request.command == DaemonRequest::Command::Shutdown) {
+        json << "shutdown\"}";
+        return json.str();
+    }
+    json << "solve\", \"solver\": \"" << JSONValue::escape(request.solverName) << "\", \"parameters\": {";
+    bool isFirst = true;
+    for (const auto &parameter : request.solverParameters) {
+        json << (isFirst ? "" : ", ") << "\"" << JSONValue::escape(parameter.first) << "\": \""
+             << JSONValue::escape(parameter.second) << "\"";
+        isFirst = false;
+    }
+    json << "}, \"timeLimitMs\": " << request.timeLimitMs;
+    if (request.isSeedSet) {
+        json << ", \"seed\": " << request.seed;
+    }
+    if (request.matrix.empty()) {
+        json << ", \"instance\": \"" << JSONValue::escape(request.instancePath) << "\"";
+    } else {
+        json << ", \"name\": \"" << JSONValue::escape(request.instanceName) << "\", \"matrix\": [";
+        for (int i = 0; i < request.matrix.size(); ++i) {
+            json << (i == 0 ? "[" : ", [");
+            for (int j = 0; j < request.matrix[i].size(); ++j) {
+                json << (j == 0 ? "" : ", ") << request.matrix[i][j];
+            }
+            json << "]";
+        }
+        json << "]";
+    }
+    json << "}";
+    return json.str();
+}
+
+DaemonResponse DaemonProtocol::decodeResponse(const std::string &payload) {
+    if (!payload.empty() && static_cast<std::uint8_t>(payload[0]) == BINARY_MAGIC) {
+        return decodeBinaryResponse(payload);
+    }
+    return decodeJSONResponse(payload);
+}
+
+std::string DaemonProtocol::encodeResponse(const DaemonResponse &response, bool isBinary) {
+    if (isBinary) {
+        BinaryWriter writer;
+        writer.writeUInt8(BINARY_MAGIC);
+        writer.writeUInt8(response.isOk ? 1 : 0);
+        writer.writeString(response.message);
+        writer.writeString(response.instanceName);
+        writer.writeInt32(response.instanceSize);
+        writer.writeInt32(response.value);
+        writer.writeDouble(response.timeMs);
+        writer.writeInt32(response.nRuns);
+        writer.writeUInt8(response.isCacheHit ? 1 : 0);
+        writer.writeInt32Vector(response.solution);
+        return writer.getBuffer();
+    }
+
+    std::ostringstream json;
+    json << "{\"status\": \"" << (response.isOk ? "ok" : "error") << "\", \"message\": \""
+         << JSONValue::escape(response.message) << "\", \"name\": \"" << JSONValue::escape(response.instanceName)
+         << "\", \"size\": " << response.instanceSize << ", \"value\": " << response.value
+         << ", \"timeMs\": " << response.timeMs << ", \"runs\": " << response.nRuns
+         << ", \"cacheHit\": " << (response.isCacheHit ? "true" : "false") << ", \"solution\": [";
+    for (int vertexIdx = 0; vertexIdx < response.solution.size(); ++vertexIdx) {
+        json << (vertexIdx == 0 ? "" : ", ") << response.solution[vertexIdx];
+    }
+    json << "]}";
+    return json.str();
+}
+
+DaemonRequest DaemonProtocol::decodeJSONRequest(const std::string &payload) {
+    const JSONValue document = JSONValue::parse(payload);
+    DaemonRequest request;
+    request.isBinary = false;
+
+    const std::string command = document.contains("command") ? document.at("command").getString() : "solve";
+    if (command == "stats") {
+        request.command = DaemonRequest::Command::Stats;
+        return request;
+    } else if (command == "shutdown") {
+        request.command = DaemonRequest::Command::Shutdown;
+        return request;
+    } else if (command != "solve") {
+        throw std::invalid_argument("Unknown command \"" + command + "\"");
+    }
+
+    request.command = DaemonRequest::Command::Solve;
+    request.solverName = document.at("solver").getString();
+    if (document.contains("parameters")) {
+        for (const auto &parameter : document.at("parameters").getObject()) {
+            if (parameter.second.getType() == JSONValue::Type::Number) {
+                std::ostringstream number;
+                number << parameter.second.getNumber();
+                request.solverParameters[parameter.first] = number.str();
+            } else {
+                request.solverParameters[parameter.first] = parameter.second.getString();
+            }
+        }
+    }
+    if (document.contains("timeLimitMs")) {
+        request.timeLimitMs = document.at("timeLimitMs").getInt();
+    }
+    if (document.contains("seed") && !document.at("seed").isNull()) {
+        request.seed = static_cast<unsigned int>(document.at("seed").getNumber());
+        request.isSeedSet = true;
+    }
+    if (document.contains("name")) {
+        request.instanceName = document.at("name").getString();
+    }
+    if (document.contains("matrix")) {
+        for (const auto &row : document.at("matrix").getArray()) {
+            request.matrix.emplace_back();
+            for (const auto &value : row.getArray()) {
+                request.matrix.back().emplace_back(value.getInt());
+            }
+        }
+        if (request.matrix.empty()) {
+            throw std::invalid_argument("Empty matrix");
+        }
+    } else {
+        request.instancePath = document.at("instance").getString();
+    }
+    return request;
+}
+
+DaemonRequest DaemonProtocol::decodeBinaryRequest(const std::string &payload) {
+    BinaryReader reader(payload);
+    DaemonRequest request;
+    request.isBinary = true;
+
+    reader.readUInt8();
+    const std::uint8_t command = reader.readUInt8();
+    if (command > static_cast<std::uint8_t>(DaemonRequest::Command::Shutdown)) {
+        throw std::invalid_argument("Unknown command " + std::to_string(command));
+    }
+    request.command = static_cast<DaemonRequest::Command>(command);
+    if (request.command != DaemonRequest::Command::Solve) {
+        return request;
+    }
+
+    request.solverName = reader.readString();
+    const std::uint32_t nParameters = reader.readUInt32();
+    for (std::uint32_t parameterIdx = 0; parameterIdx < nParameters; ++parameterIdx) {
+        std::string name = reader.readString();
+        request.solverParameters[name] = reader.readString();
+    }
+    request.timeLimitMs = reader.readInt32();
+    request.isSeedSet = reader.readUInt8() != 0;
+    request.seed = reader.readUInt32();
+    const std::uint8_t instanceKind = reader.readUInt8();
+    if (instanceKind == 0) {
+        request.instancePath = reader.readString();
+    } else if (instanceKind == 1) {
+        request.instanceName = reader.readString();
+        const std::uint32_t instanceSize = reader.readUInt32();
+        if (instanceSize == 0 || static_cast<std::uint64_t>(instanceSize) * instanceSize > reader.getRemainingSize() / 4) {
+            throw std::invalid_argument("Invalid matrix size " + std::to_string(instanceSize));
+        }
+        request.matrix.assign(instanceSize, std::vector<int>(instanceSize));
+        for (auto &row : request.matrix) {
+            for (auto &value : row) {
+                value = reader.readInt32();
+            }
+        }
+    } else {
+        throw std::invalid_argument("Unknown instance kind " + std::to_string(instanceKind));
+    }
+    return request;
+}
+
+DaemonResponse DaemonProtocol::decodeJSONResponse(const std::string &payload) {
+    const JSONValue document = JSONValue::parse(payload);
+    DaemonResponse response;
+    response.isOk = document.at("status").getString() == "ok";
+    response.message = document.at("message").getString();
+    response.instanceName = document.at("name").getString();
+    response.instanceSize = document.at("size").getInt();
+    response.value = document.at("value").getInt();
+    response.timeMs = document.at("timeMs").getNumber();
+    response.nRuns = document.at("runs").getInt();
+    response.isCacheHit = document.at("cacheHit").getBool();
+    for (const auto &vertex : document.at("solution").getArray()) {
+        response.solution.emplace_back(vertex.getInt());
+    }
+    return response;
+}
+
+DaemonResponse DaemonProtocol::decodeBinaryResponse(const std::string &payload) {
+    BinaryReader reader(payload);
+    DaemonResponse response;
+    reader.readUInt8();
+    response.isOk = reader.readUInt8() != 0;
+    response.message = reader.readString();
+    response.instanceName = reader.readString();
+    response.instanceSize = reader.readInt32();
+    response.value = reader.readInt32();
+    response.timeMs = reader.readDouble();
+    response.nRuns = reader.readInt32();
+    response.isCacheHit = reader.readUInt8() != 0;
+    response.solution = reader.readInt32Vector();
+    return response;
+}
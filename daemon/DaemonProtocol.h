@@ -0,0 +1,91 @@
+#ifndef PEA_P1_DAEMONPROTOCOL_H
+#define PEA_P1_DAEMONPROTOCOL_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Messages exchanged with SolverDaemon, one per Socket frame. A payload starting with DaemonProtocol::BINARY_MAGIC
+// is binary, anything else is parsed as JSON. The response uses the format of the request.
+//
+// JSON request:
+//   {"command": "solve", "instance": "<path on the daemon side>" | "matrix": [[...], ...], "name": "<optional>",
+//    "solver": "sa", "parameters": {"iterationsNumber": "100"}, "timeLimitMs": 1000, "seed": 1}
+//   {"command": "stats"} / {"command": "shutdown"}
+// JSON response:
+//   {"status": "ok" | "error", "message": "...", "name": "...", "size": n, "value": v, "timeMs": t, "runs": r,
+//    "cacheHit": true, "solution": [...]}
+//
+// Binary request (little-endian, strings as uint32 length + bytes):
+//   u8 BINARY_MAGIC, u8 command
+//   solve only: string solver, u32 nParameters, nParameters * (string name, string value), i32 timeLimitMs,
+//               u8 isSeedSet, u32 seed, u8 instanceKind (0 - path, 1 - matrix),
+//               path: string path | matrix: string name, u32 n, n * n i32 (row-major, diagonal ignored)
+// Binary response:
+//   u8 BINARY_MAGIC, u8 isOk, string message, string name, i32 size, i32 value, f64 timeMs, i32 runs,
+//   u8 isCacheHit, u32 n, n * i32 solution
+struct DaemonRequest {
+    enum class Command : std::uint8_t {
+        Solve = 0, Stats = 1, Shutdown = 2
+    };
+
+    Command command;
+    bool isBinary;
+    std::string solverName;
+    std::map<std::string, std::string> solverParameters;
+    // <= 0 - single run
+    int timeLimitMs;
+    bool isSeedSet;
+    unsigned int seed;
+    // Exactly one of instancePath / matrix is used (command Solve)
+    std::string instancePath;
+    std::vector<std::vector<int>> matrix;
+    std::string instanceName;
+
+    DaemonRequest() : command(Command::Solve), isBinary(false), timeLimitMs(-1), isSeedSet(false), seed(0) {}
+};
+
+struct DaemonResponse {
+    bool isOk;
+    std::string message;
+    std::string instanceName;
+    int instanceSize;
+    int value;
+    double timeMs;
+    int nRuns;
+    bool isCacheHit;
+    std::vector<int> solution;
+
+    DaemonResponse() : isOk(false), instanceSize(-1), value(-1), timeMs(0), nRuns(0), isCacheHit(false) {}
+};
+
+class DaemonProtocol {
+public:
+
+    static const std::uint8_t BINARY_MAGIC = 0xB1;
+
+    // Decoders throw std::invalid_argument (std::out_of_range for truncated binary data) on malformed input
+
+    static DaemonRequest decodeRequest(const std::string &payload);
+
+    static std::string encodeRequest(const DaemonRequest &request);
+
+    static DaemonResponse decodeResponse(const std::string &payload);
+
+    static std::string encodeResponse(const DaemonResponse &response, bool isBinary);
+
+private:
+    DaemonProtocol() = default;
+
+    static DaemonRequest decodeJSONRequest(const std::string &payload);
+
+    static DaemonRequest decodeBinaryRequest(const std::string &payload);
+
+    static DaemonResponse decodeJSONResponse(const std::string &payload);
+
+    static DaemonResponse decodeBinaryResponse(const std::string &payload);
+};
+
+
+#endif //PEA_P1_DAEMONPROTOCOL_H
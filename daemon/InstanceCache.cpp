@@ -0,0 +1,70 @@
+#include "InstanceCache.h"
+
+#include <stdexcept>
+
+CachedInstance::CachedInstance(std::string name, IGraph *tspInstance, std::vector<std::vector<int>> matrix)
+        : name(std::move(name)), tspInstance(tspInstance),
+          instanceContext(std::make_shared<const InstanceContext>(tspInstance)), matrix(std::move(matrix)) {}
+
+InstanceCache::InstanceCache(int capacity) : capacity(capacity), nHits(0), nMisses(0) {
+    if (capacity < 1) {
+        throw std::invalid_argument("Instance cache capacity must be positive");
+    }
+}
+
+std::shared_ptr<const CachedInstance>
+InstanceCache::get(const std::string &key, const InstanceCache::fLoader &load, bool &outIsHit,
+                   const InstanceCache::fMatcher &isMatch) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto entryIt = entryIterators.find(key);
+        if (entryIt != entryIterators.end() && (!isMatch || isMatch(*entryIt->second->second))) {
+            entries.splice(entries.begin(), entries, entryIt->second);
+            ++nHits;
+            outIsHit = true;
+            return entryIt->second->second;
+        }
+        ++nMisses;
+    }
+
+    outIsHit = false;
+    std::shared_ptr<const CachedInstance> loadedInstance = load();
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto entryIt = entryIterators.find(key);
+    if (entryIt != entryIterators.end()) {
+        entries.splice(entries.begin(), entries, entryIt->second);
+        if (!isMatch || isMatch(*entryIt->second->second)) {
+            return entryIt->second->second;
+        }
+        entryIt->second->second = loadedInstance;
+        return loadedInstance;
+    }
+    entries.emplace_front(key, loadedInstance);
+    entryIterators[key] = entries.begin();
+    if (entries.size() > capacity) {
+        // Solves in progress keep their shared_ptr - eviction only drops the cache reference
+        entryIterators.erase(entries.back().first);
+        entries.pop_back();
+    }
+    return loadedInstance;
+}
+
+int InstanceCache::getSize() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return static_cast<int>(entries.size());
+}
+
+int InstanceCache::getCapacity() const {
+    return capacity;
+}
+
+long long InstanceCache::getHitCount() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return nHits;
+}
+
+long long InstanceCache::getMissCount() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return nMisses;
+}
@@ -0,0 +1,63 @@
+#ifndef PEA_P1_INSTANCECACHE_H
+#define PEA_P1_INSTANCECACHE_H
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../structures/graphs/IGraph.h"
+#include "../algorithms/InstanceContext.h"
+
+// Parsed instance with its InstanceContext, shared read-only between concurrent solves
+struct CachedInstance {
+    std::string name;
+    std::unique_ptr<IGraph> tspInstance;
+    std::shared_ptr<const InstanceContext> instanceContext;
+    // Inline instances only - the request matrix, compared on cache hits since the key is only its hash
+    std::vector<std::vector<int>> matrix;
+
+    // Takes ownership of tspInstance
+    CachedInstance(std::string name, IGraph *tspInstance, std::vector<std::vector<int>> matrix = {});
+};
+
+// Least recently used instances, keyed by "file:<path>" or "matrix:<content hash>"
+class InstanceCache {
+public:
+
+    using fLoader = std::function<std::shared_ptr<const CachedInstance>()>;
+    using fMatcher = std::function<bool(const CachedInstance &)>;
+
+    explicit InstanceCache(int capacity);
+
+    // Loader is called without the lock held; two concurrent misses of one key may both load, the first insert
+    // wins. Exceptions from the loader are propagated and nothing is cached. If isMatch is set, a cached instance
+    // it rejects (key collision) counts as a miss and is replaced by the loaded one.
+    std::shared_ptr<const CachedInstance> get(const std::string &key, const fLoader &load, bool &outIsHit,
+                                              const fMatcher &isMatch = nullptr);
+
+    [[nodiscard]] int getSize() const;
+
+    [[nodiscard]] int getCapacity() const;
+
+    [[nodiscard]] long long getHitCount() const;
+
+    [[nodiscard]] long long getMissCount() const;
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const CachedInstance>>;
+
+    const int capacity;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entryIterators;
+    long long nHits;
+    long long nMisses;
+    mutable std::mutex cacheMutex;
+};
+
+
+#endif //PEA_P1_INSTANCECACHE_H
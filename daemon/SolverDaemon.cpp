@@ -0,0 +1,199 @@
+#include "SolverDaemon.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include <sys/socket.h>
+
+#include "../algorithms/SolverRegistry.h"
+#include "../utilities/Random.h"
+#include "../utilities/TSPUtils.h"
+#include "../utilities/Trace.h"
+
+SolverDaemon::SolverDaemon(std::string socketPath, int nWorkers, int cacheCapacity)
+        : socketPath(std::move(socketPath)), instanceCache(cacheCapacity), workerPool(nWorkers),
+          isShutdownRequested(false) {}
+
+SolverDaemon::~SolverDaemon() {
+    requestShutdown();
+    std::map<std::thread::id, std::thread> threadsToJoin;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        threadsToJoin.swap(connectionThreads);
+    }
+    for (auto &connectionThread : threadsToJoin) {
+        connectionThread.second.join();
+    }
+}
+
+void SolverDaemon::run() {
+    ServerSocket serverSocket = ServerSocket::listenUnix(socketPath);
+    std::cout << "Listening on " << socketPath << " (" << workerPool.getThreadCount() << " workers, cache of "
+              << instanceCache.getCapacity() << " instances)" << std::endl;
+
+    while (!isShutdownRequested.load()) {
+        Socket connection = serverSocket.accept(ACCEPT_POLL_MS);
+        joinFinishedConnectionThreads();
+        if (!connection.isOpen()) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        connectionFds.insert(connection.getFd());
+        std::thread connectionThread(&SolverDaemon::handleConnection, this, std::move(connection));
+        const std::thread::id connectionThreadId = connectionThread.get_id();
+        connectionThreads.emplace(connectionThreadId, std::move(connectionThread));
+    }
+    serverSocket.close();
+
+    std::map<std::thread::id, std::thread> threadsToJoin;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (int fd : connectionFds) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        threadsToJoin.swap(connectionThreads);
+        finishedConnectionThreads.clear();
+    }
+    for (auto &connectionThread : threadsToJoin) {
+        connectionThread.second.join();
+    }
+    std::cout << "Stopped. " << getStats() << std::endl;
+}
+
+void SolverDaemon::requestShutdown() {
+    isShutdownRequested.store(true);
+}
+
+DaemonResponse SolverDaemon::solve(const DaemonRequest &request) {
+    TRACE_SCOPE("SolverDaemon::solve");
+    DaemonResponse response;
+    try {
+        const SolverRegistry::SolverInfo &solverInfo = SolverRegistry::getSolverInfo(request.solverName);
+        std::shared_ptr<const CachedInstance> cachedInstance;
+        if (request.matrix.empty()) {
+            const std::string &path = request.instancePath;
+            cachedInstance = instanceCache.get("file:" + path, [&path]() {
+                IGraph *tspInstance = nullptr;
+                const std::string instanceName = TSPUtils::loadTSPInstanceAbsolutePath(
+                        &tspInstance, path, TSPUtils::getTSPTypeAbsolutePath(path));
+                return std::make_shared<const CachedInstance>(instanceName, tspInstance);
+            }, response.isCacheHit);
+        } else {
+            const auto &matrix = request.matrix;
+            const std::string instanceName = request.instanceName.empty() ? "matrix" : request.instanceName;
+            cachedInstance = instanceCache.get(getMatrixCacheKey(matrix), [&matrix, &instanceName]() {
+                IGraph *tspInstance = nullptr;
+                TSPUtils::createTSPInstance(&tspInstance, matrix, TSPUtils::getTSPType(matrix));
+                return std::make_shared<const CachedInstance>(instanceName, tspInstance, matrix);
+            }, response.isCacheHit, [&matrix](const CachedInstance &cached) {
+                return cached.matrix == matrix;
+            });
+        }
+        response.instanceName = cachedInstance->name;
+        response.instanceSize = cachedInstance->tspInstance->getVertexCount();
+        SolverRegistry::fSolver solver = SolverRegistry::createSolver(request.solverName, request.solverParameters,
+                                                                      cachedInstance->instanceContext);
+
+        if (request.isSeedSet) {
+            Random::setSeed(request.seed);
+        }
+        const auto solveStart = std::chrono::steady_clock::now();
+        response.value = SolverRegistry::solveWithinTimeLimit(solver, solverInfo.isStochastic,
+                                                              cachedInstance->tspInstance.get(), request.timeLimitMs,
+                                                              response.solution, response.nRuns);
+        response.timeMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - solveStart).count();
+        response.isOk = true;
+    } catch (const std::exception &e) {
+        response.isOk = false;
+        response.message = e.what();
+    }
+    return response;
+}
+
+std::string SolverDaemon::getStats() const {
+    std::ostringstream stats;
+    stats << "cache " << instanceCache.getSize() << "/" << instanceCache.getCapacity() << ", hits "
+          << instanceCache.getHitCount() << ", misses " << instanceCache.getMissCount() << ", queued solves "
+          << workerPool.getQueuedTaskCount();
+    return stats.str();
+}
+
+void SolverDaemon::handleConnection(Socket connection) {
+    std::string payload;
+    try {
+        while (!isShutdownRequested.load() && connection.receiveFrame(payload)) {
+            DaemonRequest request;
+            DaemonResponse response;
+            const bool isBinary = !payload.empty()
+                                  && static_cast<std::uint8_t>(payload[0]) == DaemonProtocol::BINARY_MAGIC;
+            try {
+                request = DaemonProtocol::decodeRequest(payload);
+            } catch (const std::exception &e) {
+                response.message = std::string("Malformed request: ") + e.what();
+                connection.sendFrame(DaemonProtocol::encodeResponse(response, isBinary));
+                continue;
+            }
+
+            if (request.command == DaemonRequest::Command::Stats) {
+                response.isOk = true;
+                response.message = getStats();
+            } else if (request.command == DaemonRequest::Command::Shutdown) {
+                response.isOk = true;
+                response.message = "Shutting down";
+                requestShutdown();
+            } else {
+                workerPool.submit([this, &request, &response]() {
+                    response = solve(request);
+                }).get();
+            }
+            connection.sendFrame(DaemonProtocol::encodeResponse(response, request.isBinary));
+        }
+    } catch (const std::exception &e) {
+        // Broken connection - drop it, the daemon keeps running
+        std::cerr << "Connection error: " << e.what() << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connectionFds.erase(connection.getFd());
+    finishedConnectionThreads.emplace_back(std::this_thread::get_id());
+}
+
+void SolverDaemon::joinFinishedConnectionThreads() {
+    std::vector<std::thread> threadsToJoin;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (const auto &threadId : finishedConnectionThreads) {
+            auto threadIt = connectionThreads.find(threadId);
+            if (threadIt != connectionThreads.end()) {
+                threadsToJoin.emplace_back(std::move(threadIt->second));
+                connectionThreads.erase(threadIt);
+            }
+        }
+        finishedConnectionThreads.clear();
+    }
+    for (auto &connectionThread : threadsToJoin) {
+        connectionThread.join();
+    }
+}
+
+std::string SolverDaemon::getMatrixCacheKey(const std::vector<std::vector<int>> &matrix) {
+    // FNV-1a over the size and all entries
+    std::uint64_t hash = 14695981039346656037ull;
+    auto addToHash = [&hash](std::uint32_t value) {
+        for (int byteIdx = 0; byteIdx < 4; ++byteIdx) {
+            hash ^= (value >> (8 * byteIdx)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    addToHash(static_cast<std::uint32_t>(matrix.size()));
+    for (const auto &row : matrix) {
+        for (int value : row) {
+            addToHash(static_cast<std::uint32_t>(value));
+        }
+    }
+    std::ostringstream key;
+    key << "matrix:" << std::hex << hash;
+    return key.str();
+}
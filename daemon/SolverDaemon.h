@@ -0,0 +1,62 @@
+#ifndef PEA_P1_SOLVERDAEMON_H
+#define PEA_P1_SOLVERDAEMON_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DaemonProtocol.h"
+#include "InstanceCache.h"
+#include "../utilities/Socket.h"
+#include "../utilities/ThreadPool.h"
+
+// Long-running solver service on a Unix domain socket (protocol: DaemonProtocol.h). Every connection gets a thread
+// reading its requests in order; solves are executed by a shared worker pool, instances come from the LRU cache
+// so repeated requests skip loading and preprocessing.
+class SolverDaemon {
+public:
+
+    SolverDaemon(std::string socketPath, int nWorkers, int cacheCapacity);
+
+    ~SolverDaemon();
+
+    // Blocks until requestShutdown() is called (or a shutdown request is received)
+    void run();
+
+    // Safe to call from any thread; run() returns within ACCEPT_POLL_MS
+    void requestShutdown();
+
+    // Used by request handlers - solves synchronously in the calling thread
+    DaemonResponse solve(const DaemonRequest &request);
+
+    [[nodiscard]] std::string getStats() const;
+
+private:
+    static const int ACCEPT_POLL_MS = 200;
+
+    const std::string socketPath;
+    InstanceCache instanceCache;
+    ThreadPool workerPool;
+    std::atomic<bool> isShutdownRequested;
+
+    std::mutex connectionsMutex;
+    std::map<std::thread::id, std::thread> connectionThreads;
+    // Threads that returned from handleConnection - joined by the accept loop
+    std::vector<std::thread::id> finishedConnectionThreads;
+    // Descriptors of open connections - shut down to unblock their threads when the daemon stops
+    std::set<int> connectionFds;
+
+    void handleConnection(Socket connection);
+
+    void joinFinishedConnectionThreads();
+
+    static std::string getMatrixCacheKey(const std::vector<std::vector<int>> &matrix);
+};
+
+
+#endif //PEA_P1_SOLVERDAEMON_H
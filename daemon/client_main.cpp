@@ -0,0 +1,135 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "DaemonProtocol.h"
+#include "../utilities/Socket.h"
+#include "../utilities/TSPUtils.h"
+
+// Stand-in client of SolverDaemon - sends the same request --repeat times and prints the responses
+
+namespace {
+    void printUsage(const char *programName) {
+        std::cerr << "Usage: " << programName << " [--socket PATH] [--binary] (--stats | --shutdown |" << std::endl
+                  << "       --solver NAME (--instance PATH | --matrix-file PATH) [--param NAME=VALUE]..." << std::endl
+                  << "       [--time-limit MS] [--seed N] [--repeat N])" << std::endl
+                  << "  --instance PATH     instance file read by the daemon" << std::endl
+                  << "  --matrix-file PATH  instance file read here and sent inline" << std::endl;
+    }
+
+    void readMatrixFile(const std::string &path, DaemonRequest &request) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw std::invalid_argument("File " + path + " cannot be opened");
+        }
+        int nVertex;
+        file >> request.instanceName >> nVertex;
+        if (!file || nVertex <= 0) {
+            throw std::invalid_argument("File " + path + " is not an instance of TSP");
+        }
+        request.matrix.assign(nVertex, std::vector<int>(nVertex));
+        for (auto &row : request.matrix) {
+            for (auto &value : row) {
+                file >> value;
+            }
+        }
+        if (!file) {
+            throw std::invalid_argument("File " + path + " is not an instance of TSP");
+        }
+    }
+}
+
+
+int main(int argc, char **argv) {
+    std::string socketPath = "/tmp/pea_p1.sock";
+    DaemonRequest request;
+    int nRepeats = 1;
+
+    try {
+        for (int argIdx = 1; argIdx < argc; ++argIdx) {
+            const std::string option = argv[argIdx];
+            if (option == "-h" || option == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (option == "--binary") {
+                request.isBinary = true;
+                continue;
+            } else if (option == "--stats") {
+                request.command = DaemonRequest::Command::Stats;
+                continue;
+            } else if (option == "--shutdown") {
+                request.command = DaemonRequest::Command::Shutdown;
+                continue;
+            }
+            if (argIdx + 1 >= argc) {
+                throw std::invalid_argument("Option " + option + " requires a value");
+            }
+            const std::string value = argv[++argIdx];
+            if (option == "--socket") {
+                socketPath = value;
+            } else if (option == "-s" || option == "--solver") {
+                request.solverName = value;
+            } else if (option == "-i" || option == "--instance") {
+                request.instancePath = value;
+            } else if (option == "--matrix-file") {
+                readMatrixFile(value, request);
+            } else if (option == "-p" || option == "--param") {
+                const std::size_t separatorPos = value.find('=');
+                if (separatorPos == std::string::npos) {
+                    throw std::invalid_argument("Parameter \"" + value + "\" is not in form NAME=VALUE");
+                }
+                request.solverParameters[value.substr(0, separatorPos)] = value.substr(separatorPos + 1);
+            } else if (option == "--time-limit") {
+                request.timeLimitMs = std::stoi(value);
+            } else if (option == "--seed") {
+                request.seed = static_cast<unsigned int>(std::stoul(value));
+                request.isSeedSet = true;
+            } else if (option == "--repeat") {
+                nRepeats = std::stoi(value);
+            } else {
+                throw std::invalid_argument("Unknown option " + option);
+            }
+        }
+        if (request.command == DaemonRequest::Command::Solve
+            && (request.solverName.empty() || (request.instancePath.empty() && request.matrix.empty()))) {
+            throw std::invalid_argument("Solve request needs --solver and --instance or --matrix-file");
+        }
+    } catch (const std::logic_error &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int exitStatus = 0;
+    try {
+        Socket connection = Socket::connectUnix(socketPath);
+        const std::string requestPayload = DaemonProtocol::encodeRequest(request);
+        std::string responsePayload;
+        for (int repeatIdx = 0; repeatIdx < nRepeats; ++repeatIdx) {
+            const auto requestStart = std::chrono::steady_clock::now();
+            connection.sendFrame(requestPayload);
+            if (!connection.receiveFrame(responsePayload)) {
+                throw std::runtime_error("Daemon closed the connection");
+            }
+            const double roundTripMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - requestStart).count();
+            const DaemonResponse response = DaemonProtocol::decodeResponse(responsePayload);
+            if (!response.isOk) {
+                exitStatus = 1;
+            }
+            if (request.command != DaemonRequest::Command::Solve || !response.isOk) {
+                std::cout << (response.isOk ? "ok: " : "error: ") << response.message << std::endl;
+                continue;
+            }
+            std::cout << response.instanceName << " (" << response.instanceSize << "): value " << response.value
+                      << ", solve " << response.timeMs << " ms, round trip " << roundTripMs << " ms, runs "
+                      << response.nRuns << ", cache " << (response.isCacheHit ? "hit" : "miss") << std::endl;
+            std::cout << "  " << response.solution << std::endl;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return exitStatus;
+}
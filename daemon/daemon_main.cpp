@@ -0,0 +1,72 @@
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "SolverDaemon.h"
+
+namespace {
+    SolverDaemon *runningDaemon = nullptr;
+
+    void handleSignal(int) {
+        // Only sets an atomic flag - async-signal-safe
+        if (runningDaemon != nullptr) {
+            runningDaemon->requestShutdown();
+        }
+    }
+
+    void printUsage(const char *programName) {
+        std::cerr << "Usage: " << programName << " [--socket PATH] [--workers N] [--cache N]" << std::endl
+                  << "  --socket PATH  Unix domain socket to listen on (default: /tmp/pea_p1.sock)" << std::endl
+                  << "  --workers N    solver threads (default: 0 - all hardware threads)" << std::endl
+                  << "  --cache N      number of cached instances (default: 32)" << std::endl;
+    }
+}
+
+
+int main(int argc, char **argv) {
+    std::string socketPath = "/tmp/pea_p1.sock";
+    int nWorkers = 0;
+    int cacheCapacity = 32;
+
+    try {
+        for (int argIdx = 1; argIdx < argc; ++argIdx) {
+            const std::string option = argv[argIdx];
+            if (option == "-h" || option == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (argIdx + 1 >= argc) {
+                throw std::invalid_argument("Option " + option + " requires a value");
+            }
+            const std::string value = argv[++argIdx];
+            if (option == "--socket") {
+                socketPath = value;
+            } else if (option == "--workers") {
+                nWorkers = std::stoi(value);
+            } else if (option == "--cache") {
+                cacheCapacity = std::stoi(value);
+            } else {
+                throw std::invalid_argument("Unknown option " + option);
+            }
+        }
+    } catch (const std::logic_error &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    try {
+        SolverDaemon solverDaemon(socketPath, nWorkers, cacheCapacity);
+        runningDaemon = &solverDaemon;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+        solverDaemon.run();
+        runningDaemon = nullptr;
+    } catch (const std::exception &e) {
+        runningDaemon = nullptr;
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
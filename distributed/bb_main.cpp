@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include "../algorithms/DistributedBranchAndBound.h"
+#include "../utilities/Socket.h"
+#include "../utilities/TSPUtils.h"
+
+// Coordinator and worker processes of DistributedBranchAndBound. The coordinator may start local workers itself
+// (running this executable in worker mode); workers on other hosts connect to its TCP address.
+
+extern char **environ;
+
+namespace {
+    const char *const DEFAULT_ADDRESS = "/tmp/pea_p1_bb.sock";
+    const int CONNECT_RETRY_MS = 200;
+
+    void printUsage(const char *programName) {
+        std::cerr << "Usage: " << programName << " coordinate [--listen ADDRESS] [--spawn N] [--workers N] INSTANCE"
+                  << std::endl
+                  << "       " << programName << " work [--connect ADDRESS]" << std::endl
+                  << "  ADDRESS      HOST:PORT (TCP) or a Unix socket path (default: " << DEFAULT_ADDRESS << ")"
+                  << std::endl
+                  << "  --spawn N    worker processes started on this host (default: --workers, otherwise all"
+                  << std::endl
+                  << "               hardware threads)" << std::endl
+                  << "  --workers N  workers to wait for, local and remote (default: --spawn)" << std::endl;
+    }
+
+    // Workers may be started before the coordinator listens
+    Socket connectWithRetries(const std::string &address) {
+        const auto deadline = std::chrono::steady_clock::now()
+                              + std::chrono::milliseconds(DistributedBranchAndBound::WORKER_CONNECT_TIMEOUT_MS);
+        while (true) {
+            try {
+                return Socket::connect(address);
+            } catch (const std::runtime_error &) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    throw;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(CONNECT_RETRY_MS));
+        }
+    }
+
+    std::vector<pid_t> spawnWorkers(int nWorkers, const std::string &address) {
+        std::vector<pid_t> workerPids;
+        for (int workerIdx = 0; workerIdx < nWorkers; ++workerIdx) {
+            std::string programPath = "/proc/self/exe", mode = "work", option = "--connect", value = address;
+            char *arguments[] = {&programPath[0], &mode[0], &option[0], &value[0], nullptr};
+            pid_t pid;
+            const int result = ::posix_spawn(&pid, "/proc/self/exe", nullptr, nullptr, arguments, environ);
+            if (result != 0) {
+                throw std::runtime_error(std::string("posix_spawn() failed: ") + std::strerror(result));
+            }
+            workerPids.emplace_back(pid);
+        }
+        return workerPids;
+    }
+
+    int coordinate(const std::string &address, int nSpawnedWorkers, int nWorkers, const std::string &instancePath) {
+        IGraph *tspInstance = nullptr;
+        const std::string instanceName = TSPUtils::loadTSPInstanceAbsolutePath(
+                &tspInstance, instancePath, TSPUtils::getTSPTypeAbsolutePath(instancePath));
+        const std::unique_ptr<IGraph> instanceOwner(tspInstance);
+
+        ServerSocket serverSocket = ServerSocket::listen(address);
+        // Local workers reach a TCP coordinator through the loopback interface, also when the port was chosen here
+        const bool isTcp = address.find('/') == std::string::npos && address.find(':') != std::string::npos;
+        const std::string workerAddress = isTcp ? "127.0.0.1:" + std::to_string(serverSocket.getPort()) : address;
+        if (isTcp) {
+            std::cerr << "Listening on port " << serverSocket.getPort() << std::endl;
+        }
+        const std::vector<pid_t> workerPids = spawnWorkers(nSpawnedWorkers, workerAddress);
+
+        int exitCode = 0;
+        try {
+            std::vector<int> solution;
+            const auto startTime = std::chrono::steady_clock::now();
+            const int solutionValue = DistributedBranchAndBound::runCoordinator(tspInstance, serverSocket, nWorkers,
+                                                                                solution);
+            const double timeMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - startTime).count();
+            std::cout << instanceName << ": value " << solutionValue << ", " << timeMs << " ms, " << nWorkers
+                      << " workers" << std::endl << solution << std::endl;
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+        // Workers return when they are stopped or the coordinator disconnects; ones still connecting are killed
+        serverSocket.close();
+        for (const pid_t pid : workerPids) {
+            if (exitCode != 0) {
+                ::kill(pid, SIGTERM);
+            }
+            ::waitpid(pid, nullptr, 0);
+        }
+        return exitCode;
+    }
+}
+
+
+int main(int argc, char **argv) {
+    if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+        printUsage(argv[0]);
+        return argc < 2 ? 2 : 0;
+    }
+    const std::string mode = argv[1];
+    std::string address = DEFAULT_ADDRESS;
+    int nSpawnedWorkers = -1;
+    int nWorkers = -1;
+    std::string instancePath;
+
+    try {
+        if (mode != "coordinate" && mode != "work") {
+            throw std::invalid_argument("Unknown mode " + mode);
+        }
+        for (int argIdx = 2; argIdx < argc; ++argIdx) {
+            const std::string option = argv[argIdx];
+            if (option.rfind("--", 0) != 0) {
+                if (mode != "coordinate" || !instancePath.empty()) {
+                    throw std::invalid_argument("Unexpected argument " + option);
+                }
+                instancePath = option;
+                continue;
+            }
+            if (argIdx + 1 >= argc) {
+                throw std::invalid_argument("Option " + option + " requires a value");
+            }
+            const std::string value = argv[++argIdx];
+            if (option == (mode == "coordinate" ? "--listen" : "--connect")) {
+                address = value;
+            } else if (mode == "coordinate" && option == "--spawn") {
+                nSpawnedWorkers = std::stoi(value);
+            } else if (mode == "coordinate" && option == "--workers") {
+                nWorkers = std::stoi(value);
+            } else {
+                throw std::invalid_argument("Unknown option " + option);
+            }
+        }
+        if (mode == "coordinate" && instancePath.empty()) {
+            throw std::invalid_argument("Instance file is missing");
+        }
+        if (nSpawnedWorkers < 0 && nWorkers < 0) {
+            nSpawnedWorkers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        if (nSpawnedWorkers < 0) {
+            nSpawnedWorkers = nWorkers;
+        } else if (nWorkers < 0) {
+            nWorkers = nSpawnedWorkers;
+        }
+        if (nSpawnedWorkers < 0 || nSpawnedWorkers > nWorkers) {
+            throw std::invalid_argument("--spawn must be between 0 and --workers");
+        }
+    } catch (const std::logic_error &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (mode == "work") {
+        try {
+            Socket socket = connectWithRetries(address);
+            DistributedBranchAndBound::runWorker(socket);
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    try {
+        return coordinate(address, nSpawnedWorkers, nWorkers, instancePath);
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -3,8 +3,10 @@
 #include "tests/MiscellaneousTests.h"
 #include "menu/ConsoleMenu.h"
 #include "time_tests/TimeMeasurement.h"
+#include "time_tests/ThreadScalingMeasurement.h"
 #include "parameter_analysis/local_search/LSParameterAnalysis.h"
 #include "parameter_analysis/populational_algorithms/GAParameterAnalysis.h"
+#include "utilities/Trace.h"
 
 
 int main() {
@@ -27,8 +29,16 @@ int main() {
 //    TimeMeasurement tm;
 //    tm.run();
 
+//    ThreadScalingMeasurement tsm;
+//    tsm.run();
+
 //    GAParameterAnalysis gaParameterAnalysis;
 //    gaParameterAnalysis.run();
 
+    // Only in builds configured with -DPEA_P1_TRACING=ON; open in chrome://tracing or ui.perfetto.dev
+    if (Trace::isEnabled()) {
+        Trace::dumpChromeTrace("trace.json");
+    }
+
     return 0;
 }
\ No newline at end of file
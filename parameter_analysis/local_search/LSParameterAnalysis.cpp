@@ -2,6 +2,7 @@
 #include "../../structures/graphs/IGraph.h"
 #include "../../utilities/TSPUtils.h"
 #include "../../algorithms/helper_structures/LocalSearchParameters.h"
+#include "../../algorithms/InstanceContext.h"
 #include <chrono>
 #include <vector>
 #include <map>
@@ -176,6 +177,7 @@ std::map<std::string, std::vector<std::string>> LSParameterAnalysis::getInstance
 std::vector<std::pair<IGraph *, int>>
 LSParameterAnalysis::loadInstances(const std::map<std::string, std::vector<std::string>> &instancePaths) {
     std::vector<std::pair<IGraph *, int>> tspInstances;
+    instanceContexts.clear();
     IGraph *instance = nullptr;
     std::map<std::string, int> optimalSolutions;
     std::string instancePath;
@@ -185,6 +187,7 @@ LSParameterAnalysis::loadInstances(const std::map<std::string, std::vector<std::
             instancePath = fileGroup.first + '/' + fileGroup.second[i];
             TSPUtils::loadTSPInstanceAbsolutePath(&instance, instancePath,
                                                   TSPUtils::getTSPTypeAbsolutePath(instancePath));
+            instanceContexts[instance] = std::make_shared<const InstanceContext>(instance);
             tspInstances.emplace_back(instance,
                                       optimalSolutions.at(
                                               fileGroup.second[i].substr(0, fileGroup.second[i].find('.'))));
@@ -230,6 +233,7 @@ LSParameterAnalysis::performSimulatedAnnealingParameterRangeTests(LocalSearchPar
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (T currentParameterValue = startParameter;
              currentParameterValue < endParameter; currentParameterValue += parameterStep) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": "
@@ -318,6 +322,7 @@ void LSParameterAnalysis::performSimulatedAnnealingCoolingSchemeParameterTests(
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (double currentParameter = startParameter;
              currentParameter < endParameter; currentParameter += parameterStep) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": "
@@ -389,6 +394,7 @@ void LSParameterAnalysis::performSimulatedAnnealingInitialSolutionTests(int nRep
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (const auto &initialSolutionAlgorithm : initialSolutionAlgorithms) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": algorithm \""
                       << initialSolutionAlgorithm.first << "\"" << std::endl;
@@ -457,6 +463,7 @@ void LSParameterAnalysis::performSimulatedAnnealingNeighbourhoodTests(int nRepet
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (const auto &neighbourhoodAlgorithm : neighbourhoodAlgorithms) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": algorithm \""
                       << neighbourhoodAlgorithm.first << "\"" << std::endl;
@@ -543,6 +550,7 @@ LSParameterAnalysis::performTabuSearchParameterRangeTests(LocalSearchParameters:
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (T currentParameterValue = startParameter;
              currentParameterValue < endParameter; currentParameterValue += parameterStep) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": "
@@ -632,6 +640,7 @@ void LSParameterAnalysis::performTabuSearchInitialSolutionTests(int nRepetitions
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (const auto &initialSolutionAlgorithm : initialSolutionAlgorithms) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": algorithm \""
                       << initialSolutionAlgorithm.first << "\"" << std::endl;
@@ -700,6 +709,7 @@ void LSParameterAnalysis::performTabuSearchNeighbourhoodTests(int nRepetitions)
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         for (const auto &neighbourhoodAlgorithm : neighbourhoodAlgorithms) {
             std::cout << "Instance " << analysedInstances << '/' << tspInstances.size() << ": algorithm \""
                       << neighbourhoodAlgorithm.first << "\"" << std::endl;
@@ -771,6 +781,7 @@ void LSParameterAnalysis::performTimeBenchmark(TSPLocalSearchAlgorithms::fLocalS
     int analysedInstances = 0;
     for (const auto &tspInstance : tspInstances) {
         ++analysedInstances;
+        parameters.instanceContext = instanceContexts.at(tspInstance.first).get();
         timePoint = AnalysisPoint<std::string>();
         bestSolutionValue = std::numeric_limits<int>::max();
         for (int repetition = 0; repetition < nRepetitions; ++repetition) {
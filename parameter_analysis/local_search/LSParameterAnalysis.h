@@ -4,8 +4,10 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include "../../structures/graphs/IGraph.h"
 #include "../../algorithms/TSPLocalSearchAlgorithms.h"
+#include "../../algorithms/InstanceContext.h"
 #include "../AnalysisPoint.h"
 #include <algorithm>
 #include <fstream>
@@ -21,6 +23,9 @@ public:
 
 private:
 
+    // Built by loadInstances - initial solutions are computed once per instance, not in every repetition
+    std::map<const IGraph *, std::shared_ptr<const InstanceContext>> instanceContexts;
+
     template<class T>
     void performSimulatedAnnealingParameterRangeTests(LocalSearchParameters::SAParameters parameterID, int nRepetitions,
                                                       T startParameter, T endParameter, int nSteps);
@@ -0,0 +1,65 @@
+import pandas
+import matplotlib.pyplot as plt
+
+DATA_DIRECTORY = '../../time_tests/collected_data/thread_scaling/'
+
+
+def get_scaling_points_from_csv(file_path):
+    df = pandas.read_csv(file_path, header=0, skiprows=2, index_col=0)
+    # print(df.dtypes)
+
+    points = {'threads': [int(key) for key in df.columns]}
+    for row_name in df.index:
+        points[row_name] = [float(value) for value in df.loc[row_name]]
+    return points
+
+
+def plot_multiple(plotting_data, y_key, y_label, legend_location='upper left', ideal_line=False):
+    threads_max = 1
+    for plt_data in plotting_data:
+        plt.plot(plt_data['points']['threads'], plt_data['points'][y_key], plt_data['style'], label=plt_data['label'])
+        threads_max = max(threads_max, plt_data['points']['threads'][-1])
+
+    if ideal_line:
+        plt.plot([1, threads_max], [1, threads_max], 'k--', label='Idealne przyspieszenie')
+
+    plt.xticks(plotting_data[0]['points']['threads'])
+    plt.grid(True)
+
+    plt.xlabel('Liczba wątków')
+    plt.ylabel(y_label)
+    plt.legend(loc=legend_location)
+
+    plt.show()
+
+
+data = {'dp': get_scaling_points_from_csv(DATA_DIRECTORY + 'dynamic_programming.csv'),
+        'bb': get_scaling_points_from_csv(DATA_DIRECTORY + 'branch_and_bound.csv'),
+        'sa': get_scaling_points_from_csv(DATA_DIRECTORY + 'simulated_annealing.csv'),
+        'ts': get_scaling_points_from_csv(DATA_DIRECTORY + 'tabu_search_matrix.csv'),
+        'ga': get_scaling_points_from_csv(DATA_DIRECTORY + 'genetic_algorithm.csv')}
+
+# print(data)
+
+plot_multiple(({'points': data['dp'], 'style': 'ro-', 'label': 'DP (Held-Karp)'},
+               {'points': data['bb'], 'style': 'gs-', 'label': 'B&B (Little; NN; G)'},
+               {'points': data['sa'], 'style': 'b^-', 'label': 'SA'},
+               {'points': data['ts'], 'style': 'ys-', 'label': 'TS (matrix)'},
+               {'points': data['ga'], 'style': 'mo-', 'label': 'GA'}),
+              'Speedup', 'Przyspieszenie', ideal_line=True)
+
+plot_multiple(({'points': data['dp'], 'style': 'ro-', 'label': 'DP (Held-Karp)'},
+               {'points': data['bb'], 'style': 'gs-', 'label': 'B&B (Little; NN; G)'},
+               {'points': data['sa'], 'style': 'b^-', 'label': 'SA'},
+               {'points': data['ts'], 'style': 'ys-', 'label': 'TS (matrix)'},
+               {'points': data['ga'], 'style': 'mo-', 'label': 'GA'}),
+              'Parallel efficiency', 'Efektywność zrównoleglenia', legend_location='lower left')
+
+plot_multiple(({'points': data['dp'], 'style': 'ro-', 'label': 'DP (Held-Karp)'},
+               {'points': data['bb'], 'style': 'gs-', 'label': 'B&B (Little; NN; G)'}),
+              'Wall time', 'Czas wykonania [ms]', legend_location='upper right')
+
+plot_multiple(({'points': data['sa'], 'style': 'b^-', 'label': 'SA'},
+               {'points': data['ts'], 'style': 'ys-', 'label': 'TS (matrix)'},
+               {'points': data['ga'], 'style': 'mo-', 'label': 'GA'}),
+              'Mean relative error [%]', 'Błąd średni względny [%]', legend_location='upper right')
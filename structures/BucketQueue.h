@@ -0,0 +1,143 @@
+#ifndef PEA_P1_BUCKETQUEUE_H
+#define PEA_P1_BUCKETQUEUE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Priority queue of items with integer keys from a known range - smallest key first, then the highest level, then
+// the last pushed. Items stay in a pool and only their handles are moved between buckets, so push and pop are O(1)
+// amortised (plus a scan over levels). Ranges wider than MAX_BUCKETS share buckets: within a bucket items are then
+// ordered by level only.
+template<class T>
+class BucketQueue {
+
+public:
+    static const int MAX_BUCKETS = 1 << 20;
+
+    // Keys in [minKey, maxKey], levels in [0, nLevels)
+    BucketQueue(int minKey, int maxKey, int nLevels)
+            : minKey(minKey), nLevels(nLevels),
+              bucketWidth(1 + (static_cast<long long>(maxKey) - minKey) / MAX_BUCKETS), firstBucketIdx(0), size(0) {
+        if (maxKey < minKey || nLevels <= 0) {
+            throw std::invalid_argument("Empty range of keys or levels");
+        }
+    }
+
+    void push(T &&item, int key, int level) {
+        if (key < minKey || level < 0 || level >= nLevels) {
+            throw std::out_of_range("Key or level out of range");
+        }
+        const std::size_t bucketIdx = getBucketIdx(key);
+        if (bucketIdx >= buckets.size()) {
+            buckets.resize(bucketIdx + 1);
+            bucketSizes.resize(bucketIdx + 1, 0);
+        }
+        if (buckets[bucketIdx].empty()) {
+            buckets[bucketIdx].resize(nLevels);
+        }
+
+        int handle;
+        if (freeHandles.empty()) {
+            handle = static_cast<int>(items.size());
+            items.emplace_back(std::move(item));
+        } else {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+            items[handle] = std::move(item);
+        }
+        buckets[bucketIdx][level].emplace_back(handle);
+        ++bucketSizes[bucketIdx];
+        ++size;
+        if (bucketIdx < firstBucketIdx) {
+            firstBucketIdx = bucketIdx;
+        }
+    }
+
+    T pop() {
+        if (size == 0) {
+            throw std::out_of_range("Queue is empty");
+        }
+        while (bucketSizes[firstBucketIdx] == 0) {
+            ++firstBucketIdx;
+        }
+        std::vector<std::vector<int>> &bucket = buckets[firstBucketIdx];
+        int level = nLevels - 1;
+        while (bucket[level].empty()) {
+            --level;
+        }
+        const int handle = bucket[level].back();
+        bucket[level].pop_back();
+        freeHandles.emplace_back(handle);
+        --size;
+        if (--bucketSizes[firstBucketIdx] == 0) {
+            std::vector<std::vector<int>>().swap(bucket);
+        }
+        return std::move(items[handle]);
+    }
+
+    // Removes items of all buckets holding only keys >= key
+    void eraseFrom(int key) {
+        const std::size_t firstErasedIdx = key <= minKey ? 0 : getBucketIdx(key - 1) + 1;
+        for (std::size_t bucketIdx = firstErasedIdx; bucketIdx < buckets.size(); ++bucketIdx) {
+            for (const auto &levelHandles : buckets[bucketIdx]) {
+                for (const auto &handle : levelHandles) {
+                    items[handle] = T();
+                    freeHandles.emplace_back(handle);
+                }
+            }
+            size -= bucketSizes[bucketIdx];
+        }
+        if (firstErasedIdx < buckets.size()) {
+            buckets.resize(firstErasedIdx);
+            bucketSizes.resize(firstErasedIdx);
+        }
+        if (size == 0) {
+            firstBucketIdx = 0;
+        }
+    }
+
+    // Calls visitor(item) for all items - by buckets, then levels, then in the order of pushes
+    template<class Visitor>
+    void forEach(Visitor visitor) const {
+        for (std::size_t bucketIdx = firstBucketIdx; bucketIdx < buckets.size(); ++bucketIdx) {
+            for (const auto &levelHandles : buckets[bucketIdx]) {
+                for (const auto &handle : levelHandles) {
+                    visitor(items[handle]);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] int getSize() const {
+        return size;
+    }
+
+    [[nodiscard]] bool isEmpty() const {
+        return size == 0;
+    }
+
+private:
+    int minKey;
+    int nLevels;
+    long long bucketWidth;
+
+    // [bucket][level] - handles of items
+    std::vector<std::vector<std::vector<int>>> buckets;
+    std::vector<int> bucketSizes;
+
+    // All buckets before it are empty
+    std::size_t firstBucketIdx;
+
+    std::vector<T> items;
+    std::vector<int> freeHandles;
+    int size;
+
+    [[nodiscard]] std::size_t getBucketIdx(int key) const {
+        return static_cast<std::size_t>((static_cast<long long>(key) - minKey) / bucketWidth);
+    }
+};
+
+
+#endif //PEA_P1_BUCKETQUEUE_H
@@ -1,3 +1,7 @@
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
 #include "TSPAlgorithmsTest.h"
 #include "../algorithms/TSPPopulationAlgorithms.h"
 
@@ -5,15 +9,29 @@ void TSPAlgorithmsTest::run() const {
 //    bruteForceTest();
 //    bruteForceTreeTest();
 //    dynamicProgrammingHeldKarpTest();
+//    dynamicProgrammingHeldKarpPrunedTest();
+//    dynamicProgrammingHeldKarpOutOfCoreTest();
+//    dynamicProgrammingHeldKarpSymmetricTest();
 //    branchAndBoundTest();
+//    tinyHeldKarpTest();
+//    tinyHeldKarpBatchTest();
 //
 //    nearestNeighbourTest();
 //    greedyTest();
+//    karpPatchingTest();
+//    savingsTest();
+//    assignmentSolverTest();
 
 //    simulatedAnnealingTest();
     tabuSearchTest();
 
 //    geneticAlgorithmTest();
+
+//    instanceContextTest();
+//    checkpointTest();
+//    solverRegistryTest();
+//    distributedBranchAndBoundTest();
+//    tabuMoveTableTest();
 }
 
 //region Exact algorithms
@@ -256,6 +274,189 @@ void TSPAlgorithmsTest::dynamicProgrammingHeldKarpTest() const {
                                "dynamicProgrammingHeldKarp");
 }
 
+void TSPAlgorithmsTest::dynamicProgrammingHeldKarpPrunedTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // MY
+    filePaths.emplace_back("my_opt.txt");
+    filePaths.emplace_back("mdata2.txt");
+    filePaths.emplace_back("mdata3.txt");
+    filePaths.emplace_back("mdata4.txt");
+    filePaths.emplace_back("mdata5.txt");
+    fileGroups.insert({"MY", filePaths});
+    filePaths.clear();
+
+    // ATSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+//    filePaths.emplace_back("data34.txt");
+//    filePaths.emplace_back("data36.txt");
+//    filePaths.emplace_back("data39.txt");
+//    filePaths.emplace_back("data43.txt");
+//    filePaths.emplace_back("data45.txt");
+//    filePaths.emplace_back("data48.txt");
+//    filePaths.emplace_back("data53.txt");
+//    filePaths.emplace_back("data56.txt");
+//    filePaths.emplace_back("data65.txt");
+//    filePaths.emplace_back("data70.txt");
+//    filePaths.emplace_back("data71.txt");
+//    filePaths.emplace_back("data100.txt");
+//    filePaths.emplace_back("data171.txt");
+//    filePaths.emplace_back("data323.txt");
+//    filePaths.emplace_back("data358.txt");
+//    filePaths.emplace_back("data403.txt");
+//    filePaths.emplace_back("data443.txt");
+    fileGroups.insert({"ATSP", filePaths});
+    filePaths.clear();
+
+    // SMALL
+    filePaths.emplace_back("opt.txt");
+    filePaths.emplace_back("data10.txt");
+    filePaths.emplace_back("data11.txt");
+    filePaths.emplace_back("data12.txt");
+    filePaths.emplace_back("data13.txt");
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data18.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // TSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data21.txt");
+    filePaths.emplace_back("data24.txt");
+//    filePaths.emplace_back("data26.txt");
+//    filePaths.emplace_back("data29.txt");
+//    filePaths.emplace_back("data42.txt");
+//    filePaths.emplace_back("data58.txt");
+//    filePaths.emplace_back("data120.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    // MIE
+    filePaths.emplace_back("mie_opt.txt");
+    filePaths.emplace_back("tsp_6_1.txt");
+    filePaths.emplace_back("tsp_6_2.txt");
+    filePaths.emplace_back("tsp_10.txt");
+    filePaths.emplace_back("tsp_12.txt");
+    filePaths.emplace_back("tsp_13.txt");
+    filePaths.emplace_back("tsp_14.txt");
+    filePaths.emplace_back("tsp_15.txt");
+    filePaths.emplace_back("tsp_17.txt");
+    fileGroups.insert({"MIE", filePaths});
+    filePaths.clear();
+
+    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::dynamicProgrammingHeldKarpPruned, false,
+                               "dynamicProgrammingHeldKarpPruned");
+//    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::dynamicProgrammingHeldKarpWithEdgeElimination, false,
+//                               "dynamicProgrammingHeldKarpWithEdgeElimination");
+}
+
+void TSPAlgorithmsTest::dynamicProgrammingHeldKarpOutOfCoreTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // MY
+    filePaths.emplace_back("my_opt.txt");
+    filePaths.emplace_back("mdata2.txt");
+    filePaths.emplace_back("mdata3.txt");
+    filePaths.emplace_back("mdata4.txt");
+    filePaths.emplace_back("mdata5.txt");
+    fileGroups.insert({"MY", filePaths});
+    filePaths.clear();
+
+    // ATSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+//    filePaths.emplace_back("data34.txt");
+//    filePaths.emplace_back("data36.txt");
+//    filePaths.emplace_back("data39.txt");
+//    filePaths.emplace_back("data43.txt");
+//    filePaths.emplace_back("data45.txt");
+//    filePaths.emplace_back("data48.txt");
+//    filePaths.emplace_back("data53.txt");
+//    filePaths.emplace_back("data56.txt");
+//    filePaths.emplace_back("data65.txt");
+//    filePaths.emplace_back("data70.txt");
+//    filePaths.emplace_back("data71.txt");
+//    filePaths.emplace_back("data100.txt");
+//    filePaths.emplace_back("data171.txt");
+//    filePaths.emplace_back("data323.txt");
+//    filePaths.emplace_back("data358.txt");
+//    filePaths.emplace_back("data403.txt");
+//    filePaths.emplace_back("data443.txt");
+    fileGroups.insert({"ATSP", filePaths});
+    filePaths.clear();
+
+    // SMALL
+    filePaths.emplace_back("opt.txt");
+    filePaths.emplace_back("data10.txt");
+    filePaths.emplace_back("data11.txt");
+    filePaths.emplace_back("data12.txt");
+    filePaths.emplace_back("data13.txt");
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data18.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // TSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data21.txt");
+    filePaths.emplace_back("data24.txt");
+//    filePaths.emplace_back("data26.txt");
+//    filePaths.emplace_back("data29.txt");
+//    filePaths.emplace_back("data42.txt");
+//    filePaths.emplace_back("data58.txt");
+//    filePaths.emplace_back("data120.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    // MIE
+    filePaths.emplace_back("mie_opt.txt");
+    filePaths.emplace_back("tsp_6_1.txt");
+    filePaths.emplace_back("tsp_6_2.txt");
+    filePaths.emplace_back("tsp_10.txt");
+    filePaths.emplace_back("tsp_12.txt");
+    filePaths.emplace_back("tsp_13.txt");
+    filePaths.emplace_back("tsp_14.txt");
+    filePaths.emplace_back("tsp_15.txt");
+    filePaths.emplace_back("tsp_17.txt");
+    fileGroups.insert({"MIE", filePaths});
+    filePaths.clear();
+
+    // Layer files in the system temporary directory
+    testExactOrGreedyAlgorithm(fileGroups, [](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+        return TSPExactAlgorithms::dynamicProgrammingHeldKarpOutOfCore(
+                tspInstance, std::filesystem::temp_directory_path().string(), outSolution);
+    }, false, "dynamicProgrammingHeldKarpOutOfCore");
+}
+
+void TSPAlgorithmsTest::dynamicProgrammingHeldKarpSymmetricTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // TSP (symmetric instances only)
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data21.txt");
+    filePaths.emplace_back("data24.txt");
+//    filePaths.emplace_back("data26.txt");
+//    filePaths.emplace_back("data29.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::dynamicProgrammingHeldKarpSymmetric, false,
+                               "dynamicProgrammingHeldKarpSymmetric");
+}
+
 void TSPAlgorithmsTest::branchAndBoundTest() const {
     std::map<std::string, std::vector<std::string>> fileGroups;
     std::vector<std::string> filePaths;
@@ -337,6 +538,131 @@ void TSPAlgorithmsTest::branchAndBoundTest() const {
 //    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBoundNNHeuristic, false, "branchAndBoundNNHeuristic");
 //    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBoundGHeuristic, false, "branchAndBoundGHeuristic");
 //    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBound2Heuristics, false, "branchAndBound2Heuristics");
+//    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBoundCompactNodes, false, "branchAndBoundCompactNodes");
+//    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBoundDepthFirst, false, "branchAndBoundDepthFirst");
+//    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBoundWithEdgeElimination, false, "branchAndBoundWithEdgeElimination");
+//    testExactOrGreedyAlgorithm(fileGroups, TSPExactAlgorithms::branchAndBoundStrongBranching, false, "branchAndBoundStrongBranching");
+}
+
+void TSPAlgorithmsTest::tinyHeldKarpTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // MY
+    filePaths.emplace_back("my_opt.txt");
+    filePaths.emplace_back("mdata2.txt");
+    filePaths.emplace_back("mdata3.txt");
+    filePaths.emplace_back("mdata4.txt");
+    filePaths.emplace_back("mdata5.txt");
+    fileGroups.insert({"MY", filePaths});
+    filePaths.clear();
+
+    // SMALL
+    filePaths.emplace_back("opt.txt");
+    filePaths.emplace_back("data10.txt");
+    filePaths.emplace_back("data11.txt");
+    filePaths.emplace_back("data12.txt");
+    filePaths.emplace_back("data13.txt");
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // MIE
+    filePaths.emplace_back("mie_opt.txt");
+    filePaths.emplace_back("tsp_6_1.txt");
+    filePaths.emplace_back("tsp_6_2.txt");
+    filePaths.emplace_back("tsp_10.txt");
+    filePaths.emplace_back("tsp_12.txt");
+    filePaths.emplace_back("tsp_13.txt");
+    filePaths.emplace_back("tsp_14.txt");
+    filePaths.emplace_back("tsp_15.txt");
+    fileGroups.insert({"MIE", filePaths});
+    filePaths.clear();
+
+    testExactOrGreedyAlgorithm(fileGroups, TSPTinyExactAlgorithms::heldKarp, false, "tinyHeldKarp");
+}
+
+void TSPAlgorithmsTest::tinyHeldKarpBatchTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // SMALL
+    filePaths.emplace_back("opt.txt");
+    filePaths.emplace_back("data10.txt");
+    filePaths.emplace_back("data11.txt");
+    filePaths.emplace_back("data12.txt");
+    filePaths.emplace_back("data13.txt");
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // MIE
+    filePaths.emplace_back("mie_opt.txt");
+    filePaths.emplace_back("tsp_6_1.txt");
+    filePaths.emplace_back("tsp_6_2.txt");
+    filePaths.emplace_back("tsp_10.txt");
+    filePaths.emplace_back("tsp_12.txt");
+    filePaths.emplace_back("tsp_13.txt");
+    filePaths.emplace_back("tsp_14.txt");
+    filePaths.emplace_back("tsp_15.txt");
+    fileGroups.insert({"MIE", filePaths});
+    filePaths.clear();
+
+    // Every instance is added BATCH_LANES + 1 times - full and partial batches of each size
+    const int nCopies = TSPTinyExactAlgorithms::BATCH_LANES + 1;
+
+    std::cout << std::string(10, '-') << "Test \"tinyHeldKarpBatch\" started" << std::string(10, '-') << std::endl;
+    std::vector<IGraph *> loadedInstances;
+    std::vector<const IGraph *> tspInstances;
+    std::vector<std::string> instanceNames;
+    std::vector<int> fileSolutionValues;
+    for (const auto &pair : fileGroups) {
+        const auto solutions = TSPUtils::loadTSPSolutionValues(pair.first + "/" + pair.second[0]);
+        for (int i = 1; i != pair.second.size(); ++i) {
+            IGraph *tspInstance = nullptr;
+            TSPUtils::loadTSPInstance(&tspInstance, pair.first + "/" + pair.second[i]);
+            loadedInstances.push_back(tspInstance);
+            for (int copyIdx = 0; copyIdx < nCopies; ++copyIdx) {
+                tspInstances.push_back(tspInstance);
+                instanceNames.push_back(pair.first + "/" + pair.second[i]);
+                fileSolutionValues.push_back(solutions.at(pair.second[i].substr(0, pair.second[i].find('.'))));
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> algorithmSolutions;
+    const auto batchStart = std::chrono::steady_clock::now();
+    const std::vector<int> algorithmSolutionValues = TSPTinyExactAlgorithms::heldKarpBatch(tspInstances,
+                                                                                           algorithmSolutions);
+    const double batchMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - batchStart).count();
+    for (int i = 0; i < tspInstances.size(); i += nCopies) {
+        std::cout << "Testing instance " + instanceNames[i] + "...";
+        bool isSuccess = true;
+        for (int copyIdx = i; copyIdx < i + nCopies; ++copyIdx) {
+            if (algorithmSolutionValues[copyIdx] != fileSolutionValues[copyIdx] ||
+                !TSPUtils::isSolutionValid(loadedInstances[copyIdx / nCopies], algorithmSolutions[copyIdx],
+                                           algorithmSolutionValues[copyIdx])) {
+                isSuccess = false;
+                std::cout << "FAIL" << " [Returned solution cost: " << algorithmSolutionValues[copyIdx] << "]";
+                break;
+            }
+        }
+        if (isSuccess) {
+            std::cout << "SUCCESS";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << tspInstances.size() << " instances solved in " << batchMs << " ms"
+              << std::endl;
+    for (IGraph *tspInstance : loadedInstances) {
+        delete tspInstance;
+    }
+    std::cout << std::string(10, '-') << "Test \"tinyHeldKarpBatch\" finished" << std::string(10, '-') << std::endl;
 }
 
 void TSPAlgorithmsTest::testExactOrGreedyAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
@@ -536,6 +862,200 @@ void TSPAlgorithmsTest::greedyTest() const {
     testExactOrGreedyAlgorithm(fileGroups, TSPGreedyAlgorithms::greedy, true, "greedy");
 }
 
+void TSPAlgorithmsTest::karpPatchingTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // MY
+    filePaths.emplace_back("my_opt.txt");
+    filePaths.emplace_back("mdata2.txt");
+    filePaths.emplace_back("mdata3.txt");
+    filePaths.emplace_back("mdata4.txt");
+    filePaths.emplace_back("mdata5.txt");
+    fileGroups.insert({"MY", filePaths});
+    filePaths.clear();
+
+    // ATSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data34.txt");
+    filePaths.emplace_back("data36.txt");
+    filePaths.emplace_back("data39.txt");
+    filePaths.emplace_back("data43.txt");
+    filePaths.emplace_back("data45.txt");
+    filePaths.emplace_back("data48.txt");
+    filePaths.emplace_back("data53.txt");
+    filePaths.emplace_back("data56.txt");
+    filePaths.emplace_back("data65.txt");
+    filePaths.emplace_back("data70.txt");
+    filePaths.emplace_back("data71.txt");
+    filePaths.emplace_back("data100.txt");
+    filePaths.emplace_back("data171.txt");
+    filePaths.emplace_back("data323.txt");
+    filePaths.emplace_back("data358.txt");
+    filePaths.emplace_back("data403.txt");
+    filePaths.emplace_back("data443.txt");
+    fileGroups.insert({"ATSP", filePaths});
+    filePaths.clear();
+
+    // SMALL
+    filePaths.emplace_back("opt.txt");
+    filePaths.emplace_back("data10.txt");
+    filePaths.emplace_back("data11.txt");
+    filePaths.emplace_back("data12.txt");
+    filePaths.emplace_back("data13.txt");
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data18.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // TSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data21.txt");
+    filePaths.emplace_back("data24.txt");
+    filePaths.emplace_back("data26.txt");
+    filePaths.emplace_back("data29.txt");
+    filePaths.emplace_back("data42.txt");
+    filePaths.emplace_back("data58.txt");
+    filePaths.emplace_back("data120.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    // MIE
+    filePaths.emplace_back("mie_opt.txt");
+    filePaths.emplace_back("tsp_6_1.txt");
+    filePaths.emplace_back("tsp_6_2.txt");
+    filePaths.emplace_back("tsp_10.txt");
+    filePaths.emplace_back("tsp_12.txt");
+    filePaths.emplace_back("tsp_13.txt");
+    filePaths.emplace_back("tsp_14.txt");
+    filePaths.emplace_back("tsp_15.txt");
+    filePaths.emplace_back("tsp_17.txt");
+    fileGroups.insert({"MIE", filePaths});
+    filePaths.clear();
+
+    testExactOrGreedyAlgorithm(fileGroups, TSPGreedyAlgorithms::karpPatching, true, "karpPatching");
+}
+
+void TSPAlgorithmsTest::savingsTest() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // MY
+    filePaths.emplace_back("my_opt.txt");
+    filePaths.emplace_back("mdata2.txt");
+    filePaths.emplace_back("mdata3.txt");
+    filePaths.emplace_back("mdata4.txt");
+    filePaths.emplace_back("mdata5.txt");
+    fileGroups.insert({"MY", filePaths});
+    filePaths.clear();
+
+    // ATSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data34.txt");
+    filePaths.emplace_back("data36.txt");
+    filePaths.emplace_back("data39.txt");
+    filePaths.emplace_back("data43.txt");
+    filePaths.emplace_back("data45.txt");
+    filePaths.emplace_back("data48.txt");
+    filePaths.emplace_back("data53.txt");
+    filePaths.emplace_back("data56.txt");
+    filePaths.emplace_back("data65.txt");
+    filePaths.emplace_back("data70.txt");
+    filePaths.emplace_back("data71.txt");
+    filePaths.emplace_back("data100.txt");
+    filePaths.emplace_back("data171.txt");
+    filePaths.emplace_back("data323.txt");
+    filePaths.emplace_back("data358.txt");
+    filePaths.emplace_back("data403.txt");
+    filePaths.emplace_back("data443.txt");
+    fileGroups.insert({"ATSP", filePaths});
+    filePaths.clear();
+
+    // SMALL
+    filePaths.emplace_back("opt.txt");
+    filePaths.emplace_back("data10.txt");
+    filePaths.emplace_back("data11.txt");
+    filePaths.emplace_back("data12.txt");
+    filePaths.emplace_back("data13.txt");
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data18.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // TSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data17.txt");
+    filePaths.emplace_back("data21.txt");
+    filePaths.emplace_back("data24.txt");
+    filePaths.emplace_back("data26.txt");
+    filePaths.emplace_back("data29.txt");
+    filePaths.emplace_back("data42.txt");
+    filePaths.emplace_back("data58.txt");
+    filePaths.emplace_back("data120.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    // MIE
+    filePaths.emplace_back("mie_opt.txt");
+    filePaths.emplace_back("tsp_6_1.txt");
+    filePaths.emplace_back("tsp_6_2.txt");
+    filePaths.emplace_back("tsp_10.txt");
+    filePaths.emplace_back("tsp_12.txt");
+    filePaths.emplace_back("tsp_13.txt");
+    filePaths.emplace_back("tsp_14.txt");
+    filePaths.emplace_back("tsp_15.txt");
+    filePaths.emplace_back("tsp_17.txt");
+    fileGroups.insert({"MIE", filePaths});
+    filePaths.clear();
+
+    testExactOrGreedyAlgorithm(fileGroups, TSPGreedyAlgorithms::savings, true, "savings");
+}
+
+void TSPAlgorithmsTest::assignmentSolverTest() const {
+    std::cout << std::string(10, '-') << "Test \"assignmentSolver\" started" << std::string(10, '-') << std::endl;
+    const std::vector<std::string> instancePaths = {"MY/mdata5.txt", "SMALL/data18.txt", "ATSP/data34.txt",
+                                                    "TSP/data58.txt", "MIE/tsp_17.txt"};
+    IGraph *tspInstance = nullptr;
+    for (const auto &instancePath : instancePaths) {
+        std::cout << "Testing instance " + instancePath + "...";
+        delete tspInstance;
+        TSPUtils::loadTSPInstance(&tspInstance, instancePath);
+        const int instanceSize = tspInstance->getVertexCount();
+        std::vector<int> costs(instanceSize * instanceSize);
+        for (int i = 0; i < instanceSize; ++i) {
+            for (int j = 0; j < instanceSize; ++j) {
+                costs[i * instanceSize + j] = tspInstance->getEdgeParameter(i, j);
+            }
+        }
+
+        // Edges of the current assignment are forbidden or made cheaper one by one; every warm start has to give
+        // the value of a solve from scratch
+        AssignmentSolver warmSolver(costs, instanceSize);
+        long long warmValue = warmSolver.solve();
+        bool isPassed = true;
+        for (int row = 0; row < instanceSize && isPassed; ++row) {
+            const int column = warmSolver.getAssignment()[row];
+            const int cost = row % 2 == 0 ? AssignmentSolver::NO_EDGE : costs[row * instanceSize + column] / 2;
+            costs[row * instanceSize + column] = cost;
+            warmSolver.setCost(row, column, cost);
+            warmValue = warmSolver.solve();
+            isPassed &= warmValue == AssignmentSolver(costs, instanceSize).solve();
+        }
+        std::cout << (isPassed ? "SUCCESS" : "FAIL") << std::endl;
+    }
+    delete tspInstance;
+    std::cout << std::string(10, '-') << "Test \"assignmentSolver\" finished" << std::string(10, '-') << std::endl;
+}
+
 void TSPAlgorithmsTest::testLocalSearchAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
                                                  TSPLocalSearchAlgorithms::fLocalSearchAlgorithm fLocalSearchAlgorithm,
                                                  const LocalSearchParameters &parameters,
@@ -929,6 +1449,9 @@ void TSPAlgorithmsTest::geneticAlgorithmTest() const {
     gap.crossoverCoreFunction = TSPPopulationAlgorithms::OX;
     gap.mutationCoreFunction = TSPPopulationAlgorithms::insertionCore;
     testGeneticAlgorithm(fileGroups, gap, "GA");
+
+//    gap.createPopulationFunction = TSPPopulationAlgorithms::createPopulationWithSavings;
+//    testGeneticAlgorithm(fileGroups, gap, "GA (savings population)");
 }
 
 void TSPAlgorithmsTest::testGeneticAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
@@ -978,3 +1501,264 @@ void TSPAlgorithmsTest::testGeneticAlgorithm(const std::map<std::string, std::ve
 
 
 
+
+void TSPAlgorithmsTest::instanceContextTest() const {
+    std::cout << std::string(10, '-') << "Test \"instanceContext\" started" << std::string(10, '-') << std::endl;
+    const std::vector<std::string> instancePaths = {"MY/mdata5.txt", "SMALL/data12.txt", "ATSP/data34.txt",
+                                                    "TSP/data24.txt", "MIE/tsp_15.txt"};
+    const std::string contextPath = "instance_context_test.ctx";
+    IGraph *tspInstance = nullptr;
+    std::vector<int> solution, contextSolution;
+    int solutionValue, contextSolutionValue;
+    for (const auto &instancePath : instancePaths) {
+        std::cout << "Testing instance " + instancePath + "...";
+        delete tspInstance;
+        TSPUtils::loadTSPInstance(&tspInstance, instancePath);
+
+        InstanceContext(tspInstance).saveToFile(contextPath);
+        const auto instanceContext = InstanceContext::loadFromFile(contextPath, tspInstance);
+        bool isPassed = true;
+
+        solution.clear();
+        solutionValue = TSPGreedyAlgorithms::greedy(tspInstance, solution);
+        isPassed &= solution == instanceContext->getGreedyTour()
+                    && solutionValue == instanceContext->getGreedyTourValue();
+
+        solution.clear();
+        solutionValue = TSPGreedyAlgorithms::nearestNeighbour(tspInstance, solution);
+        isPassed &= solution == instanceContext->getNearestNeighbourTour()
+                    && solutionValue == instanceContext->getNearestNeighbourTourValue();
+
+        solution.clear();
+        solutionValue = TSPGreedyAlgorithms::karpPatching(tspInstance, solution);
+        isPassed &= solution == instanceContext->getKarpPatchingTour()
+                    && solutionValue == instanceContext->getKarpPatchingTourValue();
+
+        const BBNodeData rootNode = TSPExactAlgorithms::bbCreateRootNode(tspInstance);
+        isPassed &= rootNode.distances == instanceContext->getRootNode().distances
+                    && rootNode.lowerBound == instanceContext->getRootNode().lowerBound;
+
+        solution.clear();
+        contextSolution.clear();
+        solutionValue = TSPExactAlgorithms::branchAndBound(tspInstance, solution);
+        contextSolutionValue = TSPExactAlgorithms::branchAndBoundWithContext(tspInstance, *instanceContext,
+                                                                             contextSolution);
+        isPassed &= solutionValue == contextSolutionValue
+                    && TSPUtils::isSolutionValid(tspInstance, contextSolution, contextSolutionValue);
+
+        // Instance of the same size with one edge changed must be rejected
+        const int n = tspInstance->getVertexCount();
+        std::vector<std::vector<int>> matrix(n, std::vector<int>(n, 0));
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (i != j) {
+                    matrix[i][j] = tspInstance->getEdgeParameter(i, j);
+                }
+            }
+        }
+        ++matrix[0][1];
+        IGraph *otherInstance = nullptr;
+        TSPUtils::createTSPInstance(&otherInstance, matrix, TSPUtils::getTSPType(matrix));
+        try {
+            instanceContext->checkInstance(otherInstance);
+            isPassed = false;
+        } catch (const std::invalid_argument &) {}
+        delete otherInstance;
+
+        std::cout << (isPassed ? "SUCCESS" : "FAIL") << std::endl;
+    }
+    delete tspInstance;
+    std::remove(contextPath.c_str());
+    std::cout << std::string(10, '-') << "Test \"instanceContext\" finished" << std::string(10, '-') << std::endl;
+}
+
+void TSPAlgorithmsTest::checkpointTest() const {
+    std::cout << std::string(10, '-') << "Test \"checkpoint\" started" << std::string(10, '-') << std::endl;
+    const std::string checkpointPath = "checkpoint_test.ckpt";
+
+    std::cout << "Testing checkpoint file...";
+    bool isPassed = true;
+    {
+        CheckpointWriter checkpointWriter(checkpointPath, 7, 42);
+        checkpointWriter.submit("first");
+        checkpointWriter.submit("second");
+        checkpointWriter.flush();
+    }
+    isPassed &= CheckpointWriter::read(checkpointPath, 7, 42) == "second";
+    for (const auto &kindAndFingerprint : std::vector<std::pair<std::uint32_t, std::uint64_t>>{{8, 42}, {7, 43}}) {
+        try {
+            CheckpointWriter::read(checkpointPath, kindAndFingerprint.first, kindAndFingerprint.second);
+            isPassed = false;
+        } catch (const std::invalid_argument &) {}
+    }
+    {
+        std::fstream file(checkpointPath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('S');
+    }
+    try {
+        CheckpointWriter::read(checkpointPath, 7, 42);
+        isPassed = false;
+    } catch (const std::invalid_argument &) {}
+    std::cout << (isPassed ? "SUCCESS" : "FAIL") << std::endl;
+
+    // The damaged file is overwritten by the first run; checkpoints taken every millisecond
+    const std::vector<std::string> instancePaths = {"MY/mdata5.txt", "SMALL/data12.txt", "ATSP/data34.txt",
+                                                    "TSP/data24.txt"};
+    IGraph *tspInstance = nullptr;
+    std::vector<int> solution, checkpointSolution;
+    int solutionValue, checkpointSolutionValue;
+    for (const auto &instancePath : instancePaths) {
+        std::cout << "Testing instance " + instancePath + "...";
+        delete tspInstance;
+        TSPUtils::loadTSPInstance(&tspInstance, instancePath);
+
+        solution.clear();
+        checkpointSolution.clear();
+        solutionValue = TSPExactAlgorithms::branchAndBound(tspInstance, solution);
+        checkpointSolutionValue = TSPExactAlgorithms::branchAndBoundWithCheckpoint(tspInstance, checkpointPath, 1,
+                                                                                   checkpointSolution);
+        const bool isInstancePassed = solutionValue == checkpointSolutionValue
+                                      && TSPUtils::isSolutionValid(tspInstance, checkpointSolution,
+                                                                   checkpointSolutionValue)
+                                      && !std::filesystem::exists(checkpointPath);
+
+        std::cout << (isInstancePassed ? "SUCCESS" : "FAIL") << std::endl;
+    }
+    delete tspInstance;
+    std::remove(checkpointPath.c_str());
+    std::cout << std::string(10, '-') << "Test \"checkpoint\" finished" << std::string(10, '-') << std::endl;
+}
+
+void TSPAlgorithmsTest::distributedBranchAndBoundTest() const {
+    std::cout << std::string(10, '-') << "Test \"distributedBranchAndBound\" started" << std::string(10, '-')
+              << std::endl;
+    const std::vector<std::string> instancePaths = {"MY/mdata5.txt", "SMALL/data12.txt", "ATSP/data34.txt",
+                                                    "TSP/data24.txt", "ATSP/data39.txt"};
+    const std::string socketPath = "distributed_branch_and_bound_test.sock";
+    const int nWorkers = 3;
+    IGraph *tspInstance = nullptr;
+    std::vector<int> solution, distributedSolution;
+    int solutionValue, distributedSolutionValue;
+    for (const auto &instancePath : instancePaths) {
+        std::cout << "Testing instance " + instancePath + "...";
+        delete tspInstance;
+        TSPUtils::loadTSPInstance(&tspInstance, instancePath);
+
+        solution.clear();
+        distributedSolution.clear();
+        solutionValue = TSPExactAlgorithms::branchAndBound(tspInstance, solution);
+        ServerSocket serverSocket = ServerSocket::listenUnix(socketPath);
+        std::vector<std::thread> workerThreads;
+        for (int workerIdx = 0; workerIdx < nWorkers; ++workerIdx) {
+            workerThreads.emplace_back([&socketPath]() {
+                Socket socket = Socket::connectUnix(socketPath);
+                DistributedBranchAndBound::runWorker(socket);
+            });
+        }
+        distributedSolutionValue = DistributedBranchAndBound::runCoordinator(tspInstance, serverSocket, nWorkers,
+                                                                             distributedSolution);
+        for (auto &workerThread : workerThreads) {
+            workerThread.join();
+        }
+        const bool isPassed = solutionValue == distributedSolutionValue
+                              && TSPUtils::isSolutionValid(tspInstance, distributedSolution, distributedSolutionValue);
+
+        std::cout << (isPassed ? "SUCCESS" : "FAIL") << std::endl;
+    }
+    delete tspInstance;
+    std::cout << std::string(10, '-') << "Test \"distributedBranchAndBound\" finished" << std::string(10, '-')
+              << std::endl;
+}
+
+void TSPAlgorithmsTest::tabuMoveTableTest() const {
+    std::cout << std::string(10, '-') << "Test \"tabuMoveTable\" started" << std::string(10, '-') << std::endl;
+    const std::vector<std::string> instancePaths = {"MY/mdata5.txt", "SMALL/data12.txt", "ATSP/data17.txt",
+                                                    "TSP/data24.txt", "ATSP/data45.txt"};
+    const std::vector<std::pair<TabuMoveTable::MoveType, TSPLocalSearchAlgorithms::fNeighbourhood>> neighbourhoods = {
+            {TabuMoveTable::MoveType::Swap,   TSPLocalSearchAlgorithms::swapNeighbourhood},
+            {TabuMoveTable::MoveType::Insert, TSPLocalSearchAlgorithms::insertNeighbourhood},
+            {TabuMoveTable::MoveType::Invert, TSPLocalSearchAlgorithms::invertNeighbourhood}};
+    const std::vector<TSPLocalSearchAlgorithms::fNeighbourhoodDiff> neighbourhoodDiffs = {
+            TSPLocalSearchAlgorithms::swapNeighbourhoodTFValue, TSPLocalSearchAlgorithms::insertNeighbourhoodTFValue,
+            TSPLocalSearchAlgorithms::invertNeighbourhoodTFValue};
+    const int movesNumber = 100;
+    IGraph *tspInstance = nullptr;
+    std::vector<int> solution;
+    for (const auto &instancePath : instancePaths) {
+        std::cout << "Testing instance " + instancePath + "...";
+        delete tspInstance;
+        TSPUtils::loadTSPInstance(&tspInstance, instancePath);
+        const int instanceSize = tspInstance->getVertexCount();
+
+        bool isPassed = true;
+        for (std::size_t neighbourhoodIdx = 0; neighbourhoodIdx < neighbourhoods.size(); ++neighbourhoodIdx) {
+            TabuMoveTable moveTable(tspInstance, neighbourhoods[neighbourhoodIdx].first);
+            solution.clear();
+            const int solutionValue = TSPGreedyAlgorithms::createRandomPermutation(tspInstance, solution);
+            moveTable.reset(solution, solutionValue);
+            for (int moveIdx = 0; moveIdx < movesNumber && isPassed; ++moveIdx) {
+                // Random moves reach positions the best ones rarely change (wraps, whole tour)
+                int i, j;
+                do {
+                    i = Random::getInt(0, instanceSize - 1);
+                    j = Random::getInt(0, instanceSize - 1);
+                } while (neighbourhoods[neighbourhoodIdx].first == TabuMoveTable::MoveType::Insert
+                         ? i == j || i == j + 1 : i >= j);
+                if (moveIdx % 2 == 0) {
+                    int value;
+                    moveTable.findBestMove([](int, int, int) { return true; }, i, j, value);
+                }
+                moveTable.applyMove(i, j);
+                solution = neighbourhoods[neighbourhoodIdx].second(i, j, solution);
+                isPassed = solution == moveTable.getSolution()
+                           && moveTable.getSolutionValue()
+                              == TSPUtils::calculateTargetFunctionValue(tspInstance, solution);
+                for (int k = 0; k < instanceSize && isPassed; ++k) {
+                    for (int l = 0; l < instanceSize && isPassed; ++l) {
+                        if (neighbourhoods[neighbourhoodIdx].first == TabuMoveTable::MoveType::Insert
+                            ? k == l || k == l + 1 : k >= l) {
+                            continue;
+                        }
+                        const std::vector<int> neighbour = neighbourhoods[neighbourhoodIdx].second(k, l, solution);
+                        isPassed = moveTable.getMoveValue(k, l) == neighbourhoodDiffs[neighbourhoodIdx](
+                                tspInstance, k, l, solution, neighbour, moveTable.getSolutionValue());
+                    }
+                }
+            }
+        }
+
+        std::cout << (isPassed ? "SUCCESS" : "FAIL") << std::endl;
+    }
+    delete tspInstance;
+    std::cout << std::string(10, '-') << "Test \"tabuMoveTable\" finished" << std::string(10, '-') << std::endl;
+}
+
+void TSPAlgorithmsTest::solverRegistryTest() const {
+    std::cout << std::string(10, '-') << "Test \"solverRegistry\" started" << std::string(10, '-') << std::endl;
+    // {parameters, is accepted}
+    const std::vector<std::pair<std::map<std::string, std::string>, bool>> checkpointParameters = {
+            {{},                                  true},
+            {{{"checkpointInterval", "1000"}},    true},
+            {{{"checkpointInterval", "1"}},       true},
+            {{{"checkpointInterval", "0"}},       false},
+            {{{"checkpointInterval", "-5000"}},   false},
+            {{{"checkpointInterval", "1000ms"}},  false},
+            {{{"checkpointInterval", "1000"},
+              {"interval",           "1000"}},    false}};
+    for (const auto &testCase : checkpointParameters) {
+        std::string description = "bb-ckpt";
+        for (const auto &parameter : testCase.first) {
+            description += " " + parameter.first + "=" + parameter.second;
+        }
+        std::cout << "Testing " + description + "...";
+        bool isAccepted = true;
+        try {
+            static_cast<void>(SolverRegistry::createSolver("bb-ckpt", testCase.first));
+        } catch (const std::invalid_argument &e) {
+            isAccepted = false;
+        }
+        std::cout << (isAccepted == testCase.second ? "SUCCESS" : "FAIL") << std::endl;
+    }
+    std::cout << std::string(10, '-') << "Test \"solverRegistry\" finished" << std::string(10, '-') << std::endl;
+}
@@ -5,7 +5,14 @@
 
 #include "../utilities/TSPUtils.h"
 #include "../algorithms/TSPExactAlgorithms.h"
+#include "../algorithms/AssignmentSolver.h"
+#include "../algorithms/DistributedBranchAndBound.h"
+#include "../algorithms/TabuMoveTable.h"
+#include "../algorithms/InstanceContext.h"
+#include "../algorithms/SolverRegistry.h"
+#include "../utilities/CheckpointWriter.h"
 #include "../algorithms/TSPGreedyAlgorithms.h"
+#include "../algorithms/TSPTinyExactAlgorithms.h"
 #include "../algorithms/TSPLocalSearchAlgorithms.h"
 #include "../algorithms/helper_structures/LocalSearchParameters.h"
 #include "../algorithms/helper_structures/GeneticAlgorithmParameters.h"
@@ -22,7 +29,12 @@ private:
     void bruteForceTest() const;
     void bruteForceTreeTest() const;
     void dynamicProgrammingHeldKarpTest() const;
+    void dynamicProgrammingHeldKarpPrunedTest() const;
+    void dynamicProgrammingHeldKarpOutOfCoreTest() const;
+    void dynamicProgrammingHeldKarpSymmetricTest() const;
     void branchAndBoundTest() const;
+    void tinyHeldKarpTest() const;
+    void tinyHeldKarpBatchTest() const;
 
     //endregion
 
@@ -30,6 +42,11 @@ private:
 
     void nearestNeighbourTest() const;
     void greedyTest() const;
+    void karpPatchingTest() const;
+    void savingsTest() const;
+
+    // Warm-started AssignmentSolver against solves from scratch after single cost changes
+    void assignmentSolverTest() const;
 
     //endregion
 
@@ -39,6 +56,21 @@ private:
 
     void geneticAlgorithmTest() const;
 
+    // Cached tours and root node against fresh runs, save/load round trip, branchAndBoundWithContext
+    void instanceContextTest() const;
+
+    // CheckpointWriter round trip and rejection of damaged files, branchAndBoundWithCheckpoint against branchAndBound
+    void checkpointTest() const;
+
+    // SolverRegistry rejection of invalid solver parameters
+    void solverRegistryTest() const;
+
+    // DistributedBranchAndBound with workers on threads of this process against branchAndBound
+    void distributedBranchAndBoundTest() const;
+
+    // TabuMoveTable values after a sequence of moves against the neighbourhood value functions
+    void tabuMoveTableTest() const;
+
     // instanceFiles: map with paths to the instances in form {<directory of instances>, <vector with instance file names>}
     // first file name in the vector is a name of a solution file for instances in the directory
     void testExactOrGreedyAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
@@ -0,0 +1,326 @@
+#include "ThreadScalingMeasurement.h"
+#include "../algorithms/TSPExactAlgorithms.h"
+#include "../algorithms/TSPLocalSearchAlgorithms.h"
+#include "../algorithms/TSPPopulationAlgorithms.h"
+
+#include <filesystem>
+#include <limits>
+
+void ThreadScalingMeasurement::run() const {
+    std::vector<ThreadScalingPoint> scalingData;
+
+    scalingData = measureExactAlgorithm(getExactAlgorithmInstances(), TSPExactAlgorithms::dynamicProgrammingHeldKarp,
+                                        "dynamicProgrammingHeldKarp");
+    saveThreadScalingDataToFile("dynamic_programming", "DP (Held-Karp)", scalingData, false);
+
+    scalingData = measureExactAlgorithm(getExactAlgorithmInstances(), TSPExactAlgorithms::branchAndBound,
+                                        "branchAndBound");
+    saveThreadScalingDataToFile("branch_and_bound", "B&B (Little; NN; G)", scalingData, false);
+
+    LocalSearchParameters saParameters;
+    saParameters.setSimulatedAnnealingBestParameters();
+    scalingData = measureHeuristicAlgorithm(
+            getHeuristicAlgorithmInstances(),
+            [&saParameters](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+                return TSPLocalSearchAlgorithms::simulatedAnnealing(tspInstance, saParameters, outSolution);
+            }, "simulatedAnnealing", HEURISTIC_TIME_BUDGET_MS);
+    saveThreadScalingDataToFile("simulated_annealing", "SA", scalingData, true);
+
+    LocalSearchParameters tsParameters;
+    tsParameters.setTabuSearchBestParameters();
+    scalingData = measureHeuristicAlgorithm(
+            getHeuristicAlgorithmInstances(),
+            [&tsParameters](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+                return TSPLocalSearchAlgorithms::tabuSearchMatrix(tspInstance, tsParameters, outSolution);
+            }, "tabuSearchMatrix", HEURISTIC_TIME_BUDGET_MS);
+    saveThreadScalingDataToFile("tabu_search_matrix", "TS (matrix)", scalingData, true);
+
+    GeneticAlgorithmParameters gaParameters;
+    gaParameters.setBestParameters();
+    scalingData = measureHeuristicAlgorithm(
+            getHeuristicAlgorithmInstances(),
+            [&gaParameters](const IGraph *tspInstance, std::vector<int> &outSolution) -> int {
+                return TSPPopulationAlgorithms::geneticAlgorithm(tspInstance, gaParameters, outSolution);
+            }, "geneticAlgorithm", HEURISTIC_TIME_BUDGET_MS);
+    saveThreadScalingDataToFile("genetic_algorithm", "GA", scalingData, true);
+}
+
+std::vector<int> ThreadScalingMeasurement::getThreadCounts() const {
+    // hardware_concurrency() may return 0 if the value is not computable
+    const int maxThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    std::vector<int> threadCounts;
+    for (int nThreads = 1; nThreads < maxThreads; nThreads *= 2) {
+        threadCounts.emplace_back(nThreads);
+    }
+    threadCounts.emplace_back(maxThreads);
+    return threadCounts;
+}
+
+std::vector<ThreadScalingPoint>
+ThreadScalingMeasurement::measureExactAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
+                                                const fSolver &tspAlgorithm,
+                                                const std::string &algorithmName) const {
+    cout << std::string(10, '-') << "Thread scaling of \"" + algorithmName + "\"" + " started"
+         << std::string(10, '-') << endl;
+
+    // Instances are loaded once and shared (read only) by all threads
+    std::vector<IGraph *> tspInstances;
+    for (const auto &pair : instanceFiles) {
+        for (const auto &instanceFile : pair.second) {
+            tspInstances.emplace_back(nullptr);
+            TSPUtils::loadTSPInstance(&tspInstances.back(), pair.first + "/" + instanceFile);
+        }
+    }
+    if (tspInstances.empty()) {
+        throw std::invalid_argument("No instances provided for thread scaling of \"" + algorithmName + "\"");
+    }
+
+    // Work item k solves instance (k % instances count)
+    const int nWorkItems = REPETITIONS_NUMBER * static_cast<int>(tspInstances.size());
+
+    std::vector<ThreadScalingPoint> scalingPoints;
+    ThreadScalingPoint sp;
+    std::chrono::high_resolution_clock::time_point start, finish;
+    std::chrono::duration<double, std::milli> elapsed{};
+    for (int nThreads : getThreadCounts()) {
+        cout << "Measuring " << nThreads << " thread(s)...";
+        std::atomic<int> nextWorkItem(0);
+        auto worker = [&]() -> void {
+            std::vector<int> algorithmSolution;
+            for (int workItem = nextWorkItem++; workItem < nWorkItems; workItem = nextWorkItem++) {
+                algorithmSolution.clear();
+                tspAlgorithm(tspInstances[workItem % tspInstances.size()], algorithmSolution);
+            }
+        };
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (int threadIdx = 0; threadIdx < nThreads; ++threadIdx) {
+            threads.emplace_back(worker);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        finish = std::chrono::high_resolution_clock::now();
+        elapsed = finish - start;
+
+        sp = ThreadScalingPoint();
+        sp.nThreads = nThreads;
+        sp.time = elapsed.count();
+        sp.nRuns = nWorkItems;
+        sp.speedup = scalingPoints.empty() ? 1.0 : scalingPoints.front().time / sp.time;
+        sp.efficiency = sp.speedup / nThreads;
+        scalingPoints.emplace_back(sp);
+        cout << "DONE" << endl;
+    }
+
+    for (auto tspInstance : tspInstances) {
+        delete tspInstance;
+    }
+    cout << std::string(10, '-') << "Thread scaling of \"" + algorithmName + "\"" + " finished"
+         << std::string(10, '-') << endl;
+    return scalingPoints;
+}
+
+std::vector<ThreadScalingPoint>
+ThreadScalingMeasurement::measureHeuristicAlgorithm(
+        const std::map<std::string, std::vector<std::string>> &instanceFiles, const fSolver &tspAlgorithm,
+        const std::string &algorithmName, int timeBudgetMs) const {
+    cout << std::string(10, '-') << "Thread scaling of \"" + algorithmName + "\"" + " started"
+         << std::string(10, '-') << endl;
+
+    // <instance, optimal solution>
+    std::vector<std::pair<IGraph *, int>> tspInstances;
+    std::map<std::string, int> solutions;
+    for (const auto &pair : instanceFiles) {
+        if (pair.second.empty()) {
+            continue;
+        }
+        solutions = TSPUtils::loadTSPSolutionValues(pair.first + "/" + pair.second[0]);
+        for (int i = 1; i != pair.second.size(); ++i) {
+            tspInstances.emplace_back(nullptr, solutions.at(pair.second[i].substr(0, pair.second[i].find('.'))));
+            TSPUtils::loadTSPInstance(&tspInstances.back().first, pair.first + "/" + pair.second[i]);
+        }
+    }
+    if (tspInstances.empty()) {
+        throw std::invalid_argument("No instances provided for thread scaling of \"" + algorithmName + "\"");
+    }
+
+    std::vector<ThreadScalingPoint> scalingPoints;
+    ThreadScalingPoint sp;
+    std::chrono::high_resolution_clock::time_point start, finish;
+    std::chrono::duration<double, std::milli> elapsed{};
+    for (int nThreads : getThreadCounts()) {
+        cout << "Measuring " << nThreads << " thread(s)";
+        sp = ThreadScalingPoint();
+        sp.nThreads = nThreads;
+        sp.meanRelativeError = 0;
+        for (const auto &tspInstance : tspInstances) {
+            std::atomic<int> finishedRuns(0);
+            std::mutex bestSolutionMutex;
+            int bestSolutionValue = std::numeric_limits<int>::max();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudgetMs);
+            auto worker = [&]() -> void {
+                std::vector<int> algorithmSolution;
+                int algorithmSolutionValue;
+                while (std::chrono::steady_clock::now() < deadline) {
+                    algorithmSolution.clear();
+                    algorithmSolutionValue = tspAlgorithm(tspInstance.first, algorithmSolution);
+                    // Run which exceeded the budget does not count
+                    if (std::chrono::steady_clock::now() > deadline) {
+                        break;
+                    }
+                    ++finishedRuns;
+                    std::lock_guard<std::mutex> lock(bestSolutionMutex);
+                    if (algorithmSolutionValue < bestSolutionValue) {
+                        bestSolutionValue = algorithmSolutionValue;
+                    }
+                }
+            };
+
+            start = std::chrono::high_resolution_clock::now();
+            std::vector<std::thread> threads;
+            for (int threadIdx = 0; threadIdx < nThreads; ++threadIdx) {
+                threads.emplace_back(worker);
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            finish = std::chrono::high_resolution_clock::now();
+            elapsed = finish - start;
+
+            sp.time += elapsed.count();
+            sp.nRuns += finishedRuns;
+            if (bestSolutionValue != std::numeric_limits<int>::max()) {
+                sp.meanRelativeError +=
+                        100 * (bestSolutionValue - tspInstance.second) / static_cast<double>(tspInstance.second);
+            } else {
+                ++sp.nUnsolvedInstances;
+            }
+            cout << '.';
+        }
+        const int nSolvedInstances = static_cast<int>(tspInstances.size()) - sp.nUnsolvedInstances;
+        sp.meanRelativeError = nSolvedInstances > 0 ? sp.meanRelativeError / nSolvedInstances : -1;
+        sp.speedup = scalingPoints.empty() || scalingPoints.front().nRuns == 0 ?
+                     1.0 : static_cast<double>(sp.nRuns) / scalingPoints.front().nRuns;
+        sp.efficiency = sp.speedup / nThreads;
+        scalingPoints.emplace_back(sp);
+        cout << "DONE" << endl;
+    }
+
+    for (const auto &tspInstance : tspInstances) {
+        delete tspInstance.first;
+    }
+    cout << std::string(10, '-') << "Thread scaling of \"" + algorithmName + "\"" + " finished"
+         << std::string(10, '-') << endl;
+    return scalingPoints;
+}
+
+void ThreadScalingMeasurement::saveThreadScalingDataToFile(const std::string &fileName,
+                                                           const std::string &algorithmName,
+                                                           const std::vector<ThreadScalingPoint> &scalingPoints,
+                                                           bool isHeuristic) const {
+    const char sep = ',';
+    const std::string fileExtension = ".csv";
+    const std::string directory = "../time_tests/collected_data/thread_scaling/";
+    std::filesystem::create_directories(directory);
+    std::ofstream file(directory + fileName + fileExtension);
+    if (!file.is_open()) {
+        throw std::invalid_argument(fileName + fileExtension + " was not opened!");
+    }
+
+    cout << "Writing file " + fileName + fileExtension + "...";
+
+    if (isHeuristic) {
+        file << "Time budget" << sep << HEURISTIC_TIME_BUDGET_MS << endl;
+    } else {
+        file << "Repetitions number" << sep << REPETITIONS_NUMBER << endl;
+    }
+    file << "Time unit" << sep << "millisecond" << endl;
+    file << algorithmName << "\\Threads";
+    for (const auto &sp : scalingPoints) {
+        file << sep << sp.nThreads;
+    }
+    file << endl;
+    file << "Wall time";
+    for (const auto &sp : scalingPoints) {
+        file << sep << sp.time;
+    }
+    file << endl;
+    file << "Speedup";
+    for (const auto &sp : scalingPoints) {
+        file << sep << sp.speedup;
+    }
+    file << endl;
+    file << "Parallel efficiency";
+    for (const auto &sp : scalingPoints) {
+        file << sep << sp.efficiency;
+    }
+    file << endl;
+    file << "Runs";
+    for (const auto &sp : scalingPoints) {
+        file << sep << sp.nRuns;
+    }
+    file << endl;
+    if (isHeuristic) {
+        // Empty if no instance was solved within the time budget
+        file << "Mean relative error [%]";
+        for (const auto &sp : scalingPoints) {
+            file << sep;
+            if (sp.meanRelativeError >= 0) {
+                file << sp.meanRelativeError;
+            }
+        }
+        file << endl;
+        file << "Unsolved instances";
+        for (const auto &sp : scalingPoints) {
+            file << sep << sp.nUnsolvedInstances;
+        }
+        file << endl;
+    }
+
+    file.close();
+    cout << "FILE WRITTEN SUCCESSFULLY" << endl;
+}
+
+std::map<std::string, std::vector<std::string>> ThreadScalingMeasurement::getExactAlgorithmInstances() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // SMALL
+    filePaths.emplace_back("data14.txt");
+    filePaths.emplace_back("data15.txt");
+    filePaths.emplace_back("data16.txt");
+    filePaths.emplace_back("data18.txt");
+    fileGroups.insert({"SMALL", filePaths});
+    filePaths.clear();
+
+    // TSP
+    filePaths.emplace_back("data17.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    return fileGroups;
+}
+
+std::map<std::string, std::vector<std::string>> ThreadScalingMeasurement::getHeuristicAlgorithmInstances() const {
+    std::map<std::string, std::vector<std::string>> fileGroups;
+    std::vector<std::string> filePaths;
+
+    // ATSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data45.txt");
+    filePaths.emplace_back("data71.txt");
+    filePaths.emplace_back("data171.txt");
+    fileGroups.insert({"ATSP", filePaths});
+    filePaths.clear();
+
+    // TSP
+    filePaths.emplace_back("best.txt");
+    filePaths.emplace_back("data58.txt");
+    filePaths.emplace_back("data120.txt");
+    fileGroups.insert({"TSP", filePaths});
+    filePaths.clear();
+
+    return fileGroups;
+}
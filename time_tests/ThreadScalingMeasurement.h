@@ -0,0 +1,81 @@
+#ifndef PEA_P1_THREADSCALINGMEASUREMENT_H
+#define PEA_P1_THREADSCALINGMEASUREMENT_H
+
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "../structures/graphs/IGraph.h"
+#include "../utilities/TSPUtils.h"
+
+using std::cout;
+using std::endl;
+
+struct ThreadScalingPoint {
+    int nThreads;
+    // Wall time of the whole run
+    double time;
+    double speedup;
+    double efficiency;
+    // Heuristics only - number of finished algorithm runs within the time budget
+    int nRuns;
+    // Heuristics only - mean over solved instances of (best found - optimum) / optimum, -1 if none was solved
+    double meanRelativeError;
+    // Heuristics only - instances without a run finished within the time budget (not in meanRelativeError)
+    int nUnsolvedInstances;
+
+    ThreadScalingPoint() : nThreads(-1), time(0), speedup(0), efficiency(0), nRuns(0), meanRelativeError(-1),
+                           nUnsolvedInstances(0) {}
+};
+
+// Runs a solver on a fixed set of instances with 1, 2, 4, ..., N threads.
+// Exact algorithms: a fixed amount of work (every instance solved REPETITIONS_NUMBER times) is shared between
+// threads, speedup = T(1) / T(n).
+// Heuristics: every thread repeats the heuristic until the time budget is used up and the best solution is kept,
+// speedup = runs(n) / runs(1).
+class ThreadScalingMeasurement {
+public:
+
+    using fSolver = std::function<int(const IGraph *, std::vector<int> &)>;
+
+    // Start measurement
+    void run() const;
+
+private:
+
+    // Number of times every instance is solved by exact algorithm for each thread count
+    static const int REPETITIONS_NUMBER = 8;
+
+    // Time budget for one instance in heuristic mode
+    static const int HEURISTIC_TIME_BUDGET_MS = 2000;
+
+    [[nodiscard]] std::vector<int> getThreadCounts() const;
+
+    std::vector<ThreadScalingPoint>
+    measureExactAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
+                          const fSolver &tspAlgorithm, const std::string &algorithmName) const;
+
+    // instanceFiles: first file name in the vector is a name of a solution file for instances in the directory
+    std::vector<ThreadScalingPoint>
+    measureHeuristicAlgorithm(const std::map<std::string, std::vector<std::string>> &instanceFiles,
+                              const fSolver &tspAlgorithm, const std::string &algorithmName,
+                              int timeBudgetMs) const;
+
+    void saveThreadScalingDataToFile(const std::string &fileName, const std::string &algorithmName,
+                                     const std::vector<ThreadScalingPoint> &scalingPoints,
+                                     bool isHeuristic) const;
+
+    [[nodiscard]] std::map<std::string, std::vector<std::string>> getExactAlgorithmInstances() const;
+
+    [[nodiscard]] std::map<std::string, std::vector<std::string>> getHeuristicAlgorithmInstances() const;
+};
+
+
+#endif //PEA_P1_THREADSCALINGMEASUREMENT_H
@@ -0,0 +1,138 @@
+#include "BinaryStream.h"
+
+#include <cstring>
+#include <stdexcept>
+
+void BinaryWriter::writeUInt8(std::uint8_t value) {
+    buffer.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeUInt16(std::uint16_t value) {
+    for (int byteIdx = 0; byteIdx < 2; ++byteIdx) {
+        buffer.push_back(static_cast<char>((value >> (8 * byteIdx)) & 0xFFu));
+    }
+}
+
+void BinaryWriter::writeUInt32(std::uint32_t value) {
+    for (int byteIdx = 0; byteIdx < 4; ++byteIdx) {
+        buffer.push_back(static_cast<char>((value >> (8 * byteIdx)) & 0xFFu));
+    }
+}
+
+void BinaryWriter::writeUInt64(std::uint64_t value) {
+    for (int byteIdx = 0; byteIdx < 8; ++byteIdx) {
+        buffer.push_back(static_cast<char>((value >> (8 * byteIdx)) & 0xFFu));
+    }
+}
+
+void BinaryWriter::writeInt32(std::int32_t value) {
+    writeUInt32(static_cast<std::uint32_t>(value));
+}
+
+void BinaryWriter::writeInt64(std::int64_t value) {
+    writeUInt64(static_cast<std::uint64_t>(value));
+}
+
+void BinaryWriter::writeDouble(double value) {
+    static_assert(sizeof(double) == sizeof(std::uint64_t), "IEEE 754 double expected");
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeUInt64(bits);
+}
+
+void BinaryWriter::writeString(const std::string &value) {
+    writeUInt32(static_cast<std::uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+void BinaryWriter::writeInt32Vector(const std::vector<int> &values) {
+    writeUInt32(static_cast<std::uint32_t>(values.size()));
+    for (int value : values) {
+        writeInt32(value);
+    }
+}
+
+const std::string &BinaryWriter::getBuffer() const {
+    return buffer;
+}
+
+void BinaryWriter::clear() {
+    buffer.clear();
+}
+
+BinaryReader::BinaryReader(const char *data, std::size_t size) : data(data), size(size), position(0) {}
+
+BinaryReader::BinaryReader(const std::string &buffer) : BinaryReader(buffer.data(), buffer.size()) {}
+
+std::uint8_t BinaryReader::readUInt8() {
+    return static_cast<std::uint8_t>(readLittleEndian(1));
+}
+
+std::uint16_t BinaryReader::readUInt16() {
+    return static_cast<std::uint16_t>(readLittleEndian(2));
+}
+
+std::uint32_t BinaryReader::readUInt32() {
+    return static_cast<std::uint32_t>(readLittleEndian(4));
+}
+
+std::uint64_t BinaryReader::readUInt64() {
+    return readLittleEndian(8);
+}
+
+std::int32_t BinaryReader::readInt32() {
+    return static_cast<std::int32_t>(readUInt32());
+}
+
+std::int64_t BinaryReader::readInt64() {
+    return static_cast<std::int64_t>(readUInt64());
+}
+
+double BinaryReader::readDouble() {
+    std::uint64_t bits = readUInt64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string BinaryReader::readString() {
+    const std::uint32_t length = readUInt32();
+    if (length > getRemainingSize()) {
+        throw std::out_of_range("BinaryReader: string longer than remaining data");
+    }
+    std::string value(data + position, length);
+    position += length;
+    return value;
+}
+
+std::vector<int> BinaryReader::readInt32Vector() {
+    const std::uint32_t length = readUInt32();
+    if (length > getRemainingSize() / 4) {
+        throw std::out_of_range("BinaryReader: vector longer than remaining data");
+    }
+    std::vector<int> values(length);
+    for (auto &value : values) {
+        value = readInt32();
+    }
+    return values;
+}
+
+std::size_t BinaryReader::getRemainingSize() const {
+    return size - position;
+}
+
+bool BinaryReader::isAtEnd() const {
+    return position == size;
+}
+
+std::uint64_t BinaryReader::readLittleEndian(int nBytes) {
+    if (getRemainingSize() < static_cast<std::size_t>(nBytes)) {
+        throw std::out_of_range("BinaryReader: read past the end of data");
+    }
+    std::uint64_t value = 0;
+    for (int byteIdx = 0; byteIdx < nBytes; ++byteIdx) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[position + byteIdx])) << (8 * byteIdx);
+    }
+    position += nBytes;
+    return value;
+}
@@ -0,0 +1,78 @@
+#ifndef PEA_P1_BINARYSTREAM_H
+#define PEA_P1_BINARYSTREAM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Little-endian serialization independent of the host byte order. Strings are prefixed with uint32 length.
+class BinaryWriter {
+public:
+
+    void writeUInt8(std::uint8_t value);
+
+    void writeUInt16(std::uint16_t value);
+
+    void writeUInt32(std::uint32_t value);
+
+    void writeUInt64(std::uint64_t value);
+
+    void writeInt32(std::int32_t value);
+
+    void writeInt64(std::int64_t value);
+
+    void writeDouble(double value);
+
+    void writeString(const std::string &value);
+
+    void writeInt32Vector(const std::vector<int> &values);
+
+    [[nodiscard]] const std::string &getBuffer() const;
+
+    void clear();
+
+private:
+    std::string buffer;
+};
+
+// Reads data written by BinaryWriter. Throws std::out_of_range when reading past the end of the buffer.
+class BinaryReader {
+public:
+
+    // Buffer must outlive the reader
+    BinaryReader(const char *data, std::size_t size);
+
+    explicit BinaryReader(const std::string &buffer);
+
+    std::uint8_t readUInt8();
+
+    std::uint16_t readUInt16();
+
+    std::uint32_t readUInt32();
+
+    std::uint64_t readUInt64();
+
+    std::int32_t readInt32();
+
+    std::int64_t readInt64();
+
+    double readDouble();
+
+    std::string readString();
+
+    std::vector<int> readInt32Vector();
+
+    [[nodiscard]] std::size_t getRemainingSize() const;
+
+    [[nodiscard]] bool isAtEnd() const;
+
+private:
+    const char *data;
+    std::size_t size;
+    std::size_t position;
+
+    std::uint64_t readLittleEndian(int nBytes);
+};
+
+
+#endif //PEA_P1_BINARYSTREAM_H
@@ -0,0 +1,144 @@
+#include "CheckpointWriter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "BinaryStream.h"
+
+CheckpointWriter::CheckpointWriter(std::string path, std::uint32_t kind, std::uint64_t fingerprint)
+        : path(std::move(path)), kind(kind), fingerprint(fingerprint), hasPendingPayload(false), isWriting(false),
+          isStopping(false), writerThread(&CheckpointWriter::writerLoop, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        isStopping = true;
+    }
+    stateCondition.notify_all();
+    writerThread.join();
+}
+
+void CheckpointWriter::submit(std::string payload) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pendingPayload = std::move(payload);
+        hasPendingPayload = true;
+    }
+    stateCondition.notify_all();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    stateCondition.wait(lock, [this] { return !hasPendingPayload && !isWriting; });
+    if (!writeError.empty()) {
+        const std::string error = std::move(writeError);
+        writeError.clear();
+        throw std::runtime_error(error);
+    }
+}
+
+void CheckpointWriter::discard() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    hasPendingPayload = false;
+    pendingPayload.clear();
+    stateCondition.wait(lock, [this] { return !isWriting; });
+    std::remove(path.c_str());
+}
+
+std::string CheckpointWriter::read(const std::string &path, std::uint32_t kind, std::uint64_t fingerprint) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("File " + path + " cannot be opened");
+    }
+    const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    try {
+        BinaryReader reader(buffer);
+        if (reader.readUInt32() != FILE_MAGIC || reader.readUInt16() != FILE_VERSION) {
+            throw std::invalid_argument("File " + path + " is not a checkpoint of supported version");
+        }
+        if (reader.readUInt32() != kind || reader.readUInt64() != fingerprint) {
+            throw std::invalid_argument("File " + path + " is a checkpoint of other run or instance");
+        }
+        const std::uint64_t checksum = reader.readUInt64();
+        const std::uint64_t payloadSize = reader.readUInt64();
+        if (payloadSize != reader.getRemainingSize()) {
+            throw std::out_of_range("Truncated payload");
+        }
+        std::string payload = buffer.substr(buffer.size() - payloadSize);
+        if (calculateChecksum(payload) != checksum) {
+            throw std::out_of_range("Checksum mismatch");
+        }
+        return payload;
+    } catch (const std::out_of_range &e) {
+        throw std::invalid_argument("File " + path + " is not a valid checkpoint (" + e.what() + ")");
+    }
+}
+
+const std::string &CheckpointWriter::getPath() const {
+    return path;
+}
+
+void CheckpointWriter::writerLoop() {
+    std::string payload;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            isWriting = false;
+            stateCondition.notify_all();
+            stateCondition.wait(lock, [this] { return isStopping || hasPendingPayload; });
+            if (!hasPendingPayload) {
+                return;
+            }
+            payload = std::move(pendingPayload);
+            pendingPayload.clear();
+            hasPendingPayload = false;
+            isWriting = true;
+        }
+        try {
+            writeFile(payload);
+        } catch (const std::runtime_error &e) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            writeError = e.what();
+        }
+    }
+}
+
+void CheckpointWriter::writeFile(const std::string &payload) const {
+    BinaryWriter writer;
+    writer.writeUInt32(FILE_MAGIC);
+    writer.writeUInt16(FILE_VERSION);
+    writer.writeUInt32(kind);
+    writer.writeUInt64(fingerprint);
+    writer.writeUInt64(calculateChecksum(payload));
+    writer.writeUInt64(payload.size());
+
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("File " + temporaryPath + " cannot be opened");
+        }
+        file.write(writer.getBuffer().data(), static_cast<std::streamsize>(writer.getBuffer().size()));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!file) {
+            throw std::runtime_error("File " + temporaryPath + " cannot be written");
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        throw std::runtime_error("File " + temporaryPath + " cannot be renamed to " + path);
+    }
+}
+
+std::uint64_t CheckpointWriter::calculateChecksum(const std::string &payload) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char byte : payload) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
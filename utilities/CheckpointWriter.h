@@ -0,0 +1,66 @@
+#ifndef PEA_P1_CHECKPOINTWRITER_H
+#define PEA_P1_CHECKPOINTWRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Latest state of a long run kept in one file by a background thread - the run only serialises its state and hands
+// the payload over; a payload not written yet is replaced by a newer one. The file holds a magic, format version,
+// kind of the run, fingerprint of the instance and FNV-1a checksum of the payload. It is written aside and renamed,
+// so a run stopped mid-write leaves the previous checkpoint intact.
+class CheckpointWriter {
+public:
+    static const std::uint32_t FILE_MAGIC = 0x504B4350; // "PCKP"
+    static const std::uint16_t FILE_VERSION = 1;
+
+    CheckpointWriter(std::string path, std::uint32_t kind, std::uint64_t fingerprint);
+
+    // Writes the pending payload, if any
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    void submit(std::string payload);
+
+    // Waits until the last submitted payload is on disk. Throws std::runtime_error if a write failed since the last
+    // call.
+    void flush();
+
+    // Drops the pending payload and removes the file - the run is finished
+    void discard();
+
+    // Payload of the checkpoint in path. Throws std::runtime_error if it can't be opened and std::invalid_argument if
+    // it is not a checkpoint of supported version, of this kind of run and instance, or it is damaged.
+    static std::string read(const std::string &path, std::uint32_t kind, std::uint64_t fingerprint);
+
+    [[nodiscard]] const std::string &getPath() const;
+
+private:
+    std::string path;
+    std::uint32_t kind;
+    std::uint64_t fingerprint;
+
+    std::mutex stateMutex;
+    std::condition_variable stateCondition;
+    std::string pendingPayload;
+    bool hasPendingPayload;
+    bool isWriting;
+    bool isStopping;
+    std::string writeError;
+    std::thread writerThread;
+
+    void writerLoop();
+
+    // Throws std::runtime_error if the file can't be written
+    void writeFile(const std::string &payload) const;
+
+    static std::uint64_t calculateChecksum(const std::string &payload);
+};
+
+
+#endif //PEA_P1_CHECKPOINTWRITER_H
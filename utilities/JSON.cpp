@@ -0,0 +1,287 @@
+#include "JSON.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+class JSONValue::Parser {
+public:
+    explicit Parser(const std::string &text) : text(text), position(0) {}
+
+    JSONValue parseDocument() {
+        JSONValue value = parseValue(0);
+        skipWhitespace();
+        if (position != text.size()) {
+            fail("unexpected data after the value");
+        }
+        return value;
+    }
+
+private:
+    // Guards the recursion against maliciously nested input
+    static const int MAX_DEPTH = 64;
+
+    const std::string &text;
+    std::size_t position;
+
+    [[noreturn]] void fail(const std::string &message) const {
+        throw std::invalid_argument("JSON parse error at " + std::to_string(position) + ": " + message);
+    }
+
+    void skipWhitespace() {
+        while (position < text.size()
+               && (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' ||
+                   text[position] == '\r')) {
+            ++position;
+        }
+    }
+
+    void expectLiteral(const char *literal) {
+        for (; *literal != '\0'; ++literal, ++position) {
+            if (position >= text.size() || text[position] != *literal) {
+                fail("invalid literal");
+            }
+        }
+    }
+
+    JSONValue parseValue(int depth) {
+        if (depth > MAX_DEPTH) {
+            fail("nesting too deep");
+        }
+        skipWhitespace();
+        if (position >= text.size()) {
+            fail("unexpected end of input");
+        }
+        JSONValue value;
+        const char c = text[position];
+        if (c == '{') {
+            value.type = Type::Object;
+            ++position;
+            skipWhitespace();
+            if (position < text.size() && text[position] == '}') {
+                ++position;
+                return value;
+            }
+            while (true) {
+                skipWhitespace();
+                if (position >= text.size() || text[position] != '"') {
+                    fail("object key expected");
+                }
+                std::string key = parseString();
+                skipWhitespace();
+                if (position >= text.size() || text[position] != ':') {
+                    fail("':' expected");
+                }
+                ++position;
+                value.objectValue[key] = parseValue(depth + 1);
+                skipWhitespace();
+                if (position < text.size() && text[position] == ',') {
+                    ++position;
+                } else if (position < text.size() && text[position] == '}') {
+                    ++position;
+                    return value;
+                } else {
+                    fail("',' or '}' expected");
+                }
+            }
+        } else if (c == '[') {
+            value.type = Type::Array;
+            ++position;
+            skipWhitespace();
+            if (position < text.size() && text[position] == ']') {
+                ++position;
+                return value;
+            }
+            while (true) {
+                value.arrayValue.emplace_back(parseValue(depth + 1));
+                skipWhitespace();
+                if (position < text.size() && text[position] == ',') {
+                    ++position;
+                } else if (position < text.size() && text[position] == ']') {
+                    ++position;
+                    return value;
+                } else {
+                    fail("',' or ']' expected");
+                }
+            }
+        } else if (c == '"') {
+            value.type = Type::String;
+            value.stringValue = parseString();
+        } else if (c == 't') {
+            expectLiteral("true");
+            value.type = Type::Bool;
+            value.boolValue = true;
+        } else if (c == 'f') {
+            expectLiteral("false");
+            value.type = Type::Bool;
+            value.boolValue = false;
+        } else if (c == 'n') {
+            expectLiteral("null");
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            const char *begin = text.c_str() + position;
+            char *end = nullptr;
+            value.type = Type::Number;
+            value.numberValue = std::strtod(begin, &end);
+            if (end == begin) {
+                fail("invalid number");
+            }
+            position += end - begin;
+        } else {
+            fail("unexpected character");
+        }
+        return value;
+    }
+
+    std::string parseString() {
+        // Opening quote
+        ++position;
+        std::string result;
+        while (position < text.size() && text[position] != '"') {
+            char c = text[position++];
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+            if (position >= text.size()) {
+                break;
+            }
+            c = text[position++];
+            switch (c) {
+                case '"':
+                case '\\':
+                case '/':
+                    result += c;
+                    break;
+                case 'b':
+                    result += '\b';
+                    break;
+                case 'f':
+                    result += '\f';
+                    break;
+                case 'n':
+                    result += '\n';
+                    break;
+                case 'r':
+                    result += '\r';
+                    break;
+                case 't':
+                    result += '\t';
+                    break;
+                case 'u': {
+                    if (position + 4 > text.size()) {
+                        fail("invalid unicode escape");
+                    }
+                    const unsigned long codePoint = std::strtoul(text.substr(position, 4).c_str(), nullptr, 16);
+                    position += 4;
+                    // UTF-8 encoding
+                    if (codePoint < 0x80) {
+                        result += static_cast<char>(codePoint);
+                    } else if (codePoint < 0x800) {
+                        result += static_cast<char>(0xC0 | (codePoint >> 6));
+                        result += static_cast<char>(0x80 | (codePoint & 0x3F));
+                    } else {
+                        result += static_cast<char>(0xE0 | (codePoint >> 12));
+                        result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                        result += static_cast<char>(0x80 | (codePoint & 0x3F));
+                    }
+                    break;
+                }
+                default:
+                    fail("invalid escape");
+            }
+        }
+        if (position >= text.size()) {
+            fail("unterminated string");
+        }
+        // Closing quote
+        ++position;
+        return result;
+    }
+};
+
+JSONValue::JSONValue() : type(Type::Null), boolValue(false), numberValue(0) {}
+
+JSONValue JSONValue::parse(const std::string &text) {
+    return Parser(text).parseDocument();
+}
+
+std::string JSONValue::escape(const std::string &text) {
+    std::ostringstream escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped << '\\' << c;
+        } else if (c == '\n') {
+            escaped << "\\n";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                    << std::dec << std::setfill(' ');
+        } else {
+            escaped << c;
+        }
+    }
+    return escaped.str();
+}
+
+JSONValue::Type JSONValue::getType() const {
+    return type;
+}
+
+bool JSONValue::isNull() const {
+    return type == Type::Null;
+}
+
+bool JSONValue::getBool() const {
+    expectType(Type::Bool, "bool");
+    return boolValue;
+}
+
+double JSONValue::getNumber() const {
+    expectType(Type::Number, "number");
+    return numberValue;
+}
+
+int JSONValue::getInt() const {
+    expectType(Type::Number, "number");
+    if (numberValue != std::floor(numberValue) || numberValue < std::numeric_limits<int>::min()
+        || numberValue > std::numeric_limits<int>::max()) {
+        throw std::invalid_argument("JSON value is not an integer");
+    }
+    return static_cast<int>(numberValue);
+}
+
+const std::string &JSONValue::getString() const {
+    expectType(Type::String, "string");
+    return stringValue;
+}
+
+const std::vector<JSONValue> &JSONValue::getArray() const {
+    expectType(Type::Array, "array");
+    return arrayValue;
+}
+
+const std::map<std::string, JSONValue> &JSONValue::getObject() const {
+    expectType(Type::Object, "object");
+    return objectValue;
+}
+
+bool JSONValue::contains(const std::string &key) const {
+    return type == Type::Object && objectValue.find(key) != objectValue.end();
+}
+
+const JSONValue &JSONValue::at(const std::string &key) const {
+    expectType(Type::Object, "object");
+    auto valueIt = objectValue.find(key);
+    if (valueIt == objectValue.end()) {
+        throw std::invalid_argument("JSON object has no key \"" + key + "\"");
+    }
+    return valueIt->second;
+}
+
+void JSONValue::expectType(JSONValue::Type expectedType, const char *typeName) const {
+    if (type != expectedType) {
+        throw std::invalid_argument(std::string("JSON value is not a ") + typeName);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef PEA_P1_JSON_H
+#define PEA_P1_JSON_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Minimal JSON document model - enough for request/response messages, no streaming, no unicode escapes beyond
+// \uXXXX in the basic multilingual plane
+class JSONValue {
+public:
+
+    enum class Type {
+        Null, Bool, Number, String, Array, Object
+    };
+
+    JSONValue();
+
+    // Throws std::invalid_argument on malformed input
+    static JSONValue parse(const std::string &text);
+
+    // Quotes are not added
+    static std::string escape(const std::string &text);
+
+    [[nodiscard]] Type getType() const;
+
+    [[nodiscard]] bool isNull() const;
+
+    // Getters throw std::invalid_argument on type mismatch
+
+    [[nodiscard]] bool getBool() const;
+
+    [[nodiscard]] double getNumber() const;
+
+    // Number that must be integral and fit in int
+    [[nodiscard]] int getInt() const;
+
+    [[nodiscard]] const std::string &getString() const;
+
+    [[nodiscard]] const std::vector<JSONValue> &getArray() const;
+
+    [[nodiscard]] const std::map<std::string, JSONValue> &getObject() const;
+
+    [[nodiscard]] bool contains(const std::string &key) const;
+
+    // Throws std::invalid_argument if the value is not an object or the key is missing
+    [[nodiscard]] const JSONValue &at(const std::string &key) const;
+
+private:
+    Type type;
+    bool boolValue;
+    double numberValue;
+    std::string stringValue;
+    std::vector<JSONValue> arrayValue;
+    std::map<std::string, JSONValue> objectValue;
+
+    class Parser;
+
+    void expectType(Type expectedType, const char *typeName) const;
+};
+
+
+#endif //PEA_P1_JSON_H
@@ -0,0 +1,123 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    std::runtime_error systemError(const std::string &operation) {
+        return std::runtime_error(operation + " failed: " + std::strerror(errno));
+    }
+
+    // Closes the descriptor when the mapping is set up (or failed) - the mapping stays valid without it
+    class FileDescriptor {
+    public:
+        explicit FileDescriptor(int fd) : fd(fd) {}
+
+        ~FileDescriptor() {
+            if (fd != -1) {
+                ::close(fd);
+            }
+        }
+
+        FileDescriptor(const FileDescriptor &) = delete;
+
+        FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+        int fd;
+    };
+}
+
+MappedFile::MappedFile() : data(nullptr), size(0) {}
+
+MappedFile::MappedFile(void *data, std::size_t size) : data(data), size(size) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept: data(other.data), size(other.size) {
+    other.data = nullptr;
+    other.size = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        data = other.data;
+        size = other.size;
+        other.data = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+MappedFile MappedFile::create(const std::string &path, std::size_t size) {
+    FileDescriptor file(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600));
+    if (file.fd == -1) {
+        throw systemError("open(" + path + ")");
+    }
+    if (::ftruncate(file.fd, static_cast<off_t>(size)) != 0) {
+        throw systemError("ftruncate(" + path + ")");
+    }
+    if (size == 0) {
+        return MappedFile();
+    }
+    void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (data == MAP_FAILED) {
+        throw systemError("mmap(" + path + ")");
+    }
+    return MappedFile(data, size);
+}
+
+MappedFile MappedFile::openReadOnly(const std::string &path) {
+    FileDescriptor file(::open(path.c_str(), O_RDONLY));
+    if (file.fd == -1) {
+        throw systemError("open(" + path + ")");
+    }
+    struct stat fileStatus{};
+    if (::fstat(file.fd, &fileStatus) != 0) {
+        throw systemError("fstat(" + path + ")");
+    }
+    const auto size = static_cast<std::size_t>(fileStatus.st_size);
+    if (size == 0) {
+        return MappedFile();
+    }
+    void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file.fd, 0);
+    if (data == MAP_FAILED) {
+        throw systemError("mmap(" + path + ")");
+    }
+    return MappedFile(data, size);
+}
+
+void MappedFile::adviseSequential() const {
+    if (data != nullptr) {
+        // Only a hint - failure changes nothing
+        ::madvise(data, size, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedFile::close() {
+    if (data != nullptr) {
+        ::munmap(data, size);
+        data = nullptr;
+        size = 0;
+    }
+}
+
+char *MappedFile::getData() {
+    return static_cast<char *>(data);
+}
+
+const char *MappedFile::getData() const {
+    return static_cast<const char *>(data);
+}
+
+std::size_t MappedFile::getSize() const {
+    return size;
+}
@@ -0,0 +1,49 @@
+#ifndef PEA_P1_MAPPEDFILE_H
+#define PEA_P1_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// File mapped into memory (POSIX mmap) for its whole size. System errors are reported with std::runtime_error.
+class MappedFile {
+public:
+
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Creates (or truncates) path with size zero bytes, mapped read-write and shared - changes reach the file
+    static MappedFile create(const std::string &path, std::size_t size);
+
+    static MappedFile openReadOnly(const std::string &path);
+
+    // Hints the kernel that the mapping is read front to back (aggressive read-ahead, early page reuse)
+    void adviseSequential() const;
+
+    // Unmaps the file - its pages may be dropped from memory
+    void close();
+
+    [[nodiscard]] char *getData();
+
+    [[nodiscard]] const char *getData() const;
+
+    [[nodiscard]] std::size_t getSize() const;
+
+private:
+    // nullptr for empty files - they can't be mapped
+    void *data;
+    std::size_t size;
+
+    MappedFile(void *data, std::size_t size);
+};
+
+
+#endif //PEA_P1_MAPPEDFILE_H
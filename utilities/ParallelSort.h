@@ -0,0 +1,58 @@
+#ifndef PEA_P1_PARALLELSORT_H
+#define PEA_P1_PARALLELSORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// std::sort of chunks on separate threads, then pairwise std::inplace_merge of neighbouring chunks (also in
+// parallel). Not stable. Short ranges and single core machines are sorted by std::sort alone.
+template<class RandomIt, class Compare>
+void parallelSort(RandomIt first, RandomIt last, Compare compare) {
+    static const std::ptrdiff_t MIN_CHUNK_SIZE = 1 << 14;
+    const std::ptrdiff_t size = std::distance(first, last);
+    const std::ptrdiff_t nThreads = std::min<std::ptrdiff_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                                             size / MIN_CHUNK_SIZE);
+    if (nThreads <= 1) {
+        std::sort(first, last, compare);
+        return;
+    }
+
+    // Chunk k is [bounds[k], bounds[k + 1])
+    std::vector<RandomIt> bounds;
+    for (std::ptrdiff_t chunkIdx = 0; chunkIdx <= nThreads; ++chunkIdx) {
+        bounds.emplace_back(first + size * chunkIdx / nThreads);
+    }
+    std::vector<std::thread> threads;
+    for (std::size_t chunkIdx = 0; chunkIdx + 1 < bounds.size(); ++chunkIdx) {
+        threads.emplace_back([&bounds, chunkIdx, compare]() {
+            std::sort(bounds[chunkIdx], bounds[chunkIdx + 1], compare);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    while (bounds.size() > 2) {
+        threads.clear();
+        std::vector<RandomIt> mergedBounds;
+        for (std::size_t chunkIdx = 0; chunkIdx + 1 < bounds.size(); chunkIdx += 2) {
+            mergedBounds.emplace_back(bounds[chunkIdx]);
+            if (chunkIdx + 2 < bounds.size()) {
+                threads.emplace_back([&bounds, chunkIdx, compare]() {
+                    std::inplace_merge(bounds[chunkIdx], bounds[chunkIdx + 1], bounds[chunkIdx + 2], compare);
+                });
+            }
+        }
+        mergedBounds.emplace_back(bounds.back());
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        bounds.swap(mergedBounds);
+    }
+}
+
+
+#endif //PEA_P1_PARALLELSORT_H
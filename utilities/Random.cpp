@@ -1,6 +1,8 @@
 #include "Random.h"
 
-std::mt19937 Random::randomEngine(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+thread_local std::mt19937 Random::randomEngine(
+        std::chrono::high_resolution_clock::now().time_since_epoch().count() ^
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
 
 int Random::getInt(int min, int max) {
     return std::uniform_int_distribution<int>{min, max}(randomEngine);
@@ -15,6 +17,10 @@ double Random::getRealClosed(double min, double max) {
             randomEngine);
 }
 
+void Random::setSeed(unsigned int seed) {
+    randomEngine.seed(seed);
+}
+
 bool Random::getBool(bool value, double probability) {
     if (probability == 0) {
         return !value;
@@ -6,6 +6,8 @@
 #include <chrono>
 #include <limits>
 #include <cmath>
+#include <thread>
+#include <functional>
 
 class Random {
 
@@ -23,10 +25,14 @@ public:
     // Get value with given probability
     [[nodiscard]] static bool getBool(bool value, double probability);
 
+    // Reseeds the engine of the calling thread only
+    static void setSeed(unsigned int seed);
+
 private:
     Random() = default;
 
-    static std::mt19937 randomEngine;
+    // One engine per thread - algorithms may be run concurrently (see ThreadScalingMeasurement)
+    static thread_local std::mt19937 randomEngine;
 
 };
 
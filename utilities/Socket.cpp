@@ -0,0 +1,348 @@
+#include "Socket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    std::runtime_error systemError(const std::string &operation) {
+        return std::runtime_error(operation + " failed: " + std::strerror(errno));
+    }
+
+    sockaddr_un createUnixAddress(const std::string &path) {
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("Unix socket path too long: " + path);
+        }
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+
+    // False if address is not "HOST:PORT"
+    bool parseTcpAddress(const std::string &address, std::string &outHost, int &outPort) {
+        const std::size_t colonIdx = address.rfind(':');
+        if (address.find('/') != std::string::npos || colonIdx == std::string::npos || colonIdx + 1 == address.size()
+            || address.find_first_not_of("0123456789", colonIdx + 1) != std::string::npos
+            || address.size() - colonIdx > 6) {
+            return false;
+        }
+        outHost = address.substr(0, colonIdx);
+        outPort = std::stoi(address.substr(colonIdx + 1));
+        return true;
+    }
+
+    // Addresses of host (nullptr - any) for stream sockets; the result is freed with freeaddrinfo
+    addrinfo *resolveTcpAddress(const char *host, int port, bool isPassive) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = isPassive ? AI_PASSIVE : 0;
+        addrinfo *addresses = nullptr;
+        const int result = ::getaddrinfo(host, std::to_string(port).c_str(), &hints, &addresses);
+        if (result != 0) {
+            throw std::runtime_error("getaddrinfo(" + std::string(host != nullptr ? host : "") + ") failed: "
+                                     + ::gai_strerror(result));
+        }
+        return addresses;
+    }
+}
+
+Socket::Socket() : fd(-1) {}
+
+Socket::Socket(int fd) : fd(fd) {}
+
+Socket::~Socket() {
+    close();
+}
+
+Socket::Socket(Socket &&other) noexcept: fd(other.fd) {
+    other.fd = -1;
+}
+
+Socket &Socket::operator=(Socket &&other) noexcept {
+    if (this != &other) {
+        close();
+        fd = other.fd;
+        other.fd = -1;
+    }
+    return *this;
+}
+
+Socket Socket::connectUnix(const std::string &path) {
+    sockaddr_un address = createUnixAddress(path);
+    Socket socket(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (!socket.isOpen()) {
+        throw systemError("socket()");
+    }
+    if (::connect(socket.fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        throw systemError("connect(" + path + ")");
+    }
+    return socket;
+}
+
+Socket Socket::connectTcp(const std::string &host, int port) {
+    addrinfo *addresses = resolveTcpAddress(host.c_str(), port, false);
+    Socket socket;
+    for (addrinfo *address = addresses; address != nullptr && !socket.isOpen(); address = address->ai_next) {
+        socket = Socket(::socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+        if (socket.isOpen() && ::connect(socket.fd, address->ai_addr, address->ai_addrlen) != 0) {
+            socket.close();
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (!socket.isOpen()) {
+        throw systemError("connect(" + host + ":" + std::to_string(port) + ")");
+    }
+    // Frames are small messages - sent at once instead of waiting for more data
+    const int isNoDelay = 1;
+    ::setsockopt(socket.fd, IPPROTO_TCP, TCP_NODELAY, &isNoDelay, sizeof(isNoDelay));
+    return socket;
+}
+
+Socket Socket::connect(const std::string &address) {
+    std::string host;
+    int port;
+    if (parseTcpAddress(address, host, port)) {
+        return connectTcp(host, port);
+    }
+    return connectUnix(address);
+}
+
+void Socket::sendFrame(const std::string &payload) {
+    if (payload.size() > MAX_FRAME_SIZE) {
+        throw std::invalid_argument("Frame too large");
+    }
+    char header[4];
+    const auto length = static_cast<std::uint32_t>(payload.size());
+    for (int byteIdx = 0; byteIdx < 4; ++byteIdx) {
+        header[byteIdx] = static_cast<char>((length >> (8 * byteIdx)) & 0xFFu);
+    }
+    sendAll(header, sizeof(header));
+    sendAll(payload.data(), payload.size());
+}
+
+bool Socket::receiveFrame(std::string &outPayload) {
+    char header[4];
+    const std::size_t headerSize = receiveAll(header, sizeof(header));
+    if (headerSize == 0) {
+        return false;
+    }
+    if (headerSize != sizeof(header)) {
+        throw std::runtime_error("Connection closed inside a frame header");
+    }
+    std::uint32_t length = 0;
+    for (int byteIdx = 0; byteIdx < 4; ++byteIdx) {
+        length |= static_cast<std::uint32_t>(static_cast<unsigned char>(header[byteIdx])) << (8 * byteIdx);
+    }
+    if (length > MAX_FRAME_SIZE) {
+        throw std::runtime_error("Frame too large: " + std::to_string(length) + " bytes");
+    }
+    outPayload.resize(length);
+    if (receiveAll(&outPayload[0], length) != length) {
+        throw std::runtime_error("Connection closed inside a frame");
+    }
+    return true;
+}
+
+bool Socket::waitReadable(int timeoutMs) const {
+    pollfd pollFd{fd, POLLIN, 0};
+    const int result = ::poll(&pollFd, 1, timeoutMs);
+    if (result < 0) {
+        if (errno == EINTR) {
+            return false;
+        }
+        throw systemError("poll()");
+    }
+    return result > 0;
+}
+
+void Socket::shutdown() {
+    if (fd != -1) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void Socket::close() {
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool Socket::isOpen() const {
+    return fd != -1;
+}
+
+int Socket::getFd() const {
+    return fd;
+}
+
+void Socket::sendAll(const char *data, std::size_t size) {
+    std::size_t nSent = 0;
+    while (nSent < size) {
+        // MSG_NOSIGNAL - a closed peer results in an exception instead of SIGPIPE
+        const ssize_t result = ::send(fd, data + nSent, size - nSent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("send()");
+        }
+        nSent += static_cast<std::size_t>(result);
+    }
+}
+
+std::size_t Socket::receiveAll(char *data, std::size_t size) {
+    std::size_t nReceived = 0;
+    while (nReceived < size) {
+        const ssize_t result = ::recv(fd, data + nReceived, size - nReceived, 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("recv()");
+        }
+        if (result == 0) {
+            break;
+        }
+        nReceived += static_cast<std::size_t>(result);
+    }
+    return nReceived;
+}
+
+ServerSocket::ServerSocket() : fd(-1) {}
+
+ServerSocket::~ServerSocket() {
+    close();
+}
+
+ServerSocket::ServerSocket(ServerSocket &&other) noexcept: fd(other.fd), unixPath(std::move(other.unixPath)) {
+    other.fd = -1;
+    other.unixPath.clear();
+}
+
+ServerSocket &ServerSocket::operator=(ServerSocket &&other) noexcept {
+    if (this != &other) {
+        close();
+        fd = other.fd;
+        unixPath = std::move(other.unixPath);
+        other.fd = -1;
+        other.unixPath.clear();
+    }
+    return *this;
+}
+
+ServerSocket ServerSocket::listenUnix(const std::string &path, int backlog) {
+    sockaddr_un address = createUnixAddress(path);
+    ServerSocket serverSocket;
+    serverSocket.fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (serverSocket.fd == -1) {
+        throw systemError("socket()");
+    }
+    ::unlink(path.c_str());
+    if (::bind(serverSocket.fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        throw systemError("bind(" + path + ")");
+    }
+    serverSocket.unixPath = path;
+    if (::listen(serverSocket.fd, backlog) != 0) {
+        throw systemError("listen()");
+    }
+    return serverSocket;
+}
+
+ServerSocket ServerSocket::listenTcp(const std::string &host, int port, int backlog) {
+    addrinfo *addresses = resolveTcpAddress(host.empty() ? nullptr : host.c_str(), port, true);
+    ServerSocket serverSocket;
+    for (addrinfo *address = addresses; address != nullptr && !serverSocket.isOpen(); address = address->ai_next) {
+        serverSocket.fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (serverSocket.fd == -1) {
+            continue;
+        }
+        // Restarted servers can bind while connections of the previous one are in TIME_WAIT
+        const int isReused = 1;
+        ::setsockopt(serverSocket.fd, SOL_SOCKET, SO_REUSEADDR, &isReused, sizeof(isReused));
+        if (::bind(serverSocket.fd, address->ai_addr, address->ai_addrlen) != 0) {
+            serverSocket.close();
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (!serverSocket.isOpen()) {
+        throw systemError("bind(" + host + ":" + std::to_string(port) + ")");
+    }
+    if (::listen(serverSocket.fd, backlog) != 0) {
+        throw systemError("listen()");
+    }
+    return serverSocket;
+}
+
+ServerSocket ServerSocket::listen(const std::string &address, int backlog) {
+    std::string host;
+    int port;
+    if (parseTcpAddress(address, host, port)) {
+        return listenTcp(host, port, backlog);
+    }
+    return listenUnix(address, backlog);
+}
+
+Socket ServerSocket::accept(int timeoutMs) {
+    pollfd pollFd{fd, POLLIN, 0};
+    const int result = ::poll(&pollFd, 1, timeoutMs);
+    if (result < 0) {
+        if (errno == EINTR) {
+            return Socket();
+        }
+        throw systemError("poll()");
+    }
+    if (result == 0) {
+        return Socket();
+    }
+    const int clientFd = ::accept(fd, nullptr, nullptr);
+    if (clientFd == -1) {
+        if (errno == EINTR || errno == EAGAIN || errno == ECONNABORTED) {
+            return Socket();
+        }
+        throw systemError("accept()");
+    }
+    // As in connectTcp; fails harmlessly for Unix sockets
+    const int isNoDelay = 1;
+    ::setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &isNoDelay, sizeof(isNoDelay));
+    return Socket(clientFd);
+}
+
+void ServerSocket::close() {
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (!unixPath.empty()) {
+        ::unlink(unixPath.c_str());
+        unixPath.clear();
+    }
+}
+
+bool ServerSocket::isOpen() const {
+    return fd != -1;
+}
+
+int ServerSocket::getPort() const {
+    sockaddr_storage address{};
+    socklen_t addressSize = sizeof(address);
+    if (::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &addressSize) != 0) {
+        throw systemError("getsockname()");
+    }
+    if (address.ss_family == AF_INET) {
+        return ntohs(reinterpret_cast<sockaddr_in *>(&address)->sin_port);
+    } else if (address.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<sockaddr_in6 *>(&address)->sin6_port);
+    }
+    throw std::invalid_argument("Not a TCP socket");
+}
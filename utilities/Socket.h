@@ -0,0 +1,105 @@
+#ifndef PEA_P1_SOCKET_H
+#define PEA_P1_SOCKET_H
+
+#include <cstdint>
+#include <string>
+
+// Connected stream socket (POSIX) exchanging frames: uint32 little-endian payload length followed by the payload.
+// System errors are reported with std::runtime_error.
+class Socket {
+public:
+
+    // Frames above this size are rejected - protects from reading garbage as a length
+    static const std::uint32_t MAX_FRAME_SIZE = 256u << 20u;
+
+    Socket();
+
+    // Takes ownership of the descriptor
+    explicit Socket(int fd);
+
+    ~Socket();
+
+    Socket(Socket &&other) noexcept;
+
+    Socket &operator=(Socket &&other) noexcept;
+
+    Socket(const Socket &) = delete;
+
+    Socket &operator=(const Socket &) = delete;
+
+    static Socket connectUnix(const std::string &path);
+
+    // host - name or numeric address
+    static Socket connectTcp(const std::string &host, int port);
+
+    // "HOST:PORT" - TCP, anything else - path of a Unix socket
+    static Socket connect(const std::string &address);
+
+    void sendFrame(const std::string &payload);
+
+    // Returns false if the peer closed the connection before a new frame started
+    bool receiveFrame(std::string &outPayload);
+
+    // Returns false if nothing arrived within timeoutMs (0 - only checks, negative - waits forever)
+    bool waitReadable(int timeoutMs) const;
+
+    // Unblocks a receive in progress in another thread
+    void shutdown();
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const;
+
+    [[nodiscard]] int getFd() const;
+
+private:
+    int fd;
+
+    void sendAll(const char *data, std::size_t size);
+
+    // Returns number of bytes read - less than size only if the peer closed the connection
+    std::size_t receiveAll(char *data, std::size_t size);
+};
+
+class ServerSocket {
+public:
+
+    ServerSocket();
+
+    ~ServerSocket();
+
+    ServerSocket(ServerSocket &&other) noexcept;
+
+    ServerSocket &operator=(ServerSocket &&other) noexcept;
+
+    ServerSocket(const ServerSocket &) = delete;
+
+    ServerSocket &operator=(const ServerSocket &) = delete;
+
+    // Removes a stale socket file at path
+    static ServerSocket listenUnix(const std::string &path, int backlog = 64);
+
+    // Empty host - all interfaces; port 0 - any free port (see getPort)
+    static ServerSocket listenTcp(const std::string &host, int port, int backlog = 64);
+
+    // Address as in Socket::connect
+    static ServerSocket listen(const std::string &address, int backlog = 64);
+
+    // Returns a closed Socket if no connection arrived within timeoutMs
+    Socket accept(int timeoutMs);
+
+    void close();
+
+    [[nodiscard]] bool isOpen() const;
+
+    // Port of a TCP socket
+    [[nodiscard]] int getPort() const;
+
+private:
+    int fd;
+    // Unix socket file removed on close
+    std::string unixPath;
+};
+
+
+#endif //PEA_P1_SOCKET_H
@@ -2,6 +2,7 @@
 
 
 std::string TSPUtils::loadTSPInstance(IGraph **pGraph, const std::string &path, TSPUtils::TSPType tspType) {
+    TRACE_SCOPE("TSPUtils::loadTSPInstance");
     std::fstream file("../input_data/" + path);
     std::string instanceName;
     if (!file.is_open()) {
@@ -47,10 +48,11 @@ std::string TSPUtils::loadTSPInstance(IGraph **pGraph, const std::string &path,
 }
 
 std::string TSPUtils::loadTSPInstanceAbsolutePath(IGraph **pGraph, const std::string &path, TSPUtils::TSPType tspType) {
+    TRACE_SCOPE("TSPUtils::loadTSPInstance");
     std::fstream file(path);
     std::string instanceName;
     if (!file.is_open()) {
-        throw std::invalid_argument("File with path /input_data/" + path + " does not exist.");
+        throw std::invalid_argument("File with path " + path + " does not exist.");
     }
 
     int nVertex, edgeParameter;
@@ -91,6 +93,45 @@ std::string TSPUtils::loadTSPInstanceAbsolutePath(IGraph **pGraph, const std::st
     return instanceName;
 }
 
+void TSPUtils::createTSPInstance(IGraph **pGraph, const std::vector<std::vector<int>> &matrix,
+                                 TSPUtils::TSPType tspType) {
+    const int nVertex = static_cast<int>(matrix.size());
+    for (const auto &row : matrix) {
+        if (row.size() != nVertex) {
+            throw std::invalid_argument("Error: provided matrix is not square");
+        }
+    }
+
+    if (tspType == TSPUtils::TSPType::Asymmetric) {
+        *pGraph = new ListGraph(IGraph::GraphType::Directed, nVertex);
+        for (int i = 0; i < nVertex; ++i) {
+            for (int j = 0; j < nVertex; ++j) {
+                if (i != j) {
+                    (*pGraph)->addEdge(i, j, matrix[i][j]);
+                }
+            }
+        }
+    } else {
+        *pGraph = new ListGraph(IGraph::GraphType::Undirected, nVertex);
+        for (int i = 0; i < nVertex; ++i) {
+            for (int j = i + 1; j < nVertex; ++j) {
+                (*pGraph)->addEdge(i, j, matrix[i][j]);
+            }
+        }
+    }
+}
+
+TSPUtils::TSPType TSPUtils::getTSPType(const std::vector<std::vector<int>> &matrix) {
+    for (int i = 0; i < matrix.size(); ++i) {
+        for (int j = i + 1; j < matrix.size(); ++j) {
+            if (matrix[i][j] != matrix[j][i]) {
+                return TSPType::Asymmetric;
+            }
+        }
+    }
+    return TSPType::Symmetric;
+}
+
 TSPUtils::TSPType TSPUtils::getTSPType(const std::string &path) {
     std::fstream file("../input_data/" + path);
     if (!file.is_open()) {
@@ -139,7 +180,7 @@ TSPUtils::TSPType TSPUtils::getTSPType(const std::string &path) {
 TSPUtils::TSPType TSPUtils::getTSPTypeAbsolutePath(const std::string &path) {
     std::fstream file(path);
     if (!file.is_open()) {
-        throw std::invalid_argument("File with path /input_data/" + path + " does not exist.");
+        throw std::invalid_argument("File with path " + path + " does not exist.");
     }
 
     std::string instanceName;
@@ -332,7 +373,7 @@ std::ostream &operator<<(std::ostream &ostr, std::vector<int> permutation) {
     return ostr;
 }
 
-bool TSPUtils::isSolutionValid(IGraph *tspInstance, const std::vector<int> &solutionPermutation,
+bool TSPUtils::isSolutionValid(const IGraph *tspInstance, const std::vector<int> &solutionPermutation,
                                int solutionPathCost) {
     const int instanceSize = tspInstance->getVertexCount();
 
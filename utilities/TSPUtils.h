@@ -15,6 +15,7 @@
 #include "../structures/graphs/IGraph.h"
 #include "../structures/graphs/ListGraph.h"
 #include "../algorithms/TSPExactAlgorithms.h"
+#include "Trace.h"
 
 
 class TSPUtils {
@@ -29,6 +30,9 @@ public:
 
     static std::string loadTSPInstanceAbsolutePath(IGraph **pGraph, const std::string &path, TSPType tspType);
 
+    // Diagonal of the matrix is ignored
+    static void createTSPInstance(IGraph **pGraph, const std::vector<std::vector<int>> &matrix, TSPType tspType);
+
     // Returns map with entries {<instance file name>, <solution value>}
     static std::map<std::string, int> loadTSPSolutionValues(const std::string &file);
 
@@ -38,6 +42,8 @@ public:
 
     static TSPType getTSPTypeAbsolutePath(const std::string &path);
 
+    static TSPType getTSPType(const std::vector<std::vector<int>> &matrix);
+
 
     static int calculateTargetFunctionValue(const IGraph *tspInstance, const DoublyLinkedList<int> &vertexPermutation);
 
@@ -51,7 +57,7 @@ public:
     static int calculateTargetFunctionValue(const IGraph *tspInstance, int fixedStartVertex,
                                             const std::list<int> &vertexPermutation);
 
-    bool static isSolutionValid(IGraph *tspInstance, const std::vector<int> &solutionPermutation,
+    bool static isSolutionValid(const IGraph *tspInstance, const std::vector<int> &solutionPermutation,
                          int solutionPathCost);
 
     bool static areSolutionsEqual(const std::vector<int> &solution1, const std::vector<int> &solution2);
@@ -0,0 +1,59 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int nThreads) : isStopping(false) {
+    if (nThreads <= 0) {
+        nThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int threadIdx = 0; threadIdx < nThreads; ++threadIdx) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        isStopping = true;
+    }
+    tasksCondition.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> result = packagedTask.get_future();
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        tasks.emplace(std::move(packagedTask));
+    }
+    tasksCondition.notify_one();
+    return result;
+}
+
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size());
+}
+
+int ThreadPool::getQueuedTaskCount() const {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    return static_cast<int>(tasks.size());
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(tasksMutex);
+            tasksCondition.wait(lock, [this] { return isStopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef PEA_P1_THREADPOOL_H
+#define PEA_P1_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed number of worker threads executing submitted tasks in FIFO order
+class ThreadPool {
+public:
+
+    // nThreads <= 0 - std::thread::hardware_concurrency()
+    explicit ThreadPool(int nThreads);
+
+    // Finishes queued tasks, then joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Exceptions thrown by the task are rethrown by future::get()
+    std::future<void> submit(std::function<void()> task);
+
+    [[nodiscard]] int getThreadCount() const;
+
+    [[nodiscard]] int getQueuedTaskCount() const;
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::packaged_task<void()>> tasks;
+    mutable std::mutex tasksMutex;
+    std::condition_variable tasksCondition;
+    bool isStopping;
+
+    void workerLoop();
+};
+
+
+#endif //PEA_P1_THREADPOOL_H
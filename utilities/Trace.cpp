@@ -0,0 +1,110 @@
+#include "Trace.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+std::mutex Trace::buffersMutex;
+std::vector<std::shared_ptr<TraceBuffer>> Trace::buffers;
+
+TraceBuffer::TraceBuffer(int threadId) : threadId(threadId), events(new TraceEvent[CAPACITY]), size(0),
+                                         nDropped(0) {}
+
+void TraceBuffer::record(const char *name, long long start, long long end) {
+    const int currentSize = size.load(std::memory_order_relaxed);
+    if (currentSize == CAPACITY) {
+        nDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    events[currentSize] = TraceEvent{name, start, end - start};
+    size.store(currentSize + 1, std::memory_order_release);
+}
+
+int TraceBuffer::getThreadId() const {
+    return threadId;
+}
+
+int TraceBuffer::getSize() const {
+    return size.load(std::memory_order_acquire);
+}
+
+const TraceEvent &TraceBuffer::getEvent(int idx) const {
+    return events[idx];
+}
+
+long long TraceBuffer::getDroppedCount() const {
+    return nDropped.load(std::memory_order_relaxed);
+}
+
+void TraceBuffer::clear() {
+    size.store(0, std::memory_order_release);
+    nDropped.store(0, std::memory_order_relaxed);
+}
+
+long long Trace::now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Trace::record(const char *name, long long start, long long end) {
+    getThreadBuffer().record(name, start, end);
+}
+
+TraceBuffer &Trace::getThreadBuffer() {
+    // Registration is the only locked step and happens once per thread
+    thread_local std::shared_ptr<TraceBuffer> threadBuffer = [] {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.emplace_back(std::make_shared<TraceBuffer>(static_cast<int>(buffers.size())));
+        return buffers.back();
+    }();
+    return *threadBuffer;
+}
+
+void Trace::dumpChromeTrace(const std::string &path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::invalid_argument("Could not open trace file " + path);
+    }
+
+    auto writeEscaped = [&file](const char *text) {
+        for (; *text != '\0'; ++text) {
+            if (*text == '"' || *text == '\\') {
+                file << '\\';
+            }
+            file << *text;
+        }
+    };
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    file << std::fixed << std::setprecision(3);
+    bool isFirst = true;
+    for (const auto &buffer : buffers) {
+        const int nEvents = buffer->getSize();
+        for (int eventIdx = 0; eventIdx < nEvents; ++eventIdx) {
+            const TraceEvent &event = buffer->getEvent(eventIdx);
+            file << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+            // Trace-event timestamps are in microseconds
+            file << "{\"name\":\"";
+            writeEscaped(event.name);
+            file << "\",\"cat\":\"PEA_p1\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->getThreadId()
+                 << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0 << "}";
+        }
+        if (buffer->getDroppedCount() > 0) {
+            file << (isFirst ? "\n" : ",\n");
+            isFirst = false;
+            file << "{\"name\":\"dropped events\",\"ph\":\"C\",\"pid\":1,\"tid\":" << buffer->getThreadId()
+                 << ",\"ts\":0,\"args\":{\"count\":" << buffer->getDroppedCount() << "}}";
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+}
+
+void Trace::clear() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto &buffer : buffers) {
+        buffer->clear();
+    }
+}
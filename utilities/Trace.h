@@ -0,0 +1,109 @@
+#ifndef PEA_P1_TRACE_H
+#define PEA_P1_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped tracing. Build with -DPEA_P1_TRACING=ON to record; otherwise TRACE_SCOPE expands to nothing.
+// Usage: TRACE_SCOPE("name") - records a complete event from this line to the end of the enclosing block.
+// Names must be string literals (only the pointer is stored).
+#ifdef PEA_P1_TRACING
+#define PEA_P1_TRACE_CONCAT_IMPL(a, b) a##b
+#define PEA_P1_TRACE_CONCAT(a, b) PEA_P1_TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) TraceScope PEA_P1_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void) 0)
+#endif
+
+struct TraceEvent {
+    const char *name;
+    // Nanoseconds since Trace epoch
+    long long start;
+    long long duration;
+};
+
+// Events of one thread. Written only by the owning thread, read by Trace::dumpChromeTrace -
+// an event becomes visible after the release store of size, so no lock is taken while recording.
+class TraceBuffer {
+public:
+    // Events over capacity are dropped (and counted)
+    static const int CAPACITY = 1 << 16;
+
+    explicit TraceBuffer(int threadId);
+
+    void record(const char *name, long long start, long long end);
+
+    [[nodiscard]] int getThreadId() const;
+
+    // Number of events safe to read
+    [[nodiscard]] int getSize() const;
+
+    [[nodiscard]] const TraceEvent &getEvent(int idx) const;
+
+    [[nodiscard]] long long getDroppedCount() const;
+
+    void clear();
+
+private:
+    const int threadId;
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<int> size;
+    std::atomic<long long> nDropped;
+};
+
+class Trace {
+public:
+
+    static constexpr bool isEnabled() {
+#ifdef PEA_P1_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Nanoseconds since the first call in the process
+    static long long now();
+
+    static void record(const char *name, long long start, long long end);
+
+    // Writes Chrome trace-event JSON (chrome://tracing, Perfetto). Events recorded concurrently with the dump
+    // may be missing from the file.
+    static void dumpChromeTrace(const std::string &path);
+
+    // Forgets all recorded events - must not be called while traced code is running
+    static void clear();
+
+private:
+    Trace() = default;
+
+    static TraceBuffer &getThreadBuffer();
+
+    // Buffers outlive their threads so that the dump can be done after workers are joined
+    static std::mutex buffersMutex;
+    static std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char *name) : name(name), start(Trace::now()) {}
+
+    ~TraceScope() {
+        Trace::record(name, start, Trace::now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *name;
+    long long start;
+};
+
+
+#endif //PEA_P1_TRACE_H